@@ -0,0 +1,349 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  compile_thread_pool.cpp
+ * @brief Implementation of the device-owned worker pool used to compile pipelines in parallel.
+ ***********************************************************************************************************************
+ */
+
+#include "include/compile_thread_pool.h"
+#include "include/vk_device.h"
+#include "include/vk_instance.h"
+#include "include/vk_utils.h"
+
+#include "palListImpl.h"
+#include "palSysUtil.h"
+
+namespace vk
+{
+
+// =====================================================================================================================
+CompileThreadPool::CompileThreadPool(
+    Device*       pDevice,
+    uint32_t      threadCount,
+    Util::Thread* pThreads)
+    :
+    m_pDevice(pDevice),
+    m_threadCount(threadCount),
+    m_pThreads(pThreads),
+    m_batchList(pDevice->VkInstance()->Allocator()),
+    m_threadsStarted(false),
+    m_stop(false)
+{
+}
+
+// =====================================================================================================================
+// Creates a pool with the given number of worker threads.
+VkResult CompileThreadPool::Create(
+    Device*             pDevice,
+    uint32_t            threadCount,
+    CompileThreadPool** ppPool)
+{
+    VK_ASSERT(threadCount > 0);
+
+    VkResult result  = VK_SUCCESS;
+    void*    pMemory = pDevice->VkInstance()->AllocMem(
+                           sizeof(CompileThreadPool) + (threadCount * sizeof(Util::Thread)),
+                           VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
+
+    if (pMemory != nullptr)
+    {
+        Util::Thread* pThreads = static_cast<Util::Thread*>(Util::VoidPtrInc(pMemory, sizeof(CompileThreadPool)));
+
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            VK_PLACEMENT_NEW(&pThreads[i]) Util::Thread();
+        }
+
+        CompileThreadPool* pPool = VK_PLACEMENT_NEW(pMemory) CompileThreadPool(pDevice, threadCount, pThreads);
+
+        result = pPool->Init();
+
+        if (result == VK_SUCCESS)
+        {
+            *ppPool = pPool;
+        }
+        else
+        {
+            pPool->Destroy();
+        }
+    }
+    else
+    {
+        result = VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Initializes the synchronization primitives.  The worker threads are only started by the first batch, so devices that
+// never create pipelines in batches don't pay for idle threads.
+VkResult CompileThreadPool::Init()
+{
+    VkResult result = PalToVkResult(m_lock.Init());
+
+    if (result == VK_SUCCESS)
+    {
+        Util::EventCreateFlags flags = {};
+        flags.manualReset       = false;
+        flags.initiallySignaled = false;
+
+        result = PalToVkResult(m_wakeEvent.Init(flags));
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Starts the worker threads unless that was already done.  The pool lock must be held.  A thread which fails to start
+// is simply missing from the pool: the submitting thread always drains its own batch, so no job is ever lost.
+void CompileThreadPool::StartThreads()
+{
+    if (m_threadsStarted == false)
+    {
+        m_threadsStarted = true;
+
+        for (uint32_t i = 0; i < m_threadCount; ++i)
+        {
+            if (m_pThreads[i].Begin(ThreadFunc, this) != Pal::Result::Success)
+            {
+                break;
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Stops and joins the worker threads and frees the pool.  No batch may be in flight.
+void CompileThreadPool::Destroy()
+{
+    VK_ASSERT(m_batchList.NumElements() == 0);
+
+    // Each exiting worker re-signals the auto-reset event to release the next one.
+    m_stop = true;
+    m_wakeEvent.Set();
+
+    for (uint32_t i = 0; i < m_threadCount; ++i)
+    {
+        if (m_pThreads[i].IsCreated())
+        {
+            m_pThreads[i].Join();
+        }
+
+        Util::Destructor(&m_pThreads[i]);
+    }
+
+    Instance* pInstance = m_pDevice->VkInstance();
+
+    Util::Destructor(this);
+
+    pInstance->FreeMem(this);
+}
+
+// =====================================================================================================================
+// Runs pfnJob for every index in [0, count) and returns once all of them have finished.  The jobs are distributed
+// between the worker threads and the calling thread.
+void CompileThreadPool::Execute(
+    uint32_t      count,
+    PfnCompileJob pfnJob,
+    void*         pJobData)
+{
+    CompileBatch batch = {};
+    batch.pfnJob    = pfnJob;
+    batch.pJobData  = pJobData;
+    batch.count     = count;
+    batch.nextIndex = 0;
+    batch.doneCount = 0;
+
+    Util::EventCreateFlags flags = {};
+    flags.manualReset       = true;
+    flags.initiallySignaled = false;
+
+    bool queued = false;
+
+    if ((count > 1) && (batch.doneEvent.Init(flags) == Pal::Result::Success))
+    {
+        Util::MutexAuto lock(&m_lock);
+
+        StartThreads();
+
+        queued = (m_batchList.PushBack(&batch) == Pal::Result::Success);
+    }
+
+    uint32_t index = 0;
+
+    if (queued)
+    {
+        m_wakeEvent.Set();
+
+        while (ClaimJob(&batch, &index))
+        {
+            RunJob(&batch, index);
+        }
+
+        // The remaining jobs were claimed by workers which signal the event after the last one completes.
+        batch.doneEvent.Wait(Util::InfiniteTimeout);
+
+        // Wait for the signaling worker to leave Set(), see RunJob().
+        Util::MutexAuto lock(&m_lock);
+    }
+    else
+    {
+        for (index = 0; index < count; ++index)
+        {
+            pfnJob(pJobData, index);
+        }
+    }
+}
+
+// =====================================================================================================================
+void CompileThreadPool::ThreadFunc(
+    void* pParam)
+{
+    static_cast<CompileThreadPool*>(pParam)->WorkerLoop();
+}
+
+// =====================================================================================================================
+// Worker thread main loop: sleeps until new batches are queued and then drains them.
+void CompileThreadPool::WorkerLoop()
+{
+    while (m_stop == false)
+    {
+        m_wakeEvent.Wait(Util::InfiniteTimeout);
+
+        CompileBatch* pBatch = nullptr;
+        uint32_t      index  = 0;
+
+        while ((m_stop == false) && FetchJob(&pBatch, &index))
+        {
+            RunJob(pBatch, index);
+        }
+    }
+
+    m_wakeEvent.Set();
+}
+
+// =====================================================================================================================
+// Claims the next job of the oldest pending batch.  Returns false if there is no pending work.
+bool CompileThreadPool::FetchJob(
+    CompileBatch** ppBatch,
+    uint32_t*      pIndex)
+{
+    bool found   = false;
+    bool hasMore = false;
+
+    {
+        Util::MutexAuto lock(&m_lock);
+
+        auto it = m_batchList.Begin();
+
+        if (it.Get() != nullptr)
+        {
+            CompileBatch* pBatch = *it.Get();
+
+            *ppBatch = pBatch;
+            *pIndex  = pBatch->nextIndex++;
+            found    = true;
+
+            if (pBatch->nextIndex == pBatch->count)
+            {
+                m_batchList.Erase(&it);
+            }
+
+            hasMore = (m_batchList.NumElements() > 0);
+        }
+    }
+
+    if (hasMore)
+    {
+        // Wake up another worker so that idle threads join in as long as there is unclaimed work.
+        m_wakeEvent.Set();
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+// Claims the next job of the given batch on behalf of the thread that submitted it.  Returns false once all jobs of
+// the batch have been claimed.
+bool CompileThreadPool::ClaimJob(
+    CompileBatch* pBatch,
+    uint32_t*     pIndex)
+{
+    Util::MutexAuto lock(&m_lock);
+
+    const bool found = (pBatch->nextIndex < pBatch->count);
+
+    if (found)
+    {
+        *pIndex = pBatch->nextIndex++;
+
+        if (pBatch->nextIndex == pBatch->count)
+        {
+            RemoveBatch(pBatch);
+        }
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+// Removes a fully claimed batch from the pending list.  The pool lock must be held.
+void CompileThreadPool::RemoveBatch(
+    CompileBatch* pBatch)
+{
+    for (auto it = m_batchList.Begin(); it.Get() != nullptr; it.Next())
+    {
+        if (*it.Get() == pBatch)
+        {
+            m_batchList.Erase(&it);
+            break;
+        }
+    }
+}
+
+// =====================================================================================================================
+// Executes one job and signals the batch if it was the last one.  The event lives on the stack of the submitting thread,
+// which may wake up while Set() is still running.  The event is therefore set under the pool lock, and Execute() takes
+// the lock once after its wait so that it can't destroy the event before Set() has returned.
+void CompileThreadPool::RunJob(
+    CompileBatch* pBatch,
+    uint32_t      index)
+{
+    const uint32_t count = pBatch->count;
+
+    pBatch->pfnJob(pBatch->pJobData, index);
+
+    if (Util::AtomicIncrement(&pBatch->doneCount) == count)
+    {
+        Util::MutexAuto lock(&m_lock);
+
+        pBatch->doneEvent.Set();
+    }
+}
+
+} // namespace vk
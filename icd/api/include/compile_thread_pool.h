@@ -0,0 +1,117 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  compile_thread_pool.h
+ * @brief Declaration of the device-owned worker pool used to compile pipelines in parallel.
+ ***********************************************************************************************************************
+ */
+
+#ifndef __COMPILE_THREAD_POOL_H__
+#define __COMPILE_THREAD_POOL_H__
+
+#pragma once
+
+#include "include/khronos/vulkan.h"
+#include "include/vk_alloccb.h"
+
+#include "palEvent.h"
+#include "palList.h"
+#include "palMutex.h"
+#include "palThread.h"
+
+namespace vk
+{
+
+class Device;
+
+// Callback that executes job "index" of a batch submitted to CompileThreadPool::Execute().
+typedef void (*PfnCompileJob)(void* pJobData, uint32_t index);
+
+// =====================================================================================================================
+// A group of independent jobs submitted by one call to CompileThreadPool::Execute().  The batch lives on the stack of
+// the submitting thread and stays in the pool's pending list only while it still has unclaimed jobs.
+struct CompileBatch
+{
+    PfnCompileJob       pfnJob;         // Job callback
+    void*               pJobData;       // Client data passed to the job callback
+    uint32_t            count;          // Total number of jobs in the batch
+    uint32_t            nextIndex;      // Index of the next unclaimed job, protected by the pool lock
+    volatile uint32_t   doneCount;      // Number of finished jobs
+    Util::Event         doneEvent;      // Signaled when the last job of the batch finishes
+};
+
+// =====================================================================================================================
+// Fixed-size pool of worker threads that fans the create infos of a multi-pipeline vkCreate*Pipelines call out across
+// the CPU cores.  The calling thread participates in its own batch, so a batch always completes even if all workers
+// are busy with batches submitted by other application threads.
+class CompileThreadPool
+{
+public:
+    static VkResult Create(
+        Device*             pDevice,
+        uint32_t            threadCount,
+        CompileThreadPool** ppPool);
+
+    void Destroy();
+
+    void Execute(
+        uint32_t            count,
+        PfnCompileJob       pfnJob,
+        void*               pJobData);
+
+    VK_INLINE uint32_t GetThreadCount() const
+        { return m_threadCount; }
+
+private:
+    typedef Util::List<CompileBatch*, PalAllocator> BatchList;
+
+    CompileThreadPool(Device* pDevice, uint32_t threadCount, Util::Thread* pThreads);
+
+    VkResult Init();
+    void StartThreads();
+
+    static void ThreadFunc(void* pParam);
+    void WorkerLoop();
+
+    bool FetchJob(CompileBatch** ppBatch, uint32_t* pIndex);
+    bool ClaimJob(CompileBatch* pBatch, uint32_t* pIndex);
+    void RemoveBatch(CompileBatch* pBatch);
+    void RunJob(CompileBatch* pBatch, uint32_t index);
+
+    Device* const           m_pDevice;           // Device that owns the pool
+    const uint32_t          m_threadCount;       // Number of worker threads
+    Util::Thread*           m_pThreads;          // Worker threads, allocated together with the pool
+
+    BatchList               m_batchList;         // Batches that still have unclaimed jobs
+    bool                    m_threadsStarted;    // Whether the worker threads have been started by a first batch
+    Util::Mutex             m_lock;              // Protects m_batchList, m_threadsStarted and nextIndex
+    Util::Event             m_wakeEvent;         // Signaled when new work is available
+    volatile bool           m_stop;              // Tells the worker threads to exit
+};
+
+} // namespace vk
+
+#endif /* __COMPILE_THREAD_POOL_H__ */
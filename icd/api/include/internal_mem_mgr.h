@@ -124,6 +124,9 @@ struct InternalMemoryPool
 
     Util::BuddyAllocator<PalAllocator>* pBuddyAllocator; // Buddy allocator used to sub-allocate
                                                          // from the pool
+
+    Util::Mutex*                        pPoolLock;       // Lock of the pool list owning this pool which serializes
+                                                         // access to pBuddyAllocator (null for base allocations)
 };
 
 // =====================================================================================================================
@@ -246,7 +249,24 @@ public:
     VkResult CalcSubAllocationPool(const MemoryPoolProperties& poolProps, void** ppPoolInfo);
 
 private:
-    typedef Util::List<InternalMemoryPool, PalAllocator>                        MemoryPoolList;
+    typedef Util::List<InternalMemoryPool, PalAllocator> MemoryPoolEntries;
+
+    // Set of memory pools sharing the same memory pool properties.  Each list is guarded by its own lock so that
+    // sub-allocations from different pool types do not contend with each other.
+    struct MemoryPoolList
+    {
+        MemoryPoolList(PalAllocator* pAllocator)
+            :
+            pools(pAllocator),
+            pLastPool(nullptr)
+        {
+        }
+
+        MemoryPoolEntries   pools;      // Memory pools of this list
+        Util::Mutex         lock;       // Serializes access to the pools and their buddy allocators
+        InternalMemoryPool* pLastPool;  // Pool the last successful sub-allocation came from (tried first)
+    };
+
     typedef Util::HashMap<MemoryPoolProperties, MemoryPoolList*, PalAllocator>  MemoryPoolListMap;
 
     VkResult CalcSubAllocationPoolInternal(
@@ -281,7 +301,7 @@ private:
     Pal::GpuMemoryHeapProperties m_heapProps[Pal::GpuHeapCount]; // Information about the memory heaps
 
     PalAllocator*       m_pSysMemAllocator; // Allocator object for system-memory allocations
-    Util::Mutex         m_allocatorLock;    // Serialize access to the memory manager to ensure thread-safety
+    Util::Mutex         m_allocatorLock;    // Serialize access to the pool list map to ensure thread-safety
     MemoryPoolListMap   m_poolListMap;      // Maintain a hash map of memory pool lists for each property combination
 
     MemoryPoolProperties m_commonPoolProps[InternalPoolCount]; // Commonly used pool properties
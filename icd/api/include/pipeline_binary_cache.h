@@ -35,21 +35,55 @@
 #include "palMetroHash.h"
 #include "palVector.h"
 #include "palCacheLayer.h"
+#include "palEvent.h"
+#include "palMutex.h"
+#include "palThread.h"
 
 namespace Util
 {
 class IPlatformKey;
+class IHashContext;
 } // namespace Util
 
 namespace vk
 {
 
+class CompileThreadPool;
+
 struct BinaryCacheEntry
 {
     Util::MetroHash::Hash hashId;
     size_t                dataSize;
 };
 
+// Location of an entry within the blob written by PipelineBinaryCache::Serialize()
+struct SerializedCacheEntry
+{
+    Util::MetroHash::Hash cacheId;
+    size_t                dataSize;
+    size_t                offset;   // Offset of the BinaryCacheEntry from the start of the blob
+};
+
+// Entry of the memory-mapped blob, see PipelineBinaryCache::InitMappedBlob()
+enum class MappedEntryState : uint32_t
+{
+    Unchecked = 0,  // The binary has not been loaded yet
+    Valid,
+    Invalid         // The binary is not a pipeline ELF for this GPU and is never returned
+};
+
+struct MappedEntry
+{
+    const BinaryCacheEntry* pEntry;
+    const void*             pData;  // Binary of the entry, aligned to VK_DEFAULT_MEM_ALIGN
+    MappedEntryState        state;
+};
+
+// Version of the blob layout written by PipelineBinaryCache::Serialize().  It is folded into the platform key and the
+// pipeline cache UUID, so blobs of an older layout are rejected.  Bump it whenever the layout changes.
+//  1: Binaries are padded to VK_DEFAULT_MEM_ALIGN from the start of the blob
+constexpr uint32_t PipelineBinaryCacheFormatVersion = 1;
+
 constexpr size_t SHA_DIGEST_LENGTH = 20;
 struct PipelineBinaryCachePrivateHeader
 {
@@ -62,6 +96,18 @@ class PipelineBinaryCache
 public:
     using CacheId                    = Util::MetroHash::Hash;
 
+    // Counters describing the effectiveness of a cache.  Hits and misses cover the whole layer chain, the remaining
+    // counters describe the in-memory layer.
+    struct Statistics
+    {
+        uint32_t hits;              // Loads and queries found in any layer
+        uint32_t misses;            // Loads and queries not found in any layer
+        uint32_t stores;            // Binaries stored into the memory layer
+        uint32_t evictions;         // Entries dropped by the memory layer to stay within its budget
+        size_t   residentEntries;   // Entries currently held by the memory layer
+        size_t   residentBytes;     // Bytes currently held by the memory layer
+    };
+
     static PipelineBinaryCache* Create(
         Instance*                 pInstance,
         size_t                    initDataSize,
@@ -91,14 +137,26 @@ public:
         size_t*         pPipelineBinarySize,
         const void**    ppPipelineBinary) const;
 
+    Util::Result LoadMappedPipelineBinary(
+        const CacheId*  pCacheId,
+        size_t*         pPipelineBinarySize,
+        const void**    ppPipelineBinary);
+
+    bool IsMappedPipelineBinary(const void* pPipelineBinary) const;
+
     Util::Result StorePipelineBinary(
         const CacheId*  pCacheId,
         size_t          pipelineBinarySize,
         const void*     pPipelineBinary);
 
+    void FlushPendingStores();
+
+    void GetStatistics(Statistics* pStats) const;
+
     VkResult Serialize(
-        void*   pBlob,
-        size_t* pSize);
+        void*              pBlob,
+        size_t*            pSize,
+        CompileThreadPool* pThreadPool);
 
     VkResult Merge(
         uint32_t                    srcCacheCount,
@@ -186,6 +244,87 @@ private:
     Util::IArchiveFile* OpenWritableArchive(const char* path, const char* fileName, size_t bufferSize);
     Util::ICacheLayer*  CreateFileLayer(Util::IArchiveFile* pFile);
 
+    VkResult InitMappedBlob(
+        const PhysicalDevice* pPhysicalDevice,
+        const char*           pFilePath,
+        const char*           pFileName);
+
+    void UnmapBlob();
+
+    MappedEntry* FindMappedEntry(const CacheId* pCacheId, MappedEntry* pEntry);
+    bool IsValidMappedBinary(const void* pBinary, size_t binarySize) const;
+
+    Util::Result LoadFromLayers(
+        const CacheId*  pCacheId,
+        bool            decompress,
+        size_t*         pPipelineBinarySize,
+        const void**    ppPipelineBinary) const;
+
+    void* DecompressEntry(
+        const void*     pEntry,
+        size_t          entrySize,
+        size_t*         pPipelineBinarySize) const;
+
+    Util::Result StoreToLayers(
+        const CacheId*  pCacheId,
+        size_t          pipelineBinarySize,
+        const void*     pPipelineBinary);
+
+    Util::Result StoreToBoundedLayers(
+        const CacheId*  pCacheId,
+        size_t          pipelineBinarySize,
+        const void*     pPipelineBinary);
+
+    VkResult InitAsyncWriter(
+        const RuntimeSettings& settings);
+
+    void DestroyAsyncWriter();
+
+    VkResult UpdateSerializedEntries();
+
+    VkResult RebuildSerializedEntries();
+
+    VkResult AppendSerializedEntries();
+
+    VkResult AddSerializedEntry(
+        const CacheId& cacheId,
+        size_t         dataSize);
+
+    VkResult ReserveSerializedData(
+        size_t size);
+
+    VkResult WriteSerializedEntries(
+        CompileThreadPool* pThreadPool);
+
+    VkResult RelayoutSerializedEntries(
+        uint32_t firstEntry);
+
+    VkResult FinishSerializedHash();
+
+    void ResetSerializedEntries();
+
+    static void LoadSerializedEntriesJob(
+        void*    pJobData,
+        uint32_t index);
+
+    bool MergeSerializedEntries(
+        const PipelineBinaryCache* pSrcCache,
+        VkResult*                  pResult);
+
+    bool QueuePendingStore(
+        const CacheId*  pCacheId,
+        size_t          pipelineBinarySize,
+        const void*     pPipelineBinary);
+
+    bool FindPendingStore(
+        const CacheId*  pCacheId,
+        bool            decompress,
+        size_t*         pPipelineBinarySize,
+        const void**    ppPipelineBinary) const;
+
+    static void AsyncWriterThreadFunc(void* pParam);
+    void AsyncWriterLoop();
+
     // Override the driver's default location
     static constexpr char   EnvVarPath[] = "AMD_VK_PIPELINE_CACHE_PATH";
 
@@ -195,6 +334,9 @@ private:
     // Filename of an additional, read-only archive
     static constexpr char   EnvVarReadOnlyFileName[] = "AMD_VK_PIPELINE_CACHE_READ_ONLY_FILENAME";
 
+    // Filename of an additional, read-only vkGetPipelineCacheData blob which is memory-mapped instead of loaded
+    static constexpr char   EnvVarMappedFileName[] = "AMD_VK_PIPELINE_CACHE_MAPPED_FILENAME";
+
     static const uint32_t   ArchiveType;                // TypeId created by hashed string VK_SHADER_PIPELINE_CACHE
     static const uint32_t   ElfType;                    // TypeId created by hashed string VK_PIPELINE_ELF
 
@@ -226,6 +368,61 @@ private:
     FileVector          m_openFiles;
     LayerVector         m_archiveLayers;
 
+
+    // Memory-mapped read-only blob. Binaries found there are returned as pointers into the mapping, which lets
+    // processes share the pages through the OS page cache and avoids a heap copy per load.  Only the header is checked
+    // when the file is mapped; entries are indexed as lookups reach them and validated the first time they are loaded.
+    using MappedEntryMap = Util::HashMap<uint64_t, MappedEntry, PalAllocator>;
+    const void*         m_pMappedBlob;
+    size_t              m_mappedBlobSize;
+    size_t              m_mappedScanOffset; // Offset of the first entry which has not been indexed yet
+    MappedEntryMap      m_mappedEntries;    // Maps the compacted cache ID to the entry inside the mapping
+    Util::Mutex         m_mappedLock;       // Protects the index and the entry states
+
+    // Stores into the archive-backed chain are queued for a background writer thread, so that file I/O stays off the
+    // threads creating pipelines. Queued binaries are still visible to loads until they have been written.
+    struct PendingStore
+    {
+        CacheId  cacheId;
+        size_t   dataSize;
+        void*    pData;                    // Copy of the binary owned by the queue
+    };
+
+    PendingStore*       m_pPendingStores;   // Ring buffer of queued stores, null if the writer is disabled
+    uint32_t            m_pendingCapacity;
+    uint32_t            m_pendingHead;      // Oldest queued store, only advanced by the writer thread
+    uint32_t            m_pendingCount;
+    mutable Util::Mutex m_pendingLock;      // Protects the ring buffer state
+    Util::Event         m_pendingEvent;     // Wakes up the writer thread
+    Util::Event         m_drainedEvent;     // Set by the writer thread once the queue is empty
+    Util::Thread        m_writerThread;
+    volatile bool       m_stopWriter;
+
+    mutable volatile uint32_t m_hitCount;   // See Statistics
+    mutable volatile uint32_t m_missCount;
+    volatile uint32_t         m_storeCount;
+    uint32_t                  m_evictionCount;      // Protected by m_boundedStoreLock
+    Util::Mutex               m_boundedStoreLock;   // Serializes stores into a bounded memory layer
+    bool                      m_memoryLayerBounded; // The memory layer evicts entries to stay within its budget
+
+    // Blob written by Serialize(), its layout and a running hash over its entries, kept across vkGetPipelineCacheData
+    // calls on application caches so that each call only loads and hashes the entries stored since the previous one.
+    using CacheIdVector          = Util::Vector<CacheId, 64, PalAllocator>;
+    using SerializedEntryVector  = Util::Vector<SerializedCacheEntry, 64, PalAllocator>;
+    mutable Util::Mutex   m_dirtyLock;          // Protects m_dirtyEntries, taken after m_serializeLock
+    CacheIdVector         m_dirtyEntries;       // Entries stored since the serialized entry layout was last updated
+    bool                  m_trackDirtyEntries;  // Set while the layout is valid; written under both locks
+    mutable Util::Mutex   m_serializeLock;      // Protects the members below
+    SerializedEntryVector m_serializedEntries;
+    size_t                m_serializedSize;     // Size of the blob including the private header
+    uint32_t              m_hashedCount;        // Number of leading entries of the layout loaded into
+                                                // m_pSerializedData and added to the running hash
+    Util::IHashContext*   m_pSerializedHash;    // Running hash of the blob, null if the layout is out of date
+    void*                 m_pSerializedHashMem;
+    void*                 m_pSerializedData;    // Serialized blob, valid up to the entry m_hashedCount
+    size_t                m_serializedDataCapacity;
+
+    bool                m_compressEntries;  // Compress binaries before storing them into the layer chain
     bool                m_isInternalCache;
 };
 
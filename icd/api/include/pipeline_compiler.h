@@ -39,6 +39,10 @@
 
 #include "include/vk_shader_code.h"
 
+#include "palEvent.h"
+#include "palHashMap.h"
+#include "palMutex.h"
+
 namespace vk
 {
 
@@ -114,6 +118,26 @@ public:
         uint32_t                            rasterizationStream,
         Util::MetroHash::Hash*              pCacheId);
 
+    bool LoadCachedGraphicsPipelineBinary(
+        Device*                                         pDevice,
+        uint32_t                                        deviceIdx,
+        PipelineCache*                                  pPipelineCache,
+        const VkGraphicsPipelineCreateInfo*             pIn,
+        GraphicsPipelineCreateInfo*                     pCreateInfo,
+        VbBindingInfo*                                  pVbInfo,
+        size_t*                                         pPipelineBinarySize,
+        const void**                                    ppPipelineBinary,
+        Util::MetroHash::Hash*                          pCacheId,
+        const VkPipelineCreationFeedbackCreateInfoEXT** ppPipelineCreationFeadbackCreateInfo);
+
+    void RegisterGraphicsPipelineCacheId(
+        const Device*                     pDevice,
+        uint32_t                          deviceIdx,
+        PipelineCache*                    pPipelineCache,
+        const GraphicsPipelineCreateInfo& createInfo,
+        const VbBindingInfo&              vbInfo,
+        const Util::MetroHash::Hash&      cacheId);
+
     VkResult CreateComputePipelineBinary(
         Device*                             pDevice,
         uint32_t                            deviceIndex,
@@ -186,6 +210,8 @@ public:
 #endif
 
     void GetElfCacheMetricString(char* pOutStr, size_t outStrSize);
+
+    void FlushBinaryCache();
 private:
 
     void ApplyProfileOptions(
@@ -249,6 +275,47 @@ private:
         bool*                        pIsInternalCacheHit,
         bool*                        pElfWasCached,
         PipelineCreationFeedback*    pPipelineFeedback);
+
+    // Pipeline binary that is being compiled by one thread while other threads with the same cache ID wait for it.
+    struct InFlightCompile
+    {
+        Util::MetroHash::Hash cacheId;      // Full cache ID of the binary
+        Util::Event           doneEvent;    // Signaled once the owning thread finished compiling
+        uint32_t              refCount;     // Owner plus waiting threads, protected by m_inFlightLock
+        bool                  succeeded;    // Whether pBinary holds a valid copy of the compiled binary
+        size_t                binarySize;   // Size of pBinary in bytes
+        void*                 pBinary;      // Copy of the compiled binary, only made if there are waiters
+    };
+
+    InFlightCompile* JoinInFlightCompile(
+        const Util::MetroHash::Hash* pCacheId,
+        bool*                        pIsOwner);
+
+    bool WaitInFlightCompile(
+        InFlightCompile*             pInFlight,
+        size_t*                      pPipelineBinarySize,
+        const void**                 ppPipelineBinary);
+
+    void CompleteInFlightCompile(
+        InFlightCompile*             pInFlight,
+        VkResult                     result,
+        size_t                       pipelineBinarySize,
+        const void*                  pPipelineBinary);
+
+    void ReleaseInFlightCompile(InFlightCompile* pInFlight);
+
+    bool UseCacheIdFastPath(const PipelineCache* pPipelineCache) const;
+
+    struct GraphicsCacheIdEntry;
+
+    static uint64_t GetGraphicsCacheIdKey(
+        const Util::MetroHash::Hash& basePipelineHash,
+        uint32_t                     deviceIdx,
+        uint64_t                     optionsHash);
+
+    static uint64_t GetPipelineOptionsHash(
+        const Device*                pDevice,
+        VkPipelineCreateFlags        flags);
     // -----------------------------------------------------------------------------------------------------------------
 
     PhysicalDevice*    m_pPhysicalDevice;      // Vulkan physical device object
@@ -264,6 +331,25 @@ private:
     // PipelineBinaryCache is only enabled for Windows at this time.
     PipelineBinaryCache* m_pBinaryCache;       // Pipeline binary cache object
 
+    // Compiles in progress keyed by the 64-bit compacted cache ID, so that concurrent requests for the same pipeline
+    // share a single compile.
+    typedef Util::HashMap<uint64_t, InFlightCompile*, PalAllocator> InFlightCompileMap;
+
+    InFlightCompileMap   m_inFlightCompiles;
+    Util::Mutex          m_inFlightLock;       // Protects m_inFlightCompiles and InFlightCompile::refCount
+
+    // Cache IDs of previously created graphics pipelines keyed by the compacted API hash (see
+    // GraphicsPipeline::BuildApiHash()), the device index and the hash of the pipeline options taken from the
+    // VkDevice, so that repeated creates can probe the pipeline caches without converting the create info and hashing
+    // the LLPC build info again.  Once the map holds pipelineCacheIdMaxEntries entries, the oldest one is evicted.
+    typedef Util::HashMap<uint64_t, GraphicsCacheIdEntry*, PalAllocator> GraphicsCacheIdMap;
+
+    GraphicsCacheIdMap   m_graphicsCacheIds;
+    uint64_t*            m_pGraphicsCacheIdKeys;       // Ring of the keys in insertion order
+    uint32_t             m_graphicsCacheIdKeyCount;
+    uint32_t             m_graphicsCacheIdKeyHead;     // Oldest key once the ring is full
+    Util::RWLock         m_graphicsCacheIdLock;        // Protects the map and the ring
+
     // Metrics
     uint32_t             m_cacheAttempts;      // Number of attempted cache loads
     uint32_t             m_cacheHits;          // Number of cache hits
@@ -152,7 +152,7 @@ private:
     struct StaticParamState
     {
         uint32_t paramToken;    // Token value the state maps to
-        uint32_t refCount;      // Reference count of active pipelines holding to this state
+        uint32_t refCount;      // Reference count of active pipelines holding to this state (updated atomically)
     };
 
     // State mapping for a Pal::*CreateInfo -> Pal::I* bindable object (for redundancy checking CmdBind* functions)
@@ -164,7 +164,7 @@ private:
 
         CreateInfo info;                     // Original create info (copy of the key)
         PalObject* pObjects[MaxPalDevices];  // Per-device object pointers (mapping value)
-        uint32_t   refCount;                 // Reference count of pipelines holding on to this state
+        uint32_t   refCount;                 // Reference count of pipelines holding on to this state (atomic)
     };
 
     // Specializations for the three kinds of PAL objects we currently cache
@@ -178,6 +178,7 @@ private:
         const typename StateObject::CreateInfo&  createInfo,
         const VkAllocationCallbacks*             pAllocator,
         VkSystemAllocationScope                  parentScope,
+        Util::RWLock*                            pLock,
         InfoMap*                                 pStateMap,
         RefMap*                                  pRefMap,
         typename StateObject::PalObject*         pStates[MaxPalDevices]);
@@ -187,6 +188,7 @@ private:
         uint32_t                           settingsMask,
         typename StateObject::PalObject**  ppStates,
         const VkAllocationCallbacks*       pAllocator,
+        Util::RWLock*                      pLock,
         InfoMap*                           pInfoMap,
         RefMap*                            pRefMap);
 
@@ -200,6 +202,7 @@ private:
     uint32_t CreateStaticParamsState(
         uint32_t         enabledType,
         const ParamInfo& params,
+        Util::RWLock*    pLock,
         ParamHashMap*    pMap,
         uint32_t*        pNextId);
 
@@ -208,6 +211,7 @@ private:
         uint32_t         enabledType,
         const ParamInfo& params,
         uint32_t         token,
+        Util::RWLock*    pLock,
         ParamHashMap*    pMap);
 
     VK_INLINE bool IsEnabled(uint32_t staticStateFlag) const;
@@ -253,43 +257,53 @@ private:
         const VkAllocationCallbacks* pAllocator);
 
     Device* const                                 m_pDevice;
-    Util::Mutex                                   m_mutex;
 
+    // Each kind of state has its own lock so that pipelines created in parallel only contend when they register the
+    // same kind of state.  Lookups of already registered state only take the lock for reading and update the reference
+    // count atomically; the lock is taken for writing to add new state or to erase unreferenced state.
+    //
     // These hash tables map static graphics pipeline state to a unique token i.e. a perfect hash.
     Util::HashMap<Pal::InputAssemblyStateParams,
                   StaticParamState,
                   PalAllocator>                   m_inputAssemblyState;
     uint32_t                                      m_inputAssemblyStateNextId;
+    Util::RWLock                                  m_inputAssemblyStateLock;
 
     Util::HashMap<Pal::TriangleRasterStateParams,
                   StaticParamState,
                   PalAllocator>                   m_triangleRasterState;
     uint32_t                                      m_triangleRasterStateNextId;
+    Util::RWLock                                  m_triangleRasterStateLock;
 
     Util::HashMap<Pal::PointLineRasterStateParams,
                   StaticParamState,
                   PalAllocator>                   m_pointLineRasterState;
     uint32_t                                      m_pointLineRasterStateNextId;
+    Util::RWLock                                  m_pointLineRasterStateLock;
 
     Util::HashMap<Pal::LineStippleStateParams,
                   StaticParamState,
                   PalAllocator>                   m_lineStippleState;
     uint32_t                                      m_lineStippleStateNextId;
+    Util::RWLock                                  m_lineStippleStateLock;
 
     Util::HashMap<Pal::DepthBiasParams,
                   StaticParamState,
                   PalAllocator>                   m_depthBias;
     uint32_t                                      m_depthBiasNextId;
+    Util::RWLock                                  m_depthBiasLock;
 
     Util::HashMap<Pal::BlendConstParams,
                   StaticParamState,
                   PalAllocator>                   m_blendConst;
     uint32_t                                      m_blendConstNextId;
+    Util::RWLock                                  m_blendConstLock;
 
     Util::HashMap<Pal::DepthBoundsParams,
                   StaticParamState,
                   PalAllocator>                   m_depthBounds;
     uint32_t                                      m_depthBoundsNextId;
+    Util::RWLock                                  m_depthBoundsLock;
 
     static const size_t ViewportHashGroupSize = (sizeof(Pal::ViewportParams) + sizeof(StaticParamState)) * 8;
 
@@ -301,6 +315,7 @@ private:
                   Util::HashAllocator<PalAllocator>,
                   ViewportHashGroupSize>          m_viewport;
     uint32_t                                      m_viewportNextId;
+    Util::RWLock                                  m_viewportLock;
 
     static const size_t ScissorRectHashGroupSize = (sizeof(Pal::ScissorRectParams) + sizeof(StaticParamState)) * 8;
 
@@ -312,6 +327,7 @@ private:
                   Util::HashAllocator<PalAllocator>,
                   ScissorRectHashGroupSize>       m_scissorRect;
     uint32_t                                      m_scissorRectNextId;
+    Util::RWLock                                  m_scissorRectLock;
 
     // These hash tables do the same for certain PAL state objects that are owned by graphics pipelines.  Because
     // they are objects, the pointer address acts as an implicit unique ID.
@@ -326,6 +342,7 @@ private:
     Util::HashMap<Pal::IMsaaState*,
                   StaticMsaaState*,
                   PalAllocator>                      m_msaaRefs;
+    Util::RWLock                                     m_msaaStatesLock;
 
     static const size_t SamplePatternHashGroupSize = (sizeof(SamplePattern) + sizeof(StaticParamState)) * 8;
 
@@ -337,6 +354,7 @@ private:
         Util::HashAllocator<PalAllocator>,
         SamplePatternHashGroupSize>               m_samplePattern;
     uint32_t                                      m_samplePatternNextId;
+    Util::RWLock                                  m_samplePatternLock;
 
     Util::HashMap<Pal::ColorBlendStateCreateInfo,
         StaticColorBlendState*,
@@ -349,6 +367,7 @@ private:
     Util::HashMap<Pal::IColorBlendState*,
         StaticColorBlendState*,
         PalAllocator>                                 m_colorBlendRefs;
+    Util::RWLock                                      m_colorBlendStatesLock;
 
     Util::HashMap<Pal::DepthStencilStateCreateInfo,
         StaticDepthStencilState*,
@@ -361,6 +380,7 @@ private:
     Util::HashMap<Pal::IDepthStencilState*,
         StaticDepthStencilState*,
         PalAllocator>                                 m_depthStencilRefs;
+    Util::RWLock                                      m_depthStencilStatesLock;
 
 };
 
@@ -91,7 +91,7 @@ public:
         m_state.GetArray()[field] = value;
     }
 
-    void PalCmdSetStencilState(CmdBuffer* pCmdBuffer);
+    bool PalCmdSetStencilState(CmdBuffer* pCmdBuffer);
 
 private:
     StencilRefMaskParams   m_state;
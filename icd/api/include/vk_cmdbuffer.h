@@ -112,6 +112,13 @@ struct PipelineBindState
     uint32_t pushedConstCount;
     // Currently pushed constant values (relative to an base = 0)
     uint32_t pushConstData[MaxPushConstRegCount];
+    // Range [begin, end) of set binding registers (relative to base = 0) whose shadowed values have not yet been
+    // written to the PAL command buffer.  Flushed at the next draw or dispatch; empty when end is 0.
+    uint32_t dirtySetRegBegin;
+    uint32_t dirtySetRegEnd;
+    // Range [begin, end) of push constant registers (relative to base = 0) not yet written.  Empty when end is 0.
+    uint32_t dirtyPushConstBegin;
+    uint32_t dirtyPushConstEnd;
 };
 
 enum PipelineBind
@@ -121,6 +128,50 @@ enum PipelineBind
     PipelineBindCount
 };
 
+// Counters of PAL work recorded into a command buffer.  Most entries correspond to one of the CmdBuffer::Pal* wrappers
+// and count calls to it (not PAL calls per device); the rest count work that was skipped as redundant.  Only tracked in
+// builds with ICD_CMDBUF_STATS.
+enum CmdBufferStat : uint32_t
+{
+    CmdBufferStatBindPipeline = 0,
+    CmdBufferStatBindIndexData,
+    CmdBufferStatBindMsaaState,
+    CmdBufferStatBindColorBlendState,
+    CmdBufferStatBindDepthStencilState,
+    CmdBufferStatSetUserData,
+    CmdBufferStatSetMsaaQuadSamplePattern,
+    CmdBufferStatDraw,
+    CmdBufferStatDrawIndexed,
+    CmdBufferStatDrawIndirect,
+    CmdBufferStatDispatch,
+    CmdBufferStatDispatchIndirect,
+    CmdBufferStatBarrier,
+    CmdBufferStatCopyBuffer,
+    CmdBufferStatUpdateBuffer,
+    CmdBufferStatFillBuffer,
+    CmdBufferStatCopyImage,
+    CmdBufferStatScaledCopyImage,
+    CmdBufferStatCopyMemoryToImage,
+    CmdBufferStatCopyImageToMemory,
+    CmdBufferStatClearColorImage,
+    CmdBufferStatClearDepthStencil,
+    CmdBufferStatResolveImage,
+    CmdBufferStatSetResetEvent,
+    CmdBufferStatRedundantPipelineBind,
+    CmdBufferStatRedundantStateBind,
+    CmdBufferStatElidedDynamicState,
+    CmdBufferStatCount
+};
+
+#if ICD_CMDBUF_STATS
+struct CmdBufferStats
+{
+    uint64_t counters[CmdBufferStatCount];
+};
+
+extern const char* const CmdBufferStatNames[CmdBufferStatCount];
+#endif
+
 // Members of CmdBufferRenderState that are different for each GPU
 struct PerGpuRenderState
 {
@@ -144,8 +195,8 @@ struct AllGpuRenderState
     // that program static render state, and are reset to DynamicRenderStateToken by vkCmdSet* functions.
     //
     // Command buffer recording can compare these tokens with new incoming tokens to efficiently redundancy check
-    // render state and avoid context rolling.  This redundancy checking is only done for static pipeline state and not
-    // for vkCmdSet* function values.
+    // render state and avoid context rolling.  vkCmdSet* function values are instead redundancy checked by value
+    // against the shadows below (see dynamicStateValid).
     struct
     {
         uint32_t inputAssemblyState;
@@ -160,6 +211,27 @@ struct AllGpuRenderState
         uint32_t samplePattern;
     } staticTokens;
 
+    // These flags mark which pieces of render state were last programmed by a vkCmdSet* function whose value is still
+    // shadowed in this structure.  While set (and while the matching static token is DynamicRenderStateToken), an
+    // identical vkCmdSet* call is redundant and is not forwarded to PAL.
+    union
+    {
+        struct
+        {
+            uint32_t viewports   : 1;
+            uint32_t scissorRect : 1;
+            uint32_t depthBias   : 1;
+            uint32_t blendConst  : 1;
+            uint32_t depthBounds : 1;
+            uint32_t reserved    : 27;
+        };
+        uint32_t u32All;
+    } dynamicStateValid;
+
+    Pal::DepthBiasParams   depthBias;
+    Pal::BlendConstParams  blendConst;
+    Pal::DepthBoundsParams depthBounds;
+
     // The Imageless Frambuffer extension allows setting this at RenderPassBind
     Framebuffer*             pFramebuffer;
 
@@ -591,6 +663,12 @@ public:
         VK_ASSERT((m_state.allGpuState.pRenderPass == nullptr) ||
                   (((m_rpDeviceMask ^ deviceMask) & deviceMask) == 0));
 
+        // Previously skipped dynamic state may not have been programmed on newly enabled devices.
+        if (m_curDeviceMask != deviceMask)
+        {
+            m_state.allGpuState.dynamicStateValid.u32All = 0;
+        }
+
         m_curDeviceMask = deviceMask;
     }
 
@@ -619,6 +697,13 @@ public:
         return m_cbBeginDeviceMask;
     }
 
+    // Returns the number of vkCmdSet* calls recorded into this command buffer that were dropped because they would have
+    // reprogrammed the value already set.
+    VK_INLINE uint32_t GetElidedDynamicStateCount() const
+    {
+        return m_elidedDynamicStateCount;
+    }
+
     VkResult Destroy(void);
 
     VK_FORCEINLINE Device* VkDevice(void) const
@@ -833,6 +918,32 @@ public:
         return m_pDevice->NumPalDevices() * numEvents;
     }
 
+#if ICD_CMDBUF_STATS
+    VK_INLINE void CountStat(CmdBufferStat stat, uint32_t count = 1)
+    {
+        m_stats.counters[stat] += count;
+    }
+
+    // Used by helpers called once per device of the current device mask, so that a stat counts the API call only once
+    VK_INLINE void CountDeviceStat(uint32_t deviceIdx, CmdBufferStat stat)
+    {
+        uint32_t firstDeviceIdx = 0;
+
+        if (Util::BitMaskScanForward(&firstDeviceIdx, m_curDeviceMask) && (deviceIdx == firstDeviceIdx))
+        {
+            m_stats.counters[stat]++;
+        }
+    }
+
+    VK_INLINE const CmdBufferStats& GetStats() const
+    {
+        return m_stats;
+    }
+#else
+    VK_INLINE void CountStat(CmdBufferStat stat, uint32_t count = 1) {}
+    VK_INLINE void CountDeviceStat(uint32_t deviceIdx, CmdBufferStat stat) {}
+#endif
+
 #if VK_ENABLE_DEBUG_BARRIERS
     VK_INLINE void DbgBarrierPreCmd(uint32_t cmd)
     {
@@ -911,6 +1022,23 @@ private:
         Pal::PipelineBindPoint palBindPoint,
         RebindUserDataFlags    flags);
 
+    static VK_INLINE void UpdateUserDataShadow(
+        uint32_t        regOffset,
+        uint32_t        regCount,
+        const uint32_t* pValues,
+        uint32_t        writtenRegCount,
+        uint32_t*       pShadow,
+        uint32_t*       pDirtyBegin,
+        uint32_t*       pDirtyEnd);
+
+    VK_INLINE void FlushUserData(
+        PipelineBind           apiBindPoint,
+        Pal::PipelineBindPoint palBindPoint);
+
+    void FlushDirtyUserData(
+        PipelineBind           apiBindPoint,
+        Pal::PipelineBindPoint palBindPoint);
+
     void PalBindPipeline(
         VkPipelineBindPoint     pipelineBindPoint,
         VkPipeline              pipeline);
@@ -979,8 +1107,6 @@ private:
 
     VK_INLINE void WritePushConstants(
         PipelineBind           apiBindPoint,
-        Pal::PipelineBindPoint palBindPoint,
-        const PipelineLayout*  pLayout,
         uint32_t               startInDwords,
         uint32_t               lengthInDwords,
         const uint32_t* const  pInputValues);
@@ -1005,6 +1131,11 @@ private:
     bool                          m_isRecording;
     bool                          m_needResetState;
     VkResult                      m_recordingResult; // Tracks the result of recording commands to capture OOM errors
+    uint32_t                      m_elidedDynamicStateCount; // Redundant vkCmdSet* calls that were not sent to PAL
+    Pal::gpusize                  m_lastCmdDataSize; // Command data used by the last recording of a secondary
+#if ICD_CMDBUF_STATS
+    CmdBufferStats                m_stats;           // PAL work recorded since the last begin or reset
+#endif
 
     const DeviceBarrierPolicy     m_barrierPolicy;   // Barrier policy to use with this command buffer
 
@@ -1039,10 +1170,16 @@ void CmdBuffer::PalCmdBindMsaaState(
 
     if (pState != m_state.perGpuState[deviceIdx].pMsaaState)
     {
+        CountDeviceStat(deviceIdx, CmdBufferStatBindMsaaState);
+
         pPalCmdBuf->CmdBindMsaaState(pState);
 
         m_state.perGpuState[deviceIdx].pMsaaState = pState;
     }
+    else
+    {
+        CountDeviceStat(deviceIdx, CmdBufferStatRedundantStateBind);
+    }
 }
 
 // =====================================================================================================================
@@ -1055,10 +1192,16 @@ void CmdBuffer::PalCmdBindColorBlendState(
 
     if (pState != m_state.perGpuState[deviceIdx].pColorBlendState)
     {
+        CountDeviceStat(deviceIdx, CmdBufferStatBindColorBlendState);
+
         pPalCmdBuf->CmdBindColorBlendState(pState);
 
         m_state.perGpuState[deviceIdx].pColorBlendState = pState;
     }
+    else
+    {
+        CountDeviceStat(deviceIdx, CmdBufferStatRedundantStateBind);
+    }
 }
 
 // =====================================================================================================================
@@ -1071,10 +1214,16 @@ void CmdBuffer::PalCmdBindDepthStencilState(
 
     if (pState != m_state.perGpuState[deviceIdx].pDepthStencilState)
     {
+        CountDeviceStat(deviceIdx, CmdBufferStatBindDepthStencilState);
+
         pPalCmdBuf->CmdBindDepthStencilState(pState);
 
         m_state.perGpuState[deviceIdx].pDepthStencilState = pState;
     }
+    else
+    {
+        CountDeviceStat(deviceIdx, CmdBufferStatRedundantStateBind);
+    }
 }
 
 // =====================================================================================================================
@@ -1085,6 +1234,8 @@ void CmdBuffer::PalCmdBufferSetUserData(
     uint32_t               perDeviceStride,
     const uint32_t*        pEntryValues)
 {
+    CountStat(CmdBufferStatSetUserData);
+
     for (uint32_t deviceIdx = 0; deviceIdx < m_pDevice->NumPalDevices(); deviceIdx++)
     {
         PalCmdBuffer(deviceIdx)->CmdSetUserData(bindPoint,
@@ -79,6 +79,15 @@ public:
     void FreeSetGpuMem(
         void*        pSetAllocHandle);
 
+    bool SetGpuMemFits(
+        const void*                 pSetAllocHandle,
+        const DescriptorSetLayout*  pLayout,
+        uint32_t                    variableDescriptorCounts) const;
+
+    static uint32_t SetGpuMemSize(
+        const DescriptorSetLayout*  pLayout,
+        uint32_t                    variableDescriptorCounts);
+
     void Reset();
 
     VK_INLINE void* CpuAddr(uint32_t deviceIdx) const
@@ -98,13 +107,29 @@ protected:
         Pal::gpusize          gpuMemOffsetRangeEnd;     // End of GPU address range of this block
     };
 
+    // Free blocks are kept in segregated free lists: list i holds the free blocks of [2^i, 2^(i+1)) bytes, and the
+    // last list also holds all larger blocks.
+    static constexpr uint32_t DynamicAllocBinCount = 32;
+
     bool IsDynamicAllocBlockFree(const DynamicAllocBlock* pBlock) const
     {
-        // pPrevFree is never null for free blocks as they are chained after a list header so this is how we determine
-        // whether a block is free. Also, we consider null as a non-free block for simplicity.
+        // pPrevFree is never null for free blocks as the first block of each free list is chained after the list
+        // sentinel so this is how we determine whether a block is free. Also, we consider null as a non-free block for
+        // simplicity.
         return (pBlock != nullptr) && (pBlock->pPrevFree != nullptr);
     }
 
+    static uint32_t DynamicAllocBin(Pal::gpusize size)
+    {
+        return (size >= (1ull << (DynamicAllocBinCount - 1))) ? (DynamicAllocBinCount - 1) :
+               (size > 0)                                     ? Util::Log2(static_cast<uint32_t>(size)) : 0;
+    }
+
+    void LinkFreeBlock(DynamicAllocBlock* pBlock);
+    void UnlinkFreeBlock(DynamicAllocBlock* pBlock);
+    DynamicAllocBlock* FindFreeBlockInBin(uint32_t bin, Pal::gpusize size) const;
+    DynamicAllocBlock* FindFreeBlock(Pal::gpusize size) const;
+
     uint32_t DynamicAllocBlockIndex(const DynamicAllocBlock* pBlock) const
     {
         // Calculate the index of the block within the block storage using pointer arithmetics.
@@ -119,7 +144,9 @@ protected:
 
     Pal::gpusize              m_oneShotAllocForward;    // Start of free memory for one-shot allocs (allocated forwards)
 
-    DynamicAllocBlock         m_dynamicAllocBlockFreeListHeader;    // Header for the list of free blocks
+    DynamicAllocBlock         m_dynamicAllocFreeListSentinel;       // pPrevFree of the first block of each free list
+    DynamicAllocBlock*        m_pDynamicAllocFreeLists[DynamicAllocBinCount]; // First block of each free list
+    uint32_t                  m_dynamicAllocFreeListMask;           // Mask of the non-empty free lists
     DynamicAllocBlock*        m_pDynamicAllocBlocks;                // Storage of block structures
     uint32_t                  m_dynamicAllocBlockCount;             // Number of block structures
     uint32_t*                 m_pDynamicAllocBlockIndexStack;       // Stack of indices of available block structures
@@ -224,6 +251,38 @@ private:
 
     DescriptorPool(Device* pDevice);
 
+    static constexpr uint32_t RecycledSetListCount    = 4;  // Number of layouts whose freed sets can be recycled at once
+    static constexpr uint32_t RecycledSetListCapacity = 16; // Maximum number of recycled sets per layout
+
+    // Recently freed descriptor sets of a single layout.  These keep their state and GPU memory so that a following
+    // allocation of the same layout can take them over without going through the set and GPU memory heaps.
+    struct RecycledSetList
+    {
+        const DescriptorSetLayout*  pLayout;                        // Layout of the recycled sets
+        uint32_t                    count;                          // Number of recycled sets
+        VkDescriptorSet             sets[RecycledSetListCapacity];  // Stack of recycled sets
+    };
+
+    RecycledSetList* GetRecycledSetList(const DescriptorSetLayout* pLayout)
+    {
+        // Layouts are allocated with at least VK_DEFAULT_MEM_ALIGN alignment so skip the always-zero low bits.
+        const uintptr_t key = reinterpret_cast<uintptr_t>(pLayout) / VK_DEFAULT_MEM_ALIGN;
+
+        return &m_recycledSets[(key ^ (key >> 8)) % RecycledSetListCount];
+    }
+
+    template <uint32_t numPalDevices>
+    bool RecycleSet(VkDescriptorSet set);
+
+    template <uint32_t numPalDevices>
+    bool AllocRecycledSet(
+        const DescriptorSetLayout*  pLayout,
+        uint32_t                    variableDescriptorCounts,
+        VkDescriptorSet*            pSet);
+
+    template <uint32_t numPalDevices>
+    void ReleaseRecycledSets();
+
     template <uint32_t numPalDevices>
     static VKAPI_ATTR VkResult VKAPI_CALL CreateDescriptorPool(
         VkDevice                                    device,
@@ -257,6 +316,10 @@ private:
     InternalMemory       m_staticInternalMem; // Static Internal GPU memory
 
     DescriptorAddr       m_addresses[MaxPalDevices];
+
+    bool                 m_recycleFreedSets;  // Whether freed sets are kept in m_recycledSets
+    uint32_t             m_recycledSetCount;  // Total number of sets in m_recycledSets
+    RecycledSetList      m_recycledSets[RecycledSetListCount];
 };
 
 namespace entry
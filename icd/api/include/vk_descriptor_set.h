@@ -43,6 +43,13 @@
 
 #include "pal.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define VK_DESCRIPTOR_STREAMING_STORES 1
+#else
+#define VK_DESCRIPTOR_STREAMING_STORES 0
+#endif
+
 namespace vk
 {
 
@@ -229,6 +236,13 @@ void DescriptorSet<numPalDevices>::PatchedDynamicDataFromHandle(
 class DescriptorUpdate
 {
 public:
+    template <size_t descSize>
+    VK_INLINE static void StoreDescriptor(
+        uint32_t*                       pDestAddr,
+        const void*                     pSrcDesc);
+
+    VK_INLINE static void FlushDescriptorStores();
+
     template <size_t samplerDescSize>
     static void WriteSamplerDescriptors(
         const VkDescriptorImageInfo*    pDescriptors,
@@ -312,6 +326,11 @@ private:
         uint32_t                                    descriptorCopyCount,
         const VkCopyDescriptorSet*                  pDescriptorCopies);
 
+    static uint32_t MergeAdjacentWrites(
+        VkWriteDescriptorSet*        pWrite,
+        const VkWriteDescriptorSet*  pNextWrites,
+        uint32_t                     nextWriteCount);
+
     template <size_t imageDescSize,
               size_t fmaskDescSize,
               size_t samplerDescSize,
@@ -332,6 +351,43 @@ private:
         const VkCopyDescriptorSet*   pDescriptorCopies);
 };
 
+// =====================================================================================================================
+// Copies a descriptor into descriptor set memory.  That memory is write-combined and never read back by the CPU on the
+// write paths, so descriptors are emitted with non-temporal 16-byte stores that fill whole write-combining buffers
+// without polluting the cache.  FlushDescriptorStores() must be called once the update is complete.
+template <size_t descSize>
+void DescriptorUpdate::StoreDescriptor(
+    uint32_t*   pDestAddr,
+    const void* pSrcDesc)
+{
+#if VK_DESCRIPTOR_STREAMING_STORES
+    if (((descSize % sizeof(__m128i)) == 0) && Util::IsPow2Aligned(reinterpret_cast<uintptr_t>(pDestAddr), 16))
+    {
+        const __m128i* pSrc = static_cast<const __m128i*>(pSrcDesc);
+        __m128i*       pDst = reinterpret_cast<__m128i*>(pDestAddr);
+
+        for (size_t i = 0; i < (descSize / sizeof(__m128i)); ++i)
+        {
+            _mm_stream_si128(pDst + i, _mm_loadu_si128(pSrc + i));
+        }
+    }
+    else
+#endif
+    {
+        memcpy(pDestAddr, pSrcDesc, descSize);
+    }
+}
+
+// =====================================================================================================================
+// Orders the non-temporal stores of StoreDescriptor() before any later store, e.g. the ones that submit work using the
+// updated descriptor sets.
+void DescriptorUpdate::FlushDescriptorStores()
+{
+#if VK_DESCRIPTOR_STREAMING_STORES
+    _mm_sfence();
+#endif
+}
+
 // =====================================================================================================================
 
 namespace entry
@@ -91,6 +91,10 @@ private:
         size_t          dstDynOffset;
     };
 
+    static bool FuseEntries(
+        TemplateUpdateInfo*         pPrevEntry,
+        const TemplateUpdateInfo&   entry);
+
     const TemplateUpdateInfo* GetEntries() const
     {
         return static_cast<const TemplateUpdateInfo*>(Util::VoidPtrInc(this, sizeof(*this)));
@@ -90,6 +90,8 @@ class SqttMgr;
 class SwapChain;
 class ChillMgr;
 class AsyncLayer;
+class CompileThreadPool;
+struct SharedShaderModule;
 
 // =====================================================================================================================
 // Specifies properties for importing a semaphore, it's an encapsulation of VkImportSemaphoreFdInfoKHR and
@@ -153,6 +155,13 @@ public:
 
     VkResult WaitIdle(void);
 
+    void FlushQueueSubmitThreads(
+        uint32_t                                    submitQueueMask);
+
+    // Every queue with a submission thread, for FlushQueueSubmitThreads()
+    uint32_t GetSubmitThreadQueueMask() const
+        { return (m_submitThreadCount < 32) ? ((1u << m_submitThreadCount) - 1) : UINT32_MAX; }
+
     VkResult AllocMemory(
         const VkMemoryAllocateInfo*                 pAllocInfo,
         const VkAllocationCallbacks*                pAllocator,
@@ -525,9 +534,21 @@ public:
     VK_INLINE AsyncLayer* GetAsyncLayer()
         { return m_pAsyncLayer; }
 
+    VK_INLINE CompileThreadPool* GetCompileThreadPool()
+        { return m_pCompileThreadPool; }
+
     VK_INLINE Util::Mutex* GetMemoryMutex()
         { return &m_memoryMutex; }
 
+    // Shader modules with identical code and create flags share one built module, see ShaderModule::Create()
+    typedef Util::HashMap<uint64_t, SharedShaderModule*, PalAllocator> SharedShaderModuleMap;
+
+    VK_INLINE SharedShaderModuleMap* GetSharedShaderModules() const
+        { return &m_sharedShaderModules; }
+
+    VK_INLINE Util::Mutex* GetSharedShaderModuleLock() const
+        { return &m_sharedShaderModuleLock; }
+
     VK_INLINE PipelineCompiler* GetCompiler(uint32_t idx) const
         { return m_perGpu[idx].pPhysicalDevice->GetCompiler(); }
 
@@ -639,6 +660,10 @@ protected:
 
     DispatchableQueue*                  m_pQueues[Queue::MaxQueueFamilies][Queue::MaxQueuesPerFamily];
 
+    // Queues with a submission thread, indexed by the bit of Queue::GetSubmitThreadMask()
+    Queue*                              m_pSubmitThreadQueues[Queue::MaxSubmitThreads];
+    uint32_t                            m_submitThreadCount;
+
     InternalPipeline                    m_timestampQueryCopyPipeline;
 
     static const uint32_t BltMsaaStateCount = 4;
@@ -651,12 +676,18 @@ protected:
     DispatchTable                       m_dispatchTable;           // Device dispatch table
     SqttMgr*                            m_pSqttMgr;                // Manager for developer mode SQ thread tracing
     AsyncLayer*                         m_pAsyncLayer;             // State for async compiler layer, otherwise null
+    CompileThreadPool*                  m_pCompileThreadPool;      // Workers for multi-pipeline creation, otherwise
+                                                                   // null
     OptLayer*                           m_pAppOptLayer;            // State for an app-specific layer, otherwise null
     BarrierFilterLayer*                 m_pBarrierFilterLayer;     // State for enabling barrier filtering, otherwise
                                                                    // null
 
     Util::Mutex                         m_memoryMutex;             // Shared mutex used occasionally by memory objects
 
+    mutable SharedShaderModuleMap       m_sharedShaderModules;     // Shared shader modules keyed by code hash
+    mutable Util::Mutex                 m_sharedShaderModuleLock;  // Protects m_sharedShaderModules and the
+                                                                   // SharedShaderModule reference counts
+
     // The states of m_enabledFeatures are provided by application
     VkPhysicalDeviceFeatures            m_enabledFeatures;
 
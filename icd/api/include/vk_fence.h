@@ -87,6 +87,32 @@ public:
     VK_INLINE void SetActiveDevice(uint32_t deviceIdx)
         { m_activeDeviceMask |= (1 << deviceIdx); }
 
+    // Once a fence has been seen signaled it stays signaled until it is reset, so status queries can be answered
+    // without asking PAL.
+    VK_INLINE bool IsKnownSignaled() const
+        { return m_knownSignaled; }
+
+    VK_INLINE void SetKnownSignaled()
+        { m_knownSignaled = true; }
+
+    // A fence that was never submitted and was not created or imported signaled is still reset in PAL.
+    VK_INLINE bool NeedsPalReset() const
+        { return (m_activeDeviceMask != 0) || (m_flags.mayBeSignaled != 0); }
+
+    // Mask of the queue submission thread this fence was last submitted through, see Queue::GetSubmitThreadMask().
+    // A fence is only pending on one submission at a time, so waits only need to flush that queue.
+    VK_INLINE uint32_t GetSubmitQueueMask() const
+        { return m_submitQueueMask; }
+
+    VK_INLINE void SetSubmitQueueMask(uint32_t submitQueueMask)
+        { m_submitQueueMask = submitQueueMask; }
+
+    VK_INLINE void ClearSignaledState()
+    {
+        m_knownSignaled        = false;
+        m_flags.mayBeSignaled  = 0;
+    }
+
     VK_FORCEINLINE Pal::IFence* PalFence(int32_t idx) const
     {
         VK_ASSERT((idx >= 0) && (idx < static_cast<int32_t>(MaxPalDevices)));
@@ -97,22 +123,28 @@ public:
 private:
     Fence(uint32_t      numGroupedFences,
           Pal::IFence** pPalFences,
-          bool          canBeInherited)
+          bool          canBeInherited,
+          bool          signaled)
     :
     m_activeDeviceMask(0),
     m_groupedFenceCount(numGroupedFences),
-    m_pPalTemporaryFences(nullptr)
+    m_pPalTemporaryFences(nullptr),
+    m_knownSignaled(false),
+    m_submitQueueMask(0)
     {
         memcpy(m_pPalFences, pPalFences, sizeof(pPalFences[0]) * numGroupedFences);
         m_flags.value          = 0;
         m_flags.isPermanence   = 1;
         m_flags.canBeInherited = canBeInherited;
+        m_flags.mayBeSignaled  = signaled;
     }
 
-    uint32_t     m_activeDeviceMask;
-    uint32_t     m_groupedFenceCount;
-    Pal::IFence* m_pPalFences[MaxPalDevices];
-    Pal::IFence* m_pPalTemporaryFences;
+    uint32_t          m_activeDeviceMask;
+    uint32_t          m_groupedFenceCount;
+    Pal::IFence*      m_pPalFences[MaxPalDevices];
+    Pal::IFence*      m_pPalTemporaryFences;
+    volatile bool     m_knownSignaled;    // The fence was observed signaled since it was last reset
+    volatile uint32_t m_submitQueueMask;  // See GetSubmitQueueMask()
 
     union
     {
@@ -122,7 +154,8 @@ private:
             uint32_t isOpened       : 1;
             uint32_t isReference    : 1;
             uint32_t canBeInherited : 1;
-            uint32_t reserved       : 28;
+            uint32_t mayBeSignaled  : 1;  // Created or imported signaled and not reset in PAL since
+            uint32_t reserved       : 27;
         };
         uint32_t value;
     } m_flags;
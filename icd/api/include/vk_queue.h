@@ -42,7 +42,15 @@
 #include "include/virtual_stack_mgr.h"
 
 #include "palDeque.h"
+#include "palEvent.h"
 #include "palQueue.h"
+#include "palThread.h"
+
+#include <atomic>
+
+#if ICD_CMDBUF_STATS
+#include "palFile.h"
+#endif
 
 namespace Pal
 {
@@ -94,6 +102,17 @@ public:
         VkFence             fence);
 
     VkResult WaitIdle(void);
+
+    VkResult InitSubmitThread(
+        uint32_t            ringSize,
+        uint32_t            submitThreadIdx);
+
+    void FlushSubmitThread();
+
+    // Bit identifying this queue in the submit queue masks of fences and semaphores, 0 without a submission thread
+    uint32_t GetSubmitThreadMask() const
+        { return m_submitThreadMask; }
+
     VkResult PalSignalSemaphores(
         uint32_t            semaphoreCount,
         const VkSemaphore*  pSemaphores,
@@ -126,6 +145,7 @@ public:
     {
         MaxQueueFamilies    = Pal::EngineTypeCount,  // Maximum number of queue families
         MaxQueuesPerFamily  = 8,                     // Maximum number of queues per family
+        MaxSubmitThreads    = 32,                    // Maximum number of queues with a submission thread
     };
 
     VK_FORCEINLINE Pal::IQueue* PalQueue(int32_t idx) const
@@ -263,6 +283,40 @@ protected:
         uint32_t                         deviceIdx,
         const Pal::PresentSwapChainInfo* pPresentInfo);
 
+#if ICD_CMDBUF_STATS
+    void LogCmdBufferStats(
+        uint32_t            submitCount,
+        const VkSubmitInfo* pSubmits);
+#endif
+
+    VkResult SubmitBatches(
+        uint32_t            submitCount,
+        const VkSubmitInfo* pSubmits,
+        VkFence             fence);
+
+    VkResult QueueAsyncSubmit(
+        uint32_t            submitCount,
+        const VkSubmitInfo* pSubmits,
+        VkFence             fence);
+
+    void FlushSemaphoreSubmitThreads(
+        uint32_t            semaphoreCount,
+        const VkSemaphore*  pSemaphores,
+        bool                flushSelf);
+
+    void DestroySubmitThread();
+
+    static void SubmitThreadFunc(void* pParam);
+    void SubmitThreadLoop();
+
+    // A vkQueueSubmit call handed to the submission thread
+    struct PendingSubmit
+    {
+        uint32_t      submitCount;
+        VkSubmitInfo* pSubmits;    // Deep copy of the submit infos owned by the ring entry, may be null
+        VkFence       fence;
+    };
+
     Pal::IQueue*                       m_pPalQueues[MaxPalDevices];
     Device* const                      m_pDevice;
     uint32_t                           m_queueFamilyIndex;   // This queue's family index
@@ -276,6 +330,28 @@ protected:
     SqttQueueState*                    m_pSqttState; // Per-queue state for handling SQ thread-tracing annotations
     typedef Util::Deque<CmdBufState*, PalAllocator> CmdBufRing;
     CmdBufRing*                        m_pCmdBufRing[MaxPalDevices];
+
+    // When the submission thread is enabled, vkQueueSubmit copies its arguments into this lock-free single-producer,
+    // single-consumer ring and returns.  The application thread is the only producer because vkQueueSubmit calls on a
+    // queue are externally synchronized; the submission thread is the only consumer.  The head and tail count entries
+    // since the ring was created: tail - head entries are queued, and entry n lives in slot n % capacity.
+    PendingSubmit*                     m_pSubmitRing;        // Null if submissions are made on the calling thread
+    uint32_t                           m_submitRingCapacity;
+    std::atomic<uint64_t>              m_submitRingHead;     // Entries fully submitted, only written by the consumer
+    std::atomic<uint64_t>              m_submitRingTail;     // Entries queued, only written by the producer
+    std::atomic<bool>                  m_submitThreadSleeping; // Consumer found the ring empty and may be asleep
+    std::atomic<bool>                  m_submitSpaceWaiting;   // Producer found the ring full and may be asleep
+    volatile VkResult                  m_asyncSubmitResult;  // First failure seen by the submission thread
+    volatile bool                      m_stopSubmitThread;
+    uint32_t                           m_submitThreadMask;   // See GetSubmitThreadMask()
+    Util::Event                        m_submitEvent;        // Wakes up the submission thread
+    Util::Event                        m_submitSpaceEvent;   // Wakes up a producer waiting on a full ring
+    Util::Event                        m_submitIdleEvent;    // Set while the submission thread sleeps on an empty ring
+    Util::Thread                       m_submitThread;
+#if ICD_CMDBUF_STATS
+    Util::File                         m_cmdBufferStatsFile;   // Per-submit command buffer statistics (CSV)
+    uint64_t                           m_cmdBufferStatsSubmits; // Number of vkQueueSubmit calls logged so far
+#endif
 };
 
 VK_DEFINE_DISPATCHABLE(Queue);
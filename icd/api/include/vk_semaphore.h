@@ -34,6 +34,8 @@
 
 #include "palQueueSemaphore.h"
 
+#include <atomic>
+
 namespace Pal
 {
 
@@ -136,6 +138,22 @@ public:
 #endif
     }
 
+    bool IsValueReached(
+        uint64_t value) const;
+
+    // Mask of the queue submission threads that may signal this semaphore, see Queue::GetSubmitThreadMask().  Bits are
+    // never cleared: a timeline semaphore may have pending signals from several queues, and flushing an idle queue is
+    // cheap.
+    VK_FORCEINLINE uint32_t GetSubmitQueueMask() const
+        { return m_submitQueueMask; }
+
+    void AddSubmitQueueMask(
+        uint32_t submitQueueMask);
+
+    void UpdateCompletedValue(
+        const Pal::IQueueSemaphore* pPalSemaphore,
+        uint64_t                    value);
+
 private:
     Semaphore(
         Pal::IQueueSemaphore*                pPalSemaphore[],
@@ -146,7 +164,9 @@ private:
         m_palCreateInfo(palCreateInfo),
         m_useTempSemaphore(false),
         m_sharedSemaphoreHandle(sharedSemaphorehandle),
-        m_sharedSemaphoreTempHandle(0)
+        m_sharedSemaphoreTempHandle(0),
+        m_completedValue(palCreateInfo.initialCount),
+        m_submitQueueMask(0)
     {
         for (uint32_t i = 0; i < semaphoreCount; i++)
         {
@@ -175,6 +195,13 @@ private:
     Pal::OsExternalHandle           m_sharedSemaphoreHandle;
     Pal::OsExternalHandle           m_sharedSemaphoreTempHandle;
 
+    // Highest value the permanent payload of this timeline semaphore is known to have reached.  Timeline values only
+    // increase, so host waits for values at or below it are already satisfied and don't need a kernel call.  Updates
+    // only ever raise it, so no lock is needed.
+    std::atomic<uint64_t>           m_completedValue;
+
+    volatile uint32_t               m_submitQueueMask;  // See GetSubmitQueueMask()
+
 };
 
 namespace entry
@@ -48,6 +48,20 @@ typedef void* (VKAPI_CALL *BilShaderAllocFun)(Instance* pInstance, void* pUserDa
 
 extern void* VKAPI_CALL AllocateShaderOutput(void* pInstance, void* pUserData, size_t size);
 
+// =====================================================================================================================
+// SPIR-V code and its built shader module, shared by all shader modules of a device with identical code and create
+// flags.  The code follows this structure in memory.
+struct SharedShaderModule
+{
+    Pal::ShaderHash             codeHash;
+    VkShaderModuleCreateFlags   flags;
+    size_t                      codeSize;
+    const void*                 pCode;
+    ShaderModuleHandle          handle;
+    uint32_t                    refCount;       // Protected by the device's shared shader module lock
+    bool                        isRegistered;   // Whether the device's shared shader module map refers to this
+};
+
 // =====================================================================================================================
 // Implementation of a Vulkan shader module
 class ShaderModule : public NonDispatchable<VkShaderModule, ShaderModule>
@@ -78,14 +92,29 @@ public:
 
     static void* GetShaderData(PipelineCompilerType compilerType, const ShaderModuleHandle* pHandle);
 
+    static void DestroySharedModules(const Device* pDevice);
+
 protected:
-    ShaderModule(size_t codeSize, const void* pCode);
-    VkResult Init(const Device* pDevice, VkShaderModuleCreateFlags flags);
+    ShaderModule(const SharedShaderModule* pSharedModule);
+
+    static VkResult AcquireSharedModule(
+        const Device*                   pDevice,
+        const VkShaderModuleCreateInfo* pCreateInfo,
+        SharedShaderModule**            ppSharedModule);
+
+    static void ReleaseSharedModule(
+        const Device*                   pDevice,
+        SharedShaderModule*             pSharedModule);
+
+    static uint64_t GetSharedModuleKey(
+        const Pal::ShaderHash&          codeHash,
+        VkShaderModuleCreateFlags       flags);
 
     size_t                     m_codeSize;
     const void*                m_pCode;
     ShaderModuleHandle         m_handle;
     Pal::ShaderHash            m_codeHash;
+    SharedShaderModule*        m_pSharedModule;
 };
 
 namespace entry
@@ -231,9 +231,9 @@ void InternalMemMgr::Destroy()
 
         MemoryPoolList* pPoolList = mapIt.Get()->value;
 
-        while (pPoolList->NumElements() != 0)
+        while (pPoolList->pools.NumElements() != 0)
         {
-            auto it = pPoolList->Begin();
+            auto it = pPoolList->pools.Begin();
 
             InternalMemoryPool* pPool = it.Get();
 
@@ -266,7 +266,7 @@ void InternalMemMgr::Destroy()
             PAL_DELETE(pPool->pBuddyAllocator, m_pSysMemAllocator);
 
             // Remove item from list
-            pPoolList->Erase(&it);
+            pPoolList->pools.Erase(&it);
         }
 
         // Free this list
@@ -362,8 +362,14 @@ VkResult InternalMemMgr::CreateMemoryPoolList(
 
     if (pPoolList != nullptr)
     {
-        // Add this pool list to the pool list map
-        Pal::Result palResult = m_poolListMap.Insert(poolProps, pPoolList);
+        // Initialize the lock guarding this pool list
+        Pal::Result palResult = pPoolList->lock.Init();
+
+        if (palResult == Pal::Result::Success)
+        {
+            // Add this pool list to the pool list map
+            palResult = m_poolListMap.Insert(poolProps, pPoolList);
+        }
 
         if (palResult != Pal::Result::Success)
         {
@@ -390,7 +396,7 @@ VkResult InternalMemMgr::CreateMemoryPoolList(
 // An initial sub-allocation will be made from the pool and information for that sub-allocation will be returned by this
 // function.
 //
-// WARNING: This function is NOT thread-safe and assumes the caller is holding a lock on m_allocatorLock.
+// WARNING: This function is NOT thread-safe and assumes the caller is holding a lock on pOwnerList->lock.
 VkResult InternalMemMgr::CreateMemoryPoolAndSubAllocate(
     MemoryPoolList*              pOwnerList,
     const InternalMemCreateInfo& initialSubAllocInfo,
@@ -409,6 +415,8 @@ VkResult InternalMemMgr::CreateMemoryPoolAndSubAllocate(
     InternalMemoryPool newPool  = {};
     Pal::gpusize subAllocOffset = 0;
 
+    newPool.pPoolLock = &pOwnerList->lock;
+
     // Allocate the base GPU memory object for this pool
     VkResult result = VK_SUCCESS;
 
@@ -447,11 +455,11 @@ VkResult InternalMemMgr::CreateMemoryPoolAndSubAllocate(
 
     if (result == VK_SUCCESS)
     {
-        Pal::Result palResult = pOwnerList->PushFront(newPool);
+        Pal::Result palResult = pOwnerList->pools.PushFront(newPool);
         result = PalToVkResult(palResult);
         VK_ASSERT(result == VK_SUCCESS);
 
-        pInternalMemory = pOwnerList->Begin().Get();
+        pInternalMemory = pOwnerList->pools.Begin().Get();
 
         // Allocate the base GPU memory object for this pool
         result = AllocBaseGpuMem(poolInfo.pal,
@@ -472,11 +480,14 @@ VkResult InternalMemMgr::CreateMemoryPoolAndSubAllocate(
     {
         *pNewPool        = *pInternalMemory;
         *pSubAllocOffset = subAllocOffset;
+
+        // Future sub-allocations from this list are most likely to fit in the fresh pool
+        pOwnerList->pLastPool = pInternalMemory;
     }
     else
     {
-        auto it = pOwnerList->Begin();
-        bool needEraseFromOwnerList = pOwnerList->NumElements() > 0 ?
+        auto it = pOwnerList->pools.Begin();
+        bool needEraseFromOwnerList = pOwnerList->pools.NumElements() > 0 ?
             (it.Get()->groupMemory.PalMemory(DefaultDeviceIndex) ==
              pInternalMemory->groupMemory.PalMemory(DefaultDeviceIndex)) : false;
 
@@ -495,7 +506,7 @@ VkResult InternalMemMgr::CreateMemoryPoolAndSubAllocate(
         // Remove this memory pool from the list if we added it
         if (needEraseFromOwnerList)
         {
-            pOwnerList->Erase(&it);
+            pOwnerList->pools.Erase(&it);
         }
     }
 
@@ -535,8 +546,6 @@ VkResult InternalMemMgr::AllocGpuMem(
 {
     VK_ASSERT(pInternalMemory != nullptr);
 
-    Util::MutexAuto lock(&m_allocatorLock); // Ensure thread-safety using the lock
-
     VkResult result = VK_SUCCESS;
 
     // If the requested allocation is small enough (at most half the size of a single pool) then try to find an
@@ -551,13 +560,18 @@ VkResult InternalMemMgr::AllocGpuMem(
         if (createInfo.pPoolInfo != nullptr)
         {
 #if DEBUG
+            Util::MutexAuto mapLock(&m_allocatorLock);
+
             CheckProvidedSubAllocPoolInfo(createInfo);
 #endif
             pPoolList = reinterpret_cast<MemoryPoolList*>(createInfo.pPoolInfo);
         }
         else
         {
-            // No previously-computed pool has been provided so find one for this allocation
+            // No previously-computed pool has been provided so find one for this allocation.  The map lock is only
+            // needed for the lookup; the pool list itself is guarded by its own lock below.
+            Util::MutexAuto mapLock(&m_allocatorLock);
+
             MemoryPoolProperties poolProps = {};
 
             GetMemoryPoolPropertiesFromAllocInfo(createInfo, &poolProps);
@@ -567,14 +581,35 @@ VkResult InternalMemMgr::AllocGpuMem(
 
         if (result == VK_SUCCESS)
         {
+            Util::MutexAuto poolLock(&pPoolList->lock);
+
             // Assume that we won't find an appropriate pool
             result = VK_ERROR_OUT_OF_DEVICE_MEMORY;
 
-            // If found an appropriate pool list then search for a memory pool to suballocate from
-            for (auto it = pPoolList->Begin(); it.Get() != nullptr; it.Next())
+            // Try the pool the previous sub-allocation came from first so the common case avoids scanning the list
+            InternalMemoryPool* pLastPool = pPoolList->pLastPool;
+
+            if ((pLastPool != nullptr) &&
+                (pLastPool->pBuddyAllocator->Allocate(
+                    createInfo.pal.size,
+                    createInfo.pal.alignment,
+                    &pInternalMemory->m_offset) == Pal::Result::Success))
+            {
+                pInternalMemory->m_memoryPool = *pLastPool;
+
+                result = VK_SUCCESS;
+            }
+
+            // Otherwise search the rest of the pool list for a memory pool to suballocate from
+            for (auto it = pPoolList->pools.Begin(); (result != VK_SUCCESS) && (it.Get() != nullptr); it.Next())
             {
                 InternalMemoryPool* pPool = it.Get();
 
+                if (pPool == pLastPool)
+                {
+                    continue;
+                }
+
                 // Try to suballocate from the current memory pool using its buddy allocator
                 Pal::Result palResult = pPool->pBuddyAllocator->Allocate(
                     createInfo.pal.size,
@@ -585,10 +620,10 @@ VkResult InternalMemMgr::AllocGpuMem(
                 {
                     // If the suballocation succeeded, set the memory pool the suballocation came from
                     pInternalMemory->m_memoryPool = *pPool;
+                    pPoolList->pLastPool          = pPool;
 
-                    // Set the result to success and quit the loop
+                    // Set the result to success which also quits the loop
                     result = VK_SUCCESS;
-                    break;
                 }
             }
 
@@ -609,6 +644,7 @@ VkResult InternalMemMgr::AllocGpuMem(
     {
         // We don't suballocate from a pool so there's no buddy allocator and also offset is always zero
         pInternalMemory->m_memoryPool.pBuddyAllocator    = nullptr;
+        pInternalMemory->m_memoryPool.pPoolLock          = nullptr;
         pInternalMemory->m_offset = 0;
 
         // Issue a base memory allocation and use that as the memory object
@@ -744,13 +780,13 @@ VkResult InternalMemMgr::AllocAndBindGpuMem(
 void InternalMemMgr::FreeGpuMem(
     const InternalMemory* pInternalMemory)
 {
-    Util::MutexAuto lock(&m_allocatorLock);
-
     VK_ASSERT(pInternalMemory != nullptr);
 
     if (pInternalMemory->m_memoryPool.pBuddyAllocator != nullptr)
     {
-        // The memory was suballocated so free it using the buddy allocator
+        // The memory was suballocated so free it using the buddy allocator under the owning pool list's lock
+        Util::MutexAuto poolLock(pInternalMemory->m_memoryPool.pPoolLock);
+
         pInternalMemory->m_memoryPool.pBuddyAllocator->Free(
             pInternalMemory->m_offset,
             pInternalMemory->m_size,
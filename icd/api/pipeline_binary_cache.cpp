@@ -33,7 +33,11 @@
 #endif
 
 #include "include/pipeline_binary_cache.h"
+#include "include/compile_thread_pool.h"
 #include "include/vk_physical_device.h"
+#include "include/vk_pipeline_cache.h"
+
+#include "utils/lz_codec.h"
 
 #include "palArchiveFile.h"
 #include "palPlatformKey.h"
@@ -41,14 +45,20 @@
 #include "palVectorImpl.h"
 #include "palHashBaseImpl.h"
 #include "palFile.h"
-#if ICD_GPUOPEN_DEVMODE_BUILD
 #include "palPipelineAbiProcessorImpl.h"
-
+#if ICD_GPUOPEN_DEVMODE_BUILD
 #include "devmode/devmode_mgr.h"
 #endif
 #include <limits.h>
 #include <string.h>
 
+#if defined(__unix__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace vk
 {
 #if defined(__unix__)
@@ -58,6 +68,7 @@ namespace vk
 constexpr char   PipelineBinaryCache::EnvVarPath[];
 constexpr char   PipelineBinaryCache::EnvVarFileName[];
 constexpr char   PipelineBinaryCache::EnvVarReadOnlyFileName[];
+constexpr char   PipelineBinaryCache::EnvVarMappedFileName[];
 
 static constexpr char   ArchiveTypeString[]  = "VK_SHADER_PIPELINE_CACHE";
 static constexpr size_t ArchiveTypeStringLen = sizeof(ArchiveTypeString);
@@ -67,6 +78,46 @@ static constexpr size_t ElfTypeStringLen     = sizeof(ElfTypeString);
 const uint32_t PipelineBinaryCache::ArchiveType = Util::HashString(ArchiveTypeString, ArchiveTypeStringLen);
 const uint32_t PipelineBinaryCache::ElfType     = Util::HashString(ElfTypeString, ElfTypeStringLen);
 
+// Compressed entries are prefixed with this header.  Binaries stored without it are returned as-is, so caches written
+// with compression disabled remain loadable.
+struct CompressedEntryHeader
+{
+    uint32_t magic;             // CompressedEntryMagic; pipeline ELFs start with 0x7F 'E' 'L' 'F' instead
+    uint32_t codec;             // CompressedEntryCodec
+    uint64_t uncompressedSize;
+};
+
+static constexpr uint32_t CompressedEntryMagic = 0x5A4C4B56; // "VKLZ"
+static constexpr uint32_t CompressedEntryCodec = 1;          // utils::LzCompress()
+
+// Binaries below this size are not worth compressing
+static constexpr size_t   MinCompressedEntrySize = 256;
+
+// =====================================================================================================================
+static bool IsCompressedEntry(
+    const void* pEntry,
+    size_t      entrySize)
+{
+    const CompressedEntryHeader* pHeader = static_cast<const CompressedEntryHeader*>(pEntry);
+
+    return (entrySize > sizeof(CompressedEntryHeader)) &&
+           (pHeader->magic == CompressedEntryMagic);
+}
+
+// The serialized blob directly follows the vkGetPipelineCacheData header, so offsets aligned within the blob stay
+// aligned within the application's data and within a mapped file.
+static_assert((sizeof(PipelineCacheHeaderData) % VK_DEFAULT_MEM_ALIGN) == 0,
+              "Serialized binaries would be misaligned in the pipeline cache data");
+
+// =====================================================================================================================
+// Returns the offset of the binary of a serialized entry whose BinaryCacheEntry starts at entryOffset.  The binary is
+// padded to VK_DEFAULT_MEM_ALIGN from the start of the blob, like binaries allocated by the cache.
+static size_t GetEntryDataOffset(
+    size_t entryOffset)
+{
+    return Util::Pow2Align(entryOffset + sizeof(BinaryCacheEntry), VK_DEFAULT_MEM_ALIGN);
+}
+
 #if ICD_GPUOPEN_DEVMODE_BUILD
 static Util::Hash128 ParseHash128(const char* str);
 #endif
@@ -166,33 +217,29 @@ PipelineBinaryCache* PipelineBinaryCache::Create(
         else if ((pInitData != nullptr) &&
                  (initDataSize > (sizeof(BinaryCacheEntry) + sizeof(PipelineBinaryCachePrivateHeader))))
         {
-            const void* pBlob           = pInitData;
-            size_t   blobSize           = initDataSize;
-            constexpr size_t EntrySize  = sizeof(BinaryCacheEntry);
+            size_t entryOffset = sizeof(PipelineBinaryCachePrivateHeader);
 
-            pBlob         = Util::VoidPtrInc(pBlob, sizeof(PipelineBinaryCachePrivateHeader));
-            blobSize     -= sizeof(PipelineBinaryCachePrivateHeader);
-            while (blobSize > EntrySize)
+            while ((entryOffset + sizeof(BinaryCacheEntry)) < initDataSize)
             {
-                const BinaryCacheEntry* pEntry  = static_cast<const BinaryCacheEntry*>(pBlob);
-                const void*             pData   = Util::VoidPtrInc(pBlob, sizeof(BinaryCacheEntry));
-                const size_t entryAndDataSize   = pEntry->dataSize + sizeof(BinaryCacheEntry);
+                const BinaryCacheEntry* pEntry     = static_cast<const BinaryCacheEntry*>(
+                                                        Util::VoidPtrInc(pInitData, entryOffset));
+                const size_t            dataOffset = GetEntryDataOffset(entryOffset);
 
-                if (blobSize >= entryAndDataSize)
+                if ((dataOffset > initDataSize) || (pEntry->dataSize > (initDataSize - dataOffset)))
                 {
-                    //add to cache
-                    Util::Result result = pObj->StorePipelineBinary(&pEntry->hashId, pEntry->dataSize, pData);
-                    if (result != Util::Result::Success)
-                    {
-                        break;
-                    }
-                    pBlob = Util::VoidPtrInc(pBlob, entryAndDataSize);
-                    blobSize -= entryAndDataSize;
+                    break;
                 }
-                else
+
+                //add to cache
+                Util::Result result = pObj->StorePipelineBinary(&pEntry->hashId,
+                                                                pEntry->dataSize,
+                                                                Util::VoidPtrInc(pInitData, dataOffset));
+                if (result != Util::Result::Success)
                 {
                     break;
                 }
+
+                entryOffset = dataOffset + pEntry->dataSize;
             }
         }
     }
@@ -216,6 +263,30 @@ PipelineBinaryCache::PipelineBinaryCache(
     m_pArchiveLayer    { nullptr },
     m_openFiles        { pInstance->Allocator() },
     m_archiveLayers    { pInstance->Allocator() },
+    m_pMappedBlob      { nullptr },
+    m_mappedBlobSize   { 0 },
+    m_mappedScanOffset { 0 },
+    m_mappedEntries    { 32, pInstance->Allocator() },
+    m_pPendingStores   { nullptr },
+    m_pendingCapacity  { 0 },
+    m_pendingHead      { 0 },
+    m_pendingCount     { 0 },
+    m_stopWriter       { false },
+    m_hitCount         { 0 },
+    m_missCount        { 0 },
+    m_storeCount       { 0 },
+    m_evictionCount    { 0 },
+    m_memoryLayerBounded{ false },
+    m_dirtyEntries     { pInstance->Allocator() },
+    m_trackDirtyEntries{ false },
+    m_serializedEntries{ pInstance->Allocator() },
+    m_serializedSize   { sizeof(PipelineBinaryCachePrivateHeader) },
+    m_hashedCount      { 0 },
+    m_pSerializedHash  { nullptr },
+    m_pSerializedHashMem{ nullptr },
+    m_pSerializedData  { nullptr },
+    m_serializedDataCapacity{ 0 },
+    m_compressEntries  { false },
     m_isInternalCache  { internal }
 {
     // Without copy constructor, a class type variable can't be initialized in initialization list with gcc 4.8.5.
@@ -227,6 +298,8 @@ PipelineBinaryCache::PipelineBinaryCache(
 // =====================================================================================================================
 PipelineBinaryCache::~PipelineBinaryCache()
 {
+    DestroyAsyncWriter();
+
     for (FileVector::Iter i = m_openFiles.Begin(); i.IsValid(); i.Next())
     {
         i.Get()->Destroy();
@@ -249,6 +322,15 @@ PipelineBinaryCache::~PipelineBinaryCache()
         m_pInstance->FreeMem(m_pMemoryLayer);
     }
 
+    UnmapBlob();
+
+    ResetSerializedEntries();
+
+    if (m_pSerializedData != nullptr)
+    {
+        m_pInstance->FreeMem(m_pSerializedData);
+    }
+
 #if ICD_GPUOPEN_DEVMODE_BUILD
     if (m_pReinjectionLayer != nullptr)
     {
@@ -265,7 +347,16 @@ Util::Result PipelineBinaryCache::QueryPipelineBinary(
 {
     VK_ASSERT(m_pTopLayer != nullptr);
 
-    return m_pTopLayer->Query(pCacheId, pQuery);
+    Util::Result result = m_pTopLayer->Query(pCacheId, pQuery);
+
+    if ((result != Util::Result::Success) && FindPendingStore(pCacheId, false, &pQuery->dataSize, nullptr))
+    {
+        result = Util::Result::Success;
+    }
+
+    Util::AtomicIncrement((result == Util::Result::Success) ? &m_hitCount : &m_missCount);
+
+    return result;
 }
 
 // =====================================================================================================================
@@ -274,6 +365,22 @@ Util::Result PipelineBinaryCache::LoadPipelineBinary(
     const CacheId* pCacheId,
     size_t*        pPipelineBinarySize,
     const void**   ppPipelineBinary) const
+{
+    Util::Result result = LoadFromLayers(pCacheId, true, pPipelineBinarySize, ppPipelineBinary);
+
+    Util::AtomicIncrement((result == Util::Result::Success) ? &m_hitCount : &m_missCount);
+
+    return result;
+}
+
+// =====================================================================================================================
+// Load a binary from the layer chain or the background write queue without updating the statistics.  Unless
+// decompress is false, compressed entries are returned decompressed.
+Util::Result PipelineBinaryCache::LoadFromLayers(
+    const CacheId* pCacheId,
+    bool           decompress,
+    size_t*        pPipelineBinarySize,
+    const void**   ppPipelineBinary) const
 {
     VK_ASSERT(m_pTopLayer != nullptr);
 
@@ -291,104 +398,154 @@ Util::Result PipelineBinaryCache::LoadPipelineBinary(
         {
             result = m_pTopLayer->Load(&query, pOutputMem);
 
+            if ((result == Util::Result::Success) && decompress && IsCompressedEntry(pOutputMem, query.dataSize))
+            {
+                size_t binarySize = 0;
+                void*  pBinary    = DecompressEntry(pOutputMem, query.dataSize, &binarySize);
+
+                m_pInstance->FreeMem(pOutputMem);
+
+                pOutputMem     = pBinary;
+                query.dataSize = binarySize;
+                result         = (pBinary != nullptr) ? Util::Result::Success : Util::Result::ErrorUnknown;
+            }
+
             if (result == Util::Result::Success)
             {
                 *pPipelineBinarySize = query.dataSize;
                 *ppPipelineBinary    = pOutputMem;
             }
-            else
+            else if (pOutputMem != nullptr)
             {
                 m_pInstance->FreeMem(pOutputMem);
             }
         }
     }
 
+    if ((result != Util::Result::Success) &&
+        FindPendingStore(pCacheId, decompress, pPipelineBinarySize, ppPipelineBinary))
+    {
+        result = Util::Result::Success;
+    }
+
     return result;
 }
 
 // =====================================================================================================================
-// Attempt to store a binary into a cache chain
-Util::Result PipelineBinaryCache::StorePipelineBinary(
-    const CacheId*  pCacheId,
-    size_t          pipelineBinarySize,
-    const void*     pPipelineBinary)
+// Decompress an entry which starts with a CompressedEntryHeader into a new allocation owned by the caller.  Returns
+// null if the entry is corrupt or out of memory.
+void* PipelineBinaryCache::DecompressEntry(
+    const void* pEntry,
+    size_t      entrySize,
+    size_t*     pPipelineBinarySize) const
 {
-    VK_ASSERT(m_pTopLayer != nullptr);
+    VK_ASSERT(IsCompressedEntry(pEntry, entrySize));
 
-    return m_pTopLayer->Store(pCacheId, pPipelineBinary, pipelineBinarySize);
-}
+    const CompressedEntryHeader* pHeader = static_cast<const CompressedEntryHeader*>(pEntry);
 
-#if ICD_GPUOPEN_DEVMODE_BUILD
-// =====================================================================================================================
-// Introduces a mapping from an internal pipeline hash to a cache ID
-void PipelineBinaryCache::RegisterHashMapping(
-    const Pal::PipelineHash* pInternalPipelineHash,
-    const CacheId*           pCacheId)
-{
-    VK_ASSERT(pInternalPipelineHash != nullptr);
-    VK_ASSERT(pCacheId              != nullptr);
+    void* pBinary = nullptr;
 
-    if (m_pReinjectionLayer != nullptr)
+    if ((pHeader->codec == CompressedEntryCodec) && (pHeader->uncompressedSize <= SIZE_MAX))
     {
-        Util::RWLockAuto<Util::RWLock::LockType::ReadWrite> readWriteLock(&m_hashMappingLock);
-
-        m_hashMapping.Insert(*pInternalPipelineHash, *pCacheId);
-    }
-}
-
-// =====================================================================================================================
-// Retrieves the cache ID that maps to the given internal pipeline hash, pCacheId is unchanged if no mapping found
-PipelineBinaryCache::CacheId* PipelineBinaryCache::GetCacheIdForPipeline(
-    const Pal::PipelineHash* pInternalPipelineHash)
-{
-    VK_ASSERT(pInternalPipelineHash != nullptr);
+        const size_t binarySize = static_cast<size_t>(pHeader->uncompressedSize);
 
-    CacheId* pCacheId = nullptr;
+        pBinary = m_pInstance->AllocMem(binarySize, VK_DEFAULT_MEM_ALIGN, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
 
-    if (m_pReinjectionLayer != nullptr)
-    {
-        Util::RWLockAuto<Util::RWLock::LockType::ReadOnly> readWriteLock(&m_hashMappingLock);
+        if ((pBinary != nullptr) &&
+            (utils::LzDecompress(Util::VoidPtrInc(pEntry, sizeof(CompressedEntryHeader)),
+                                 entrySize - sizeof(CompressedEntryHeader),
+                                 pBinary,
+                                 binarySize) == false))
+        {
+            m_pInstance->FreeMem(pBinary);
+            pBinary = nullptr;
+        }
 
-        pCacheId = m_hashMapping.FindKey(*pInternalPipelineHash);
+        if (pBinary != nullptr)
+        {
+            *pPipelineBinarySize = binarySize;
+        }
     }
 
-    return pCacheId;
+    VK_ALERT(pBinary == nullptr);
+
+    return pBinary;
 }
 
 // =====================================================================================================================
-// Attempt to load a binary from the reinjection cache layer
-Util::Result PipelineBinaryCache::LoadReinjectionBinary(
-    const CacheId* pInternalPipelineHash,
+// Look up a pipeline binary in the memory-mapped blob.  On success the returned pointer points into the mapping and
+// must not be freed; see IsMappedPipelineBinary().  It stays valid for the lifetime of the cache.  Compressed entries
+// are decompressed into an allocation which the caller frees like any other loaded binary.  If ppPipelineBinary is
+// null, only the binary size is returned and the binary is not validated.
+Util::Result PipelineBinaryCache::LoadMappedPipelineBinary(
+    const CacheId* pCacheId,
     size_t*        pPipelineBinarySize,
     const void**   ppPipelineBinary)
 {
-    Util::Result result = Util::Result::ErrorUnavailable;
+    Util::Result result = Util::Result::NotFound;
 
-    if (m_pReinjectionLayer != nullptr)
+    MappedEntry  entry        = {};
+    MappedEntry* pMappedEntry = FindMappedEntry(pCacheId, &entry);
+
+    if (pMappedEntry != nullptr)
     {
-        Util::QueryResult query = {};
-        result = m_pReinjectionLayer->Query(pInternalPipelineHash, &query);
+        const void*  pData    = entry.pData;
+        const size_t dataSize = static_cast<size_t>(entry.pEntry->dataSize);
 
-        if (result == Util::Result::Success)
+        if (entry.state == MappedEntryState::Invalid)
         {
-            void* pOutputMem = m_pInstance->AllocMem(
-                query.dataSize,
-                VK_DEFAULT_MEM_ALIGN,
-                VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+            result = Util::Result::NotFound;
+        }
+        else if (IsCompressedEntry(pData, dataSize) == false)
+        {
+            *pPipelineBinarySize = dataSize;
 
-            if (pOutputMem != nullptr)
+            if (ppPipelineBinary != nullptr)
             {
-                result = m_pReinjectionLayer->Load(&query, pOutputMem);
+                VK_ASSERT(Util::IsPow2Aligned(reinterpret_cast<uint64_t>(pData), VK_DEFAULT_MEM_ALIGN));
 
-                if (result == Util::Result::Success)
-                {
-                    *pPipelineBinarySize = query.dataSize;
-                    *ppPipelineBinary = pOutputMem;
-                }
-                else
+                *ppPipelineBinary = pData;
+            }
+
+            result = Util::Result::Success;
+        }
+        else if (ppPipelineBinary == nullptr)
+        {
+            *pPipelineBinarySize = static_cast<size_t>(
+                static_cast<const CompressedEntryHeader*>(pData)->uncompressedSize);
+
+            result = Util::Result::Success;
+        }
+        else
+        {
+            *ppPipelineBinary = DecompressEntry(pData, dataSize, pPipelineBinarySize);
+
+            result = (*ppPipelineBinary != nullptr) ? Util::Result::Success : Util::Result::ErrorUnknown;
+        }
+
+        if ((result == Util::Result::Success) &&
+            (ppPipelineBinary != nullptr) &&
+            (entry.state == MappedEntryState::Unchecked))
+        {
+            // Concurrent first loads of an entry may both validate it, which is harmless
+            const bool isValid = IsValidMappedBinary(*ppPipelineBinary, *pPipelineBinarySize);
+
+            {
+                Util::MutexAuto lock(&m_mappedLock);
+
+                pMappedEntry->state = isValid ? MappedEntryState::Valid : MappedEntryState::Invalid;
+            }
+
+            if (isValid == false)
+            {
+                if (IsMappedPipelineBinary(*ppPipelineBinary) == false)
                 {
-                    m_pInstance->FreeMem(pOutputMem);
+                    FreePipelineBinary(*ppPipelineBinary);
                 }
+
+                *ppPipelineBinary = nullptr;
+
+                result = Util::Result::NotFound;
             }
         }
     }
@@ -397,576 +554,1472 @@ Util::Result PipelineBinaryCache::LoadReinjectionBinary(
 }
 
 // =====================================================================================================================
-// Attempt to store a binary into the reinjection cache layer
-Util::Result PipelineBinaryCache::StoreReinjectionBinary(
-    const CacheId*  pInternalPipelineHash,
-    size_t          pipelineBinarySize,
-    const void*     pPipelineBinary)
+// Find an entry of the memory-mapped blob and copy it to pEntry, indexing the entries which follow the already indexed
+// ones until it is found.  Each entry is indexed at most once, so the cost of walking the mapping is spread over the
+// lookups instead of being paid when the device is created.  The returned entry stays at the same address.
+MappedEntry* PipelineBinaryCache::FindMappedEntry(
+    const CacheId* pCacheId,
+    MappedEntry*   pEntry)
 {
-    Util::Result result = Util::Result::ErrorUnavailable;
+    MappedEntry* pMappedEntry = nullptr;
 
-    if (m_pReinjectionLayer != nullptr)
+    if (m_pMappedBlob != nullptr)
     {
-        uint32_t gfxIpMajor = 0u;
-        uint32_t gfxIpMinor = 0u;
-        uint32_t gfxIpStepping = 0u;
+        const uint64_t key      = Util::MetroHash::Compact64(pCacheId);
+        const void*    pBlob    = Util::VoidPtrInc(m_pMappedBlob, sizeof(PipelineCacheHeaderData));
+        const size_t   blobSize = m_mappedBlobSize - sizeof(PipelineCacheHeaderData);
 
-        Util::Abi::PipelineAbiProcessor<PalAllocator> processor(m_pInstance->Allocator());
-        result = processor.LoadFromBuffer(pPipelineBinary, pipelineBinarySize);
+        Util::MutexAuto lock(&m_mappedLock);
 
-        if (result == Util::Result::Success)
+        pMappedEntry = m_mappedEntries.FindKey(key);
+
+        while ((pMappedEntry == nullptr) && ((m_mappedScanOffset + sizeof(BinaryCacheEntry)) < blobSize))
         {
-            processor.GetGfxIpVersion(&gfxIpMajor, &gfxIpMinor, &gfxIpStepping);
+            const BinaryCacheEntry* pBinaryEntry = static_cast<const BinaryCacheEntry*>(
+                                                      Util::VoidPtrInc(pBlob, m_mappedScanOffset));
+            const size_t            dataOffset   = GetEntryDataOffset(m_mappedScanOffset);
 
-            if (gfxIpMajor == m_gfxIp.major &&
-                gfxIpMinor == m_gfxIp.minor &&
-                gfxIpStepping == m_gfxIp.stepping)
+            if ((dataOffset > blobSize) || (pBinaryEntry->dataSize > (blobSize - dataOffset)))
             {
-                result = m_pReinjectionLayer->Store(pInternalPipelineHash, pPipelineBinary, pipelineBinarySize);
+                // The entry is truncated, so nothing after it can be indexed
+                m_mappedScanOffset = blobSize;
+                break;
             }
-            else
+
+            m_mappedScanOffset = dataOffset + pBinaryEntry->dataSize;
+
+            const uint64_t entryKey  = Util::MetroHash::Compact64(&pBinaryEntry->hashId);
+            bool           existed   = false;
+            MappedEntry*   pNewEntry = nullptr;
+
+            if ((m_mappedEntries.FindAllocate(entryKey, &existed, &pNewEntry) == Util::Result::Success) &&
+                (existed == false))
             {
-                result = Util::Result::ErrorIncompatibleDevice;
+                pNewEntry->pEntry = pBinaryEntry;
+                pNewEntry->pData  = Util::VoidPtrInc(pBlob, dataOffset);
+                pNewEntry->state  = MappedEntryState::Unchecked;
+
+                if (entryKey == key)
+                {
+                    pMappedEntry = pNewEntry;
+                }
             }
         }
+
+        if ((pMappedEntry != nullptr) &&
+            (memcmp(&pMappedEntry->pEntry->hashId, pCacheId, sizeof(CacheId)) == 0))
+        {
+            *pEntry = *pMappedEntry;
+        }
+        else
+        {
+            pMappedEntry = nullptr;
+        }
     }
 
-    return result;
+    return pMappedEntry;
 }
 
-#endif
 // =====================================================================================================================
-// Free memory allocated by our allocator
-void PipelineBinaryCache::FreePipelineBinary(
-    const void* pPipelineBinary)
+// Check that a binary of the memory-mapped blob is a pipeline ELF for this GPU before it is used for the first time.
+// The file is only validated by its header, so a damaged or foreign entry must not reach pipeline creation.
+bool PipelineBinaryCache::IsValidMappedBinary(
+    const void* pBinary,
+    size_t      binarySize) const
 {
-    if (pPipelineBinary != nullptr)
+    Util::Abi::PipelineAbiProcessor<PalAllocator> processor(m_pInstance->Allocator());
+
+    bool isValid = (processor.LoadFromBuffer(pBinary, binarySize) == Util::Result::Success);
+
+    if (isValid)
     {
-        m_pInstance->FreeMem(const_cast<void*>(pPipelineBinary));
+        uint32_t gfxIpMajor    = 0u;
+        uint32_t gfxIpMinor    = 0u;
+        uint32_t gfxIpStepping = 0u;
+
+        processor.GetGfxIpVersion(&gfxIpMajor, &gfxIpMinor, &gfxIpStepping);
+
+        isValid = (gfxIpMajor    == m_gfxIp.major) &&
+                  (gfxIpMinor    == m_gfxIp.minor) &&
+                  (gfxIpStepping == m_gfxIp.stepping);
     }
+
+    VK_ALERT(isValid == false);
+
+    return isValid;
 }
 
 // =====================================================================================================================
-// Build the cache layer chain
-VkResult PipelineBinaryCache::Initialize(
-    const PhysicalDevice* pPhysicalDevice)
+// Returns true if the binary was returned by LoadMappedPipelineBinary() and is therefore not owned by the caller
+bool PipelineBinaryCache::IsMappedPipelineBinary(
+    const void* pPipelineBinary) const
 {
-    VkResult result = VK_SUCCESS;
+    return (m_pMappedBlob != nullptr) &&
+           (pPipelineBinary >= m_pMappedBlob) &&
+           (pPipelineBinary <  Util::VoidPtrInc(m_pMappedBlob, m_mappedBlobSize));
+}
 
-    const RuntimeSettings& settings = pPhysicalDevice->GetRuntimeSettings();
+// =====================================================================================================================
+// Attempt to store a binary into a cache chain
+Util::Result PipelineBinaryCache::StorePipelineBinary(
+    const CacheId*  pCacheId,
+    size_t          pipelineBinarySize,
+    const void*     pPipelineBinary)
+{
+    VK_ASSERT(m_pTopLayer != nullptr);
 
-    if (result == VK_SUCCESS)
-    {
-        m_pPlatformKey = pPhysicalDevice->GetPlatformKey();
-    }
+    Util::Result result = Util::Result::Success;
 
-    if (m_pPlatformKey == nullptr)
+    if (QueuePendingStore(pCacheId, pipelineBinarySize, pPipelineBinary) == false)
     {
-        result = VK_ERROR_INITIALIZATION_FAILED;
+        result = StoreToLayers(pCacheId, pipelineBinarySize, pPipelineBinary);
     }
 
-    if (result == VK_SUCCESS)
-    {
-        result = InitLayers(pPhysicalDevice, m_isInternalCache, settings);
-    }
+    return result;
+}
 
-    if (result == VK_SUCCESS)
-    {
-        result = OrderLayers(settings);
-    }
+// =====================================================================================================================
+// Store a binary into the layer chain.  With compression enabled, the binary is compressed first if that saves space;
+// binaries which are already compressed (e.g. from vkGetPipelineCacheData blobs) are stored as-is.
+Util::Result PipelineBinaryCache::StoreToLayers(
+    const CacheId*  pCacheId,
+    size_t          pipelineBinarySize,
+    const void*     pPipelineBinary)
+{
+    void*  pCompressed    = nullptr;
+    size_t compressedSize = 0;
 
-#if ICD_GPUOPEN_DEVMODE_BUILD
-    if ((result == VK_SUCCESS) &&
-        (m_pReinjectionLayer != nullptr))
+    if (m_compressEntries &&
+        (pipelineBinarySize >= MinCompressedEntrySize) &&
+        (IsCompressedEntry(pPipelineBinary, pipelineBinarySize) == false))
     {
-        Util::Result palResult = m_pInstance->GetDevModeMgr()->RegisterPipelineCache(
-            this,
-            settings.devModePipelineUriServicePostSizeLimit);
+        // Only keep the result if it is smaller than the binary
+        const size_t capacity = pipelineBinarySize - sizeof(CompressedEntryHeader) - 1;
 
-        if (palResult == Util::Result::Success)
-        {
-            palResult = m_hashMapping.Init();
-        }
+        pCompressed = m_pInstance->AllocMem(
+            sizeof(CompressedEntryHeader) + capacity,
+            VK_DEFAULT_MEM_ALIGN,
+            VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
 
-        if (palResult == Util::Result::Success)
+        if (pCompressed != nullptr)
         {
-            palResult = m_hashMappingLock.Init();
+            compressedSize = utils::LzCompress(pPipelineBinary,
+                                               pipelineBinarySize,
+                                               Util::VoidPtrInc(pCompressed, sizeof(CompressedEntryHeader)),
+                                               capacity);
         }
 
-        if (palResult != Util::Result::Success)
+        if (compressedSize > 0)
         {
-            m_pReinjectionLayer->Destroy();
-            m_pReinjectionLayer = nullptr;
+            CompressedEntryHeader* pHeader = static_cast<CompressedEntryHeader*>(pCompressed);
 
-            // Fail silently so that the pipeline cache may still be used for other purposes.
-            PAL_ASSERT_ALWAYS();
+            pHeader->magic            = CompressedEntryMagic;
+            pHeader->codec            = CompressedEntryCodec;
+            pHeader->uncompressedSize = pipelineBinarySize;
+
+            pPipelineBinary    = pCompressed;
+            pipelineBinarySize = sizeof(CompressedEntryHeader) + compressedSize;
         }
     }
-#endif
 
-    return result;
-}
+    Util::Result result = Util::Result::Success;
 
-#if ICD_GPUOPEN_DEVMODE_BUILD
-// =====================================================================================================================
-// Initialize reinjection cache layer
-VkResult PipelineBinaryCache::InitReinjectionLayer(
-    const RuntimeSettings& settings)
-{
-    VkResult result = VK_ERROR_FEATURE_NOT_PRESENT;
-
-    if (m_pInstance->GetDevModeMgr() != nullptr)
+    if (m_memoryLayerBounded)
     {
-        Util::MemoryCacheCreateInfo info = {};
-        Util::AllocCallbacks        allocCbs = {
-            m_pInstance->GetAllocCallbacks(),
-            allocator::PalAllocFuncDelegator,
-            allocator::PalFreeFuncDelegator
-        };
-
-        info.baseInfo.pCallbacks = &allocCbs;
-        info.maxObjectCount = SIZE_MAX;
-        info.maxMemorySize = SIZE_MAX;
-        info.evictOnFull = false;
-        info.evictDuplicates = true;
+        result = StoreToBoundedLayers(pCacheId, pipelineBinarySize, pPipelineBinary);
+    }
+    else
+    {
+        result = m_pTopLayer->Store(pCacheId, pPipelineBinary, pipelineBinarySize);
+    }
 
-        size_t memSize = Util::GetMemoryCacheLayerSize(&info);
-        void*  pMem    = m_pInstance->AllocMem(memSize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+    if ((result == Util::Result::Success) && (m_pMemoryLayer != nullptr))
+    {
+        Util::AtomicIncrement(&m_storeCount);
 
-        if (pMem == nullptr)
-        {
-            result = VK_ERROR_OUT_OF_HOST_MEMORY;
-        }
-        else
+        if (m_isInternalCache == false)
         {
-            result = PalToVkResult(
-                Util::CreateMemoryCacheLayer(
-                    &info,
-                    pMem,
-                    &m_pReinjectionLayer));
+            Util::MutexAuto lock(&m_dirtyLock);
 
-            if (result != VK_SUCCESS)
+            // Dirty entries are only needed to append to a valid serialized entry layout.  On failure the next
+            // Serialize() notices the missing entry and rebuilds the layout.
+            if (m_trackDirtyEntries)
             {
-                m_pInstance->FreeMem(pMem);
+                m_dirtyEntries.PushBack(*pCacheId);
             }
         }
+    }
 
-        if (result == VK_SUCCESS)
-        {
-            result = PalToVkResult(InjectBinariesFromDirectory(settings));
-        }
+    if (pCompressed != nullptr)
+    {
+        m_pInstance->FreeMem(pCompressed);
     }
 
     return result;
 }
 
 // =====================================================================================================================
-// Helper function for converting a 32-digit hexadecimal (in C string format) to a Hash128 object
-Util::Hash128 ParseHash128(const char* str)
+// Store a binary into a layer chain whose memory layer evicts entries to stay within its budget, and count the entries
+// that the store evicted.  The memory layer evicts internally, so the evictions are derived from its entry count
+// before and after the store.  A store replacing a resident entry of the same ID is not an eviction.  Stores are
+// serialized so that concurrent stores don't skew each other's counts.
+Util::Result PipelineBinaryCache::StoreToBoundedLayers(
+    const CacheId*  pCacheId,
+    size_t          pipelineBinarySize,
+    const void*     pPipelineBinary)
 {
-    Util::Hash128   hash;
-    const uint32_t  stride = 2u; // 1 byte = 2 hex digits
-    const uint32_t  byteCount = (sizeof(hash.bytes) / sizeof(*hash.bytes));
-    uint32_t        stringIndex = 0u;
-    char            buffer[stride + 1u];
-    buffer[stride] = '\n';
+    VK_ASSERT(m_pTopLayer == m_pMemoryLayer);
 
-    // Using little-endian byte order
-    for (uint32_t byteIndex = 0u; byteIndex < byteCount; byteIndex++)
+    Util::MutexAuto lock(&m_boundedStoreLock);
+
+    Util::QueryResult query       = {};
+    const bool        isResident  = (m_pMemoryLayer->Query(pCacheId, &query) == Util::Result::Success) &&
+                                    (query.pLayer == m_pMemoryLayer);
+    size_t            countBefore = 0;
+    size_t            countAfter  = 0;
+    size_t            curDataSize = 0;
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 534
+    Util::Result countResult = Util::GetMemoryCacheLayerCurSize(m_pMemoryLayer, &countBefore, &curDataSize);
+#else
+    Util::Result countResult = Util::Result::Unsupported;
+#endif
+
+    Util::Result result = m_pTopLayer->Store(pCacheId, pPipelineBinary, pipelineBinarySize);
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 534
+    if ((result == Util::Result::Success) && (countResult == Util::Result::Success))
     {
-        stringIndex = (byteCount - byteIndex - 1) * stride;
-        memcpy(buffer, &str[stringIndex], stride);
-        hash.bytes[byteIndex] = static_cast<uint8_t>(strtoul(buffer, nullptr, 16));
+        countResult = Util::GetMemoryCacheLayerCurSize(m_pMemoryLayer, &countAfter, &curDataSize);
     }
+#endif
 
-    return hash;
+    if ((result == Util::Result::Success) && (countResult == Util::Result::Success))
+    {
+        const size_t countExpected = isResident ? countBefore : (countBefore + 1);
+
+        if (countAfter < countExpected)
+        {
+            m_evictionCount += static_cast<uint32_t>(countExpected - countAfter);
+        }
+    }
+
+    return result;
 }
 
 // =====================================================================================================================
-// Adds binaries to reinjection cache layer from a directory source
-Util::Result PipelineBinaryCache::InjectBinariesFromDirectory(
-    const RuntimeSettings& settings)
+// Report the cache statistics
+void PipelineBinaryCache::GetStatistics(
+    Statistics* pStats) const
 {
-    Util::Result result = Util::Result::Success;
+    memset(pStats, 0, sizeof(*pStats));
 
-    if (settings.devModeElfReplacementDirectoryEnable)
+    pStats->hits      = m_hitCount;
+    pStats->misses    = m_missCount;
+    pStats->stores    = m_storeCount;
+    pStats->evictions = m_evictionCount;
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 534
+    if (m_pMemoryLayer != nullptr)
     {
-        Util::File      file;
-        char            filePath[260]; // Windows MAX_PATH = 260
-        uint32_t        fileCount           = 0u;
-        const char**    ppFileNames         = nullptr;
-        size_t          fileNameBufferSize  = 0u;
-        void*           pFileNameBuffer     = nullptr;
-        size_t          dirLength           = strlen(settings.devModeElfReplacementDirectory) + 1u;
+        Util::GetMemoryCacheLayerCurSize(m_pMemoryLayer, &pStats->residentEntries, &pStats->residentBytes);
+    }
+#endif
+}
 
-        Util::Hash128   pipelineHash        = {};
-        size_t          pipelineBinarySize  = 0u;
-        void*           pPipelineBinary     = nullptr;
+// =====================================================================================================================
+// Hand a copy of the binary to the background writer.  Returns false if the writer is disabled or its queue is full,
+// in which case the caller stores the binary synchronously.
+bool PipelineBinaryCache::QueuePendingStore(
+    const CacheId*  pCacheId,
+    size_t          pipelineBinarySize,
+    const void*     pPipelineBinary)
+{
+    bool queued = false;
 
-        // Get the number of files in dir and the size of the buffer to hold their names
-        result = Util::ListDir(
-            settings.devModeElfReplacementDirectory,
-            &fileCount,
-            nullptr,
-            &fileNameBufferSize,
-            nullptr);
+    if (m_pPendingStores != nullptr)
+    {
+        void* pData = m_pInstance->AllocMem(pipelineBinarySize, VK_DEFAULT_MEM_ALIGN, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
 
-        if (fileCount == 0u)
+        if (pData != nullptr)
         {
-            return result;
-        }
+            memcpy(pData, pPipelineBinary, pipelineBinarySize);
 
-        if (result == Util::Result::Success)
-        {
-            // Allocate space for ppFileNames and pFileNameBuffer
-            ppFileNames = (const char**)m_pInstance->AllocMem(
-                (sizeof(const char*) * fileCount),
-                VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
-            pFileNameBuffer = m_pInstance->AllocMem(
-                fileNameBufferSize,
-                VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+            {
+                Util::MutexAuto lock(&m_pendingLock);
 
-            // Populate ppFileNames and pFileNameBuffer
-            result = Util::ListDir(
-                settings.devModeElfReplacementDirectory,
-                &fileCount,
-                ppFileNames,
-                &fileNameBufferSize,
-                pFileNameBuffer);
+                if (m_pendingCount < m_pendingCapacity)
+                {
+                    PendingStore* pStore = &m_pPendingStores[(m_pendingHead + m_pendingCount) % m_pendingCapacity];
 
-            if (result != Util::Result::Success)
+                    pStore->cacheId  = *pCacheId;
+                    pStore->dataSize = pipelineBinarySize;
+                    pStore->pData    = pData;
+
+                    m_pendingCount++;
+                    queued = true;
+                }
+            }
+
+            if (queued)
             {
-                m_pInstance->FreeMem(pFileNameBuffer);
-                m_pInstance->FreeMem(ppFileNames);
+                m_pendingEvent.Set();
+            }
+            else
+            {
+                m_pInstance->FreeMem(pData);
             }
         }
+    }
 
-        if (result == Util::Result::Success)
-        {
-            // Store each file into cache
-            strcpy(filePath, settings.devModeElfReplacementDirectory);
-            strcat(filePath, "\\");
-            for (uint32_t fileIndex = 0; fileIndex < fileCount; fileIndex++)
-            {
-                filePath[dirLength] = '\0';
-                strcat(filePath, ppFileNames[fileIndex]);
+    return queued;
+}
 
-                ppFileNames[fileIndex] = strstr(ppFileNames[fileIndex], "_0x");
+// =====================================================================================================================
+// Look for a binary that is queued but not yet written.  If ppPipelineBinary is not null, it receives a copy which the
+// caller frees like any other loaded binary.  Queued binaries are kept as they were passed to StorePipelineBinary(),
+// which may already be compressed (e.g. from vkGetPipelineCacheData blobs), so unless decompress is false, compressed
+// entries are returned decompressed just like from the layer chain.
+bool PipelineBinaryCache::FindPendingStore(
+    const CacheId*  pCacheId,
+    bool            decompress,
+    size_t*         pPipelineBinarySize,
+    const void**    ppPipelineBinary) const
+{
+    bool found = false;
 
-                if ((ppFileNames[fileIndex] != nullptr) &&
-                    (strlen(ppFileNames[fileIndex]) >= 32))
+    if (m_pPendingStores != nullptr)
+    {
+        Util::MutexAuto lock(&m_pendingLock);
+
+        for (uint32_t i = 0; (i < m_pendingCount) && (found == false); ++i)
+        {
+            const PendingStore& store = m_pPendingStores[(m_pendingHead + i) % m_pendingCapacity];
+
+            if (memcmp(&store.cacheId, pCacheId, sizeof(CacheId)) == 0)
+            {
+                if (ppPipelineBinary != nullptr)
                 {
-                    ppFileNames[fileIndex] += 3u;
-                    pipelineHash = ParseHash128(ppFileNames[fileIndex]);
+                    size_t binarySize = store.dataSize;
+                    void*  pOutputMem = nullptr;
 
-                    if (Util::File::Exists(filePath))
+                    if (decompress && IsCompressedEntry(store.pData, store.dataSize))
                     {
-                        pipelineBinarySize = Util::File::GetFileSize(filePath);
-                        pPipelineBinary = m_pInstance->AllocMem(pipelineBinarySize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+                        pOutputMem = DecompressEntry(store.pData, store.dataSize, &binarySize);
+                    }
+                    else
+                    {
+                        pOutputMem = m_pInstance->AllocMem(
+                            store.dataSize,
+                            VK_DEFAULT_MEM_ALIGN,
+                            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
 
-                        if (pPipelineBinary != nullptr)
+                        if (pOutputMem != nullptr)
                         {
-                            if (file.Open(
-                                filePath,
-                                Util::FileAccessRead | Util::FileAccessBinary) == Util::Result::Success)
-                            {
-                                if (file.Read(pPipelineBinary, pipelineBinarySize, nullptr) == Util::Result::Success)
-                                {
-                                    StoreReinjectionBinary(&pipelineHash, pipelineBinarySize, pPipelineBinary);
-                                }
-                                else
-                                {
-                                    VK_NEVER_CALLED();
-                                }
-
-                                file.Close();
-                            }
-                            else
-                            {
-                                VK_NEVER_CALLED();
-                            }
+                            memcpy(pOutputMem, store.pData, store.dataSize);
                         }
-
-                        m_pInstance->FreeMem(pPipelineBinary);
                     }
-                    else
+
+                    if (pOutputMem != nullptr)
                     {
-                        VK_NEVER_CALLED();
+                        *ppPipelineBinary    = pOutputMem;
+                        *pPipelineBinarySize = binarySize;
+                        found                = true;
                     }
                 }
-            }
+                else
+                {
+                    *pPipelineBinarySize = store.dataSize;
+                    found                = true;
+                }
 
-            m_pInstance->FreeMem(pFileNameBuffer);
-            m_pInstance->FreeMem(ppFileNames);
+                break;
+            }
         }
     }
 
-    return result;
+    return found;
 }
-#endif
 
 // =====================================================================================================================
-// Initialize memory layer
-VkResult PipelineBinaryCache::InitMemoryCacheLayer(
-    const RuntimeSettings& settings)
+// Block until the background writer has written every queued binary
+void PipelineBinaryCache::FlushPendingStores()
 {
-    VK_ASSERT(m_pMemoryLayer == nullptr);
+    if (m_pPendingStores != nullptr)
+    {
+        bool pending = true;
 
-    Util::AllocCallbacks allocCallbacks = {};
-    allocCallbacks.pClientData = m_pInstance->GetAllocCallbacks();
-    allocCallbacks.pfnAlloc    = allocator::PalAllocFuncDelegator;
-    allocCallbacks.pfnFree     = allocator::PalFreeFuncDelegator;
+        while (pending)
+        {
+            {
+                Util::MutexAuto lock(&m_pendingLock);
 
-    Util::MemoryCacheCreateInfo createInfo = {};
-    createInfo.baseInfo.pCallbacks = &allocCallbacks;
-    createInfo.maxObjectCount      = SIZE_MAX;
-    createInfo.maxMemorySize       = SIZE_MAX;
-    createInfo.evictOnFull         = true;
-    createInfo.evictDuplicates     = true;
+                pending = (m_pendingCount > 0);
 
-    size_t layerSize = Util::GetMemoryCacheLayerSize(&createInfo);
-    void*  pMem      = m_pInstance->AllocMem(layerSize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+                // The writer sets the event under the lock once it has written the last queued store
+                if (pending)
+                {
+                    m_drainedEvent.Reset();
+                }
+            }
+
+            if (pending)
+            {
+                m_pendingEvent.Set();
+                m_drainedEvent.Wait(Util::InfiniteTimeout);
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Start the background writer for caches backed by archive files
+VkResult PipelineBinaryCache::InitAsyncWriter(
+    const RuntimeSettings& settings)
+{
+    VK_ASSERT(m_pPendingStores == nullptr);
+
+    const uint32_t capacity = settings.pipelineCacheAsyncWriteQueueSize;
 
     VkResult result = VK_SUCCESS;
 
-    if (pMem == nullptr)
+    m_pPendingStores = static_cast<PendingStore*>(m_pInstance->AllocMem(
+        capacity * sizeof(PendingStore),
+        VK_SYSTEM_ALLOCATION_SCOPE_OBJECT));
+
+    if (m_pPendingStores == nullptr)
     {
         result = VK_ERROR_OUT_OF_HOST_MEMORY;
     }
-    else
+
+    if (result == VK_SUCCESS)
     {
-        result = PalToVkResult(CreateMemoryCacheLayer(&createInfo, pMem, &m_pMemoryLayer));
-        VK_ASSERT(result == VK_SUCCESS);
+        m_pendingCapacity = capacity;
 
-        if (result != VK_SUCCESS)
-        {
-            m_pInstance->FreeMem(pMem);
-        }
+        result = PalToVkResult(m_pendingLock.Init());
     }
 
-    return result;
-}
+    if (result == VK_SUCCESS)
+    {
+        Util::EventCreateFlags flags = {};
+        flags.manualReset       = false;
+        flags.initiallySignaled = false;
 
-// =====================================================================================================================
-// Open an archive file from disk for read
-Util::IArchiveFile* PipelineBinaryCache::OpenReadOnlyArchive(
-    const char* pFilePath,
-    const char* pFileName,
-    size_t      bufferSize)
-{
-    VK_ASSERT(pFilePath != nullptr);
-    VK_ASSERT(pFileName != nullptr);
+        result = PalToVkResult(m_pendingEvent.Init(flags));
+    }
 
-    Util::ArchiveFileOpenInfo info  = {};
-    Util::IArchiveFile*       pFile = nullptr;
+    if (result == VK_SUCCESS)
+    {
+        Util::EventCreateFlags flags = {};
+        flags.manualReset       = true;
+        flags.initiallySignaled = true;
 
-    Util::AllocCallbacks allocCbs = {
-        m_pInstance->GetAllocCallbacks(),
-        allocator::PalAllocFuncDelegator,
-        allocator::PalFreeFuncDelegator
-    };
+        result = PalToVkResult(m_drainedEvent.Init(flags));
+    }
 
-    Util::Strncpy(info.filePath, pFilePath, sizeof(info.filePath));
-    Util::Strncpy(info.fileName, pFileName, sizeof(info.fileName));
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(m_writerThread.Begin(AsyncWriterThreadFunc, this));
+    }
 
-    info.pMemoryCallbacks        = &allocCbs;
-    info.pPlatformKey            = m_pPlatformKey;
-    info.archiveType             = ArchiveType;
-    info.useStrictVersionControl = true;
-    info.allowWriteAccess        = false;
-    info.allowCreateFile         = false;
-    info.allowAsyncFileIo        = true;
-    info.useBufferedReadMemory   = (bufferSize > 0);
-    info.maxReadBufferMem        = bufferSize;
+    if (result != VK_SUCCESS)
+    {
+        DestroyAsyncWriter();
+    }
 
-    size_t memSize = Util::GetArchiveFileObjectSize(&info);
-    void*  pMem    = m_pInstance->AllocMem(memSize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+    return result;
+}
 
-    if (pMem != nullptr)
+// =====================================================================================================================
+// Stop the background writer after it has written all queued binaries
+void PipelineBinaryCache::DestroyAsyncWriter()
+{
+    if (m_writerThread.IsCreated())
     {
-        Util::Result openResult = Util::OpenArchiveFile(&info, pMem, &pFile);
+        m_stopWriter = true;
+        m_pendingEvent.Set();
+        m_writerThread.Join();
+    }
 
-        if (openResult == Util::Result::Success)
-        {
-            if (info.useBufferedReadMemory)
-            {
-                pFile->Preload(0, info.maxReadBufferMem);
-            }
-        }
-        else
+    if (m_pPendingStores != nullptr)
+    {
+        // Only reachable with queued stores if the thread failed to start
+        for (uint32_t i = 0; i < m_pendingCount; ++i)
         {
-            m_pInstance->FreeMem(pMem);
-            pFile = nullptr;
+            m_pInstance->FreeMem(m_pPendingStores[(m_pendingHead + i) % m_pendingCapacity].pData);
         }
+
+        m_pInstance->FreeMem(m_pPendingStores);
+
+        m_pPendingStores  = nullptr;
+        m_pendingCapacity = 0;
+        m_pendingHead     = 0;
+        m_pendingCount    = 0;
     }
+}
 
-    return pFile;
+// =====================================================================================================================
+void PipelineBinaryCache::AsyncWriterThreadFunc(
+    void* pParam)
+{
+    static_cast<PipelineBinaryCache*>(pParam)->AsyncWriterLoop();
 }
 
 // =====================================================================================================================
-// Open an archive file from disk for read + write
-Util::IArchiveFile* PipelineBinaryCache::OpenWritableArchive(
-    const char* pFilePath,
-    const char* pFileName,
-    size_t      bufferSize)
+// Writer thread main loop.  Each wake-up drains the whole queue in one batch.  A store stays in the queue until it has
+// been written, so loads never observe a gap between the queue and the cache layers.
+void PipelineBinaryCache::AsyncWriterLoop()
 {
-    VK_ASSERT(pFilePath != nullptr);
-    VK_ASSERT(pFileName != nullptr);
+    bool stop = false;
 
-    Util::ArchiveFileOpenInfo info  = {};
-    Util::IArchiveFile*       pFile = nullptr;
+    while (stop == false)
+    {
+        m_pendingEvent.Wait(Util::InfiniteTimeout);
 
-    Util::AllocCallbacks allocCbs = {
-        m_pInstance->GetAllocCallbacks(),
-        allocator::PalAllocFuncDelegator,
-        allocator::PalFreeFuncDelegator
-    };
+        // Sample the stop flag before draining, so that the last pass writes everything queued before destruction.
+        stop = m_stopWriter;
 
-    Util::Strncpy(info.filePath, pFilePath, sizeof(info.filePath));
-    Util::Strncpy(info.fileName, pFileName, sizeof(info.fileName));
+        bool hasStore = true;
 
-    info.pMemoryCallbacks        = &allocCbs;
-    info.pPlatformKey            = m_pPlatformKey;
-    info.archiveType             = ArchiveType;
-    info.useStrictVersionControl = true;
-    info.allowWriteAccess        = true;
-    info.allowCreateFile         = true;
-    info.allowAsyncFileIo        = true;
-    info.useBufferedReadMemory   = (bufferSize > 0);
-    info.maxReadBufferMem        = bufferSize;
+        while (hasStore)
+        {
+            PendingStore store = {};
 
-    size_t memSize = Util::GetArchiveFileObjectSize(&info);
-    void*  pMem    = m_pInstance->AllocMem(memSize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+            {
+                Util::MutexAuto lock(&m_pendingLock);
 
-    if (pMem != nullptr)
-    {
-        Util::Result openResult = Util::OpenArchiveFile(&info, pMem, &pFile);
+                hasStore = (m_pendingCount > 0);
 
-        if (openResult == Util::Result::ErrorIncompatibleLibrary)
-        {
-            if (Util::DeleteArchiveFile(&info)  == Util::Result::Success)
-            {
-                openResult = Util::OpenArchiveFile(&info, pMem, &pFile);
+                if (hasStore)
+                {
+                    store = m_pPendingStores[m_pendingHead];
+                }
             }
-        }
 
-        if (openResult == Util::Result::Success)
-        {
-            if (info.useBufferedReadMemory)
+            if (hasStore)
             {
-                pFile->Preload(0, info.maxReadBufferMem);
+                Util::Result result = StoreToLayers(&store.cacheId, store.dataSize, store.pData);
+
+                VK_ASSERT(Util::IsErrorResult(result) == false);
+
+                {
+                    Util::MutexAuto lock(&m_pendingLock);
+
+                    m_pendingHead = (m_pendingHead + 1) % m_pendingCapacity;
+                    m_pendingCount--;
+
+                    if (m_pendingCount == 0)
+                    {
+                        m_drainedEvent.Set();
+                    }
+                }
+
+                m_pInstance->FreeMem(store.pData);
             }
         }
-        else
-        {
-            m_pInstance->FreeMem(pMem);
-            pFile = nullptr;
-        }
     }
-
-    return pFile;
 }
 
+#if ICD_GPUOPEN_DEVMODE_BUILD
 // =====================================================================================================================
-// Create a cache layer from an open file
-Util::ICacheLayer* PipelineBinaryCache::CreateFileLayer(
-    Util::IArchiveFile* pFile)
+// Introduces a mapping from an internal pipeline hash to a cache ID
+void PipelineBinaryCache::RegisterHashMapping(
+    const Pal::PipelineHash* pInternalPipelineHash,
+    const CacheId*           pCacheId)
 {
-    VK_ASSERT(pFile != nullptr);
-    Util::ArchiveFileCacheCreateInfo info   = {};
-    Util::ICacheLayer*               pLayer = nullptr;
+    VK_ASSERT(pInternalPipelineHash != nullptr);
+    VK_ASSERT(pCacheId              != nullptr);
 
-    Util::AllocCallbacks allocCbs = {
-        m_pInstance->GetAllocCallbacks(),
-        allocator::PalAllocFuncDelegator,
-        allocator::PalFreeFuncDelegator
-    };
+    if (m_pReinjectionLayer != nullptr)
+    {
+        Util::RWLockAuto<Util::RWLock::LockType::ReadWrite> readWriteLock(&m_hashMappingLock);
 
-    info.baseInfo.pCallbacks = &allocCbs;
-    info.pFile               = pFile;
-    info.pPlatformKey        = m_pPlatformKey;
-    info.dataTypeId          = ElfType;
+        m_hashMapping.Insert(*pInternalPipelineHash, *pCacheId);
+    }
+}
 
-    size_t memSize = Util::GetArchiveFileCacheLayerSize(&info);
-    void*  pMem    = m_pInstance->AllocMem(memSize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+// =====================================================================================================================
+// Retrieves the cache ID that maps to the given internal pipeline hash, pCacheId is unchanged if no mapping found
+PipelineBinaryCache::CacheId* PipelineBinaryCache::GetCacheIdForPipeline(
+    const Pal::PipelineHash* pInternalPipelineHash)
+{
+    VK_ASSERT(pInternalPipelineHash != nullptr);
 
-    if (pMem != nullptr)
+    CacheId* pCacheId = nullptr;
+
+    if (m_pReinjectionLayer != nullptr)
     {
-        if (Util::CreateArchiveFileCacheLayer(&info, pMem, &pLayer) != Util::Result::Success)
-        {
-            m_pInstance->FreeMem(pMem);
-            pLayer = nullptr;
-        }
+        Util::RWLockAuto<Util::RWLock::LockType::ReadOnly> readWriteLock(&m_hashMappingLock);
+
+        pCacheId = m_hashMapping.FindKey(*pInternalPipelineHash);
     }
 
-    return pLayer;
+    return pCacheId;
 }
 
 // =====================================================================================================================
-// Open the archive file and initialize its cache layer
-VkResult PipelineBinaryCache::InitArchiveLayers(
-    const PhysicalDevice*  pPhysicalDevice,
-    const RuntimeSettings& settings)
+// Attempt to load a binary from the reinjection cache layer
+Util::Result PipelineBinaryCache::LoadReinjectionBinary(
+    const CacheId* pInternalPipelineHash,
+    size_t*        pPipelineBinarySize,
+    const void**   ppPipelineBinary)
 {
-    VkResult result = VK_SUCCESS;
-
-    // Buffer to hold constructed path
-    char pathBuffer[_MAX_FNAME] = {};
-    // If the environment variable AMD_VK_PIPELINE_CACHE_PATH is set, obey it first
-    const char* pCachePath = getenv(EnvVarPath);
+    Util::Result result = Util::Result::ErrorUnavailable;
 
-    // otherwise fetch the cache location from PAL
-    if (pCachePath == nullptr)
+    if (m_pReinjectionLayer != nullptr)
     {
-        // Default to a fail state here in case we cannot build the default path
-        result = VK_ERROR_INITIALIZATION_FAILED;
+        Util::QueryResult query = {};
+        result = m_pReinjectionLayer->Query(pInternalPipelineHash, &query);
 
-        if (settings.usePipelineCachingDefaultLocation)
+        if (result == Util::Result::Success)
         {
-            const char* pCacheSubPath = settings.pipelineCachingDefaultLocation;
-            const char* pUserDataPath = pPhysicalDevice->PalDevice()->GetCacheFilePath();
+            void* pOutputMem = m_pInstance->AllocMem(
+                query.dataSize,
+                VK_DEFAULT_MEM_ALIGN,
+                VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
 
-            if ((pCacheSubPath != nullptr) &&
-                (pUserDataPath != nullptr))
+            if (pOutputMem != nullptr)
             {
-                // Construct the path in the local buffer. Consider it valid if not empty
-                if (Util::Snprintf(pathBuffer, _MAX_FNAME, "%s%s", pUserDataPath, pCacheSubPath) > 0)
+                result = m_pReinjectionLayer->Load(&query, pOutputMem);
+
+                if (result == Util::Result::Success)
                 {
-                    pCachePath = pathBuffer;
-                    result = VK_SUCCESS;
+                    *pPipelineBinarySize = query.dataSize;
+                    *ppPipelineBinary = pOutputMem;
+                }
+                else
+                {
+                    m_pInstance->FreeMem(pOutputMem);
                 }
             }
         }
     }
 
-    // Load the primary archive file
-    if (result == VK_SUCCESS)
+    return result;
+}
+
+// =====================================================================================================================
+// Attempt to store a binary into the reinjection cache layer
+Util::Result PipelineBinaryCache::StoreReinjectionBinary(
+    const CacheId*  pInternalPipelineHash,
+    size_t          pipelineBinarySize,
+    const void*     pPipelineBinary)
+{
+    Util::Result result = Util::Result::ErrorUnavailable;
+
+    if (m_pReinjectionLayer != nullptr)
     {
-        // Assume that the first layer we open should be the "primary" source and optimize its memory access
-        constexpr size_t PrimayrLayerBufferSize   = 64 * 1024 * 1024;
-        constexpr size_t SecondaryLayerBufferSize = 8 * 1024 * 1024;
+        uint32_t gfxIpMajor = 0u;
+        uint32_t gfxIpMinor = 0u;
+        uint32_t gfxIpStepping = 0u;
 
-        // Open the optional read only cache file. This may fail gracefully
-        const char* const  pThirdPartyFileName = getenv(EnvVarReadOnlyFileName);
-        Util::ICacheLayer* pThirdPartyLayer    = nullptr;
+        Util::Abi::PipelineAbiProcessor<PalAllocator> processor(m_pInstance->Allocator());
+        result = processor.LoadFromBuffer(pPipelineBinary, pipelineBinarySize);
 
-        if (pThirdPartyFileName != nullptr)
+        if (result == Util::Result::Success)
         {
-            Util::IArchiveFile* pFile = OpenReadOnlyArchive(pCachePath, pThirdPartyFileName, PrimayrLayerBufferSize);
+            processor.GetGfxIpVersion(&gfxIpMajor, &gfxIpMinor, &gfxIpStepping);
 
-            if (pFile != nullptr)
+            if (gfxIpMajor == m_gfxIp.major &&
+                gfxIpMinor == m_gfxIp.minor &&
+                gfxIpStepping == m_gfxIp.stepping)
             {
-                Util::ICacheLayer* pLayer = CreateFileLayer(pFile);
-
-                if (pLayer != nullptr)
-                {
-                    m_openFiles.PushBack(pFile);
-                    m_archiveLayers.PushBack(pLayer);
-
+                result = m_pReinjectionLayer->Store(pInternalPipelineHash, pPipelineBinary, pipelineBinarySize);
+            }
+            else
+            {
+                result = Util::Result::ErrorIncompatibleDevice;
+            }
+        }
+    }
+
+    return result;
+}
+
+#endif
+// =====================================================================================================================
+// Free memory allocated by our allocator
+void PipelineBinaryCache::FreePipelineBinary(
+    const void* pPipelineBinary)
+{
+    if (pPipelineBinary != nullptr)
+    {
+        m_pInstance->FreeMem(const_cast<void*>(pPipelineBinary));
+    }
+}
+
+// =====================================================================================================================
+// Build the cache layer chain
+VkResult PipelineBinaryCache::Initialize(
+    const PhysicalDevice* pPhysicalDevice)
+{
+    VkResult result = VK_SUCCESS;
+
+    const RuntimeSettings& settings = pPhysicalDevice->GetRuntimeSettings();
+
+    if (result == VK_SUCCESS)
+    {
+        m_pPlatformKey    = pPhysicalDevice->GetPlatformKey();
+        m_compressEntries = settings.pipelineCacheCompression;
+    }
+
+    if (m_pPlatformKey == nullptr)
+    {
+        result = VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        result = InitLayers(pPhysicalDevice, m_isInternalCache, settings);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        result = OrderLayers(settings);
+    }
+
+    // Only application caches are serialized
+    if ((result == VK_SUCCESS) && (m_isInternalCache == false))
+    {
+        result = PalToVkResult(m_dirtyLock.Init());
+
+        if (result == VK_SUCCESS)
+        {
+            result = PalToVkResult(m_serializeLock.Init());
+        }
+    }
+
+    // Only archive layers do file I/O on store, so memory-only caches keep storing synchronously. The writer is an
+    // optimization and its failure is not fatal.
+    if ((result == VK_SUCCESS) &&
+        (m_pArchiveLayer != nullptr) &&
+        (settings.pipelineCacheAsyncWriteQueueSize > 0))
+    {
+        const VkResult writerResult = InitAsyncWriter(settings);
+
+        VK_ALERT(writerResult != VK_SUCCESS);
+    }
+
+#if ICD_GPUOPEN_DEVMODE_BUILD
+    if ((result == VK_SUCCESS) &&
+        (m_pReinjectionLayer != nullptr))
+    {
+        Util::Result palResult = m_pInstance->GetDevModeMgr()->RegisterPipelineCache(
+            this,
+            settings.devModePipelineUriServicePostSizeLimit);
+
+        if (palResult == Util::Result::Success)
+        {
+            palResult = m_hashMapping.Init();
+        }
+
+        if (palResult == Util::Result::Success)
+        {
+            palResult = m_hashMappingLock.Init();
+        }
+
+        if (palResult != Util::Result::Success)
+        {
+            m_pReinjectionLayer->Destroy();
+            m_pReinjectionLayer = nullptr;
+
+            // Fail silently so that the pipeline cache may still be used for other purposes.
+            PAL_ASSERT_ALWAYS();
+        }
+    }
+#endif
+
+    return result;
+}
+
+#if ICD_GPUOPEN_DEVMODE_BUILD
+// =====================================================================================================================
+// Initialize reinjection cache layer
+VkResult PipelineBinaryCache::InitReinjectionLayer(
+    const RuntimeSettings& settings)
+{
+    VkResult result = VK_ERROR_FEATURE_NOT_PRESENT;
+
+    if (m_pInstance->GetDevModeMgr() != nullptr)
+    {
+        Util::MemoryCacheCreateInfo info = {};
+        Util::AllocCallbacks        allocCbs = {
+            m_pInstance->GetAllocCallbacks(),
+            allocator::PalAllocFuncDelegator,
+            allocator::PalFreeFuncDelegator
+        };
+
+        info.baseInfo.pCallbacks = &allocCbs;
+        info.maxObjectCount = SIZE_MAX;
+        info.maxMemorySize = SIZE_MAX;
+        info.evictOnFull = false;
+        info.evictDuplicates = true;
+
+        size_t memSize = Util::GetMemoryCacheLayerSize(&info);
+        void*  pMem    = m_pInstance->AllocMem(memSize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+        if (pMem == nullptr)
+        {
+            result = VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+        else
+        {
+            result = PalToVkResult(
+                Util::CreateMemoryCacheLayer(
+                    &info,
+                    pMem,
+                    &m_pReinjectionLayer));
+
+            if (result != VK_SUCCESS)
+            {
+                m_pInstance->FreeMem(pMem);
+            }
+        }
+
+        if (result == VK_SUCCESS)
+        {
+            result = PalToVkResult(InjectBinariesFromDirectory(settings));
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Helper function for converting a 32-digit hexadecimal (in C string format) to a Hash128 object
+Util::Hash128 ParseHash128(const char* str)
+{
+    Util::Hash128   hash;
+    const uint32_t  stride = 2u; // 1 byte = 2 hex digits
+    const uint32_t  byteCount = (sizeof(hash.bytes) / sizeof(*hash.bytes));
+    uint32_t        stringIndex = 0u;
+    char            buffer[stride + 1u];
+    buffer[stride] = '\n';
+
+    // Using little-endian byte order
+    for (uint32_t byteIndex = 0u; byteIndex < byteCount; byteIndex++)
+    {
+        stringIndex = (byteCount - byteIndex - 1) * stride;
+        memcpy(buffer, &str[stringIndex], stride);
+        hash.bytes[byteIndex] = static_cast<uint8_t>(strtoul(buffer, nullptr, 16));
+    }
+
+    return hash;
+}
+
+// =====================================================================================================================
+// Adds binaries to reinjection cache layer from a directory source
+Util::Result PipelineBinaryCache::InjectBinariesFromDirectory(
+    const RuntimeSettings& settings)
+{
+    Util::Result result = Util::Result::Success;
+
+    if (settings.devModeElfReplacementDirectoryEnable)
+    {
+        Util::File      file;
+        char            filePath[260]; // Windows MAX_PATH = 260
+        uint32_t        fileCount           = 0u;
+        const char**    ppFileNames         = nullptr;
+        size_t          fileNameBufferSize  = 0u;
+        void*           pFileNameBuffer     = nullptr;
+        size_t          dirLength           = strlen(settings.devModeElfReplacementDirectory) + 1u;
+
+        Util::Hash128   pipelineHash        = {};
+        size_t          pipelineBinarySize  = 0u;
+        void*           pPipelineBinary     = nullptr;
+
+        // Get the number of files in dir and the size of the buffer to hold their names
+        result = Util::ListDir(
+            settings.devModeElfReplacementDirectory,
+            &fileCount,
+            nullptr,
+            &fileNameBufferSize,
+            nullptr);
+
+        if (fileCount == 0u)
+        {
+            return result;
+        }
+
+        if (result == Util::Result::Success)
+        {
+            // Allocate space for ppFileNames and pFileNameBuffer
+            ppFileNames = (const char**)m_pInstance->AllocMem(
+                (sizeof(const char*) * fileCount),
+                VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+            pFileNameBuffer = m_pInstance->AllocMem(
+                fileNameBufferSize,
+                VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+            // Populate ppFileNames and pFileNameBuffer
+            result = Util::ListDir(
+                settings.devModeElfReplacementDirectory,
+                &fileCount,
+                ppFileNames,
+                &fileNameBufferSize,
+                pFileNameBuffer);
+
+            if (result != Util::Result::Success)
+            {
+                m_pInstance->FreeMem(pFileNameBuffer);
+                m_pInstance->FreeMem(ppFileNames);
+            }
+        }
+
+        if (result == Util::Result::Success)
+        {
+            // Store each file into cache
+            strcpy(filePath, settings.devModeElfReplacementDirectory);
+            strcat(filePath, "\\");
+            for (uint32_t fileIndex = 0; fileIndex < fileCount; fileIndex++)
+            {
+                filePath[dirLength] = '\0';
+                strcat(filePath, ppFileNames[fileIndex]);
+
+                ppFileNames[fileIndex] = strstr(ppFileNames[fileIndex], "_0x");
+
+                if ((ppFileNames[fileIndex] != nullptr) &&
+                    (strlen(ppFileNames[fileIndex]) >= 32))
+                {
+                    ppFileNames[fileIndex] += 3u;
+                    pipelineHash = ParseHash128(ppFileNames[fileIndex]);
+
+                    if (Util::File::Exists(filePath))
+                    {
+                        pipelineBinarySize = Util::File::GetFileSize(filePath);
+                        pPipelineBinary = m_pInstance->AllocMem(pipelineBinarySize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+                        if (pPipelineBinary != nullptr)
+                        {
+                            if (file.Open(
+                                filePath,
+                                Util::FileAccessRead | Util::FileAccessBinary) == Util::Result::Success)
+                            {
+                                if (file.Read(pPipelineBinary, pipelineBinarySize, nullptr) == Util::Result::Success)
+                                {
+                                    StoreReinjectionBinary(&pipelineHash, pipelineBinarySize, pPipelineBinary);
+                                }
+                                else
+                                {
+                                    VK_NEVER_CALLED();
+                                }
+
+                                file.Close();
+                            }
+                            else
+                            {
+                                VK_NEVER_CALLED();
+                            }
+                        }
+
+                        m_pInstance->FreeMem(pPipelineBinary);
+                    }
+                    else
+                    {
+                        VK_NEVER_CALLED();
+                    }
+                }
+            }
+
+            m_pInstance->FreeMem(pFileNameBuffer);
+            m_pInstance->FreeMem(ppFileNames);
+        }
+    }
+
+    return result;
+}
+#endif
+
+// =====================================================================================================================
+// Initialize memory layer
+VkResult PipelineBinaryCache::InitMemoryCacheLayer(
+    const RuntimeSettings& settings)
+{
+    VK_ASSERT(m_pMemoryLayer == nullptr);
+
+    Util::AllocCallbacks allocCallbacks = {};
+    allocCallbacks.pClientData = m_pInstance->GetAllocCallbacks();
+    allocCallbacks.pfnAlloc    = allocator::PalAllocFuncDelegator;
+    allocCallbacks.pfnFree     = allocator::PalFreeFuncDelegator;
+
+    Util::MemoryCacheCreateInfo createInfo = {};
+    createInfo.baseInfo.pCallbacks = &allocCallbacks;
+    createInfo.maxObjectCount      = SIZE_MAX;
+    createInfo.maxMemorySize       = SIZE_MAX;
+    createInfo.evictOnFull         = true;
+    createInfo.evictDuplicates     = true;
+
+    // Only the memory layer of an internal cache backed by an archive layer is bounded, since binaries evicted from
+    // it can still be found in the archive layer.  Without one, or in an application's VkPipelineCache which would
+    // silently lose them from vkGetPipelineCacheData, evicted binaries would be lost.
+    const bool bounded = m_isInternalCache &&
+                         (m_pArchiveLayer != nullptr) &&
+                         (settings.pipelineCacheMemoryLayerMaxSize > 0);
+
+    if (bounded)
+    {
+        createInfo.maxMemorySize = static_cast<size_t>(Util::Min(settings.pipelineCacheMemoryLayerMaxSize,
+                                                                 static_cast<uint64_t>(SIZE_MAX)));
+    }
+
+    size_t layerSize = Util::GetMemoryCacheLayerSize(&createInfo);
+    void*  pMem      = m_pInstance->AllocMem(layerSize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+    VkResult result = VK_SUCCESS;
+
+    if (pMem == nullptr)
+    {
+        result = VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    else
+    {
+        result = PalToVkResult(CreateMemoryCacheLayer(&createInfo, pMem, &m_pMemoryLayer));
+        VK_ASSERT(result == VK_SUCCESS);
+
+        if (result != VK_SUCCESS)
+        {
+            m_pInstance->FreeMem(pMem);
+        }
+    }
+
+    if ((result == VK_SUCCESS) && bounded)
+    {
+        result = PalToVkResult(m_boundedStoreLock.Init());
+
+        m_memoryLayerBounded = (result == VK_SUCCESS);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Open an archive file from disk for read
+Util::IArchiveFile* PipelineBinaryCache::OpenReadOnlyArchive(
+    const char* pFilePath,
+    const char* pFileName,
+    size_t      bufferSize)
+{
+    VK_ASSERT(pFilePath != nullptr);
+    VK_ASSERT(pFileName != nullptr);
+
+    Util::ArchiveFileOpenInfo info  = {};
+    Util::IArchiveFile*       pFile = nullptr;
+
+    Util::AllocCallbacks allocCbs = {
+        m_pInstance->GetAllocCallbacks(),
+        allocator::PalAllocFuncDelegator,
+        allocator::PalFreeFuncDelegator
+    };
+
+    Util::Strncpy(info.filePath, pFilePath, sizeof(info.filePath));
+    Util::Strncpy(info.fileName, pFileName, sizeof(info.fileName));
+
+    info.pMemoryCallbacks        = &allocCbs;
+    info.pPlatformKey            = m_pPlatformKey;
+    info.archiveType             = ArchiveType;
+    info.useStrictVersionControl = true;
+    info.allowWriteAccess        = false;
+    info.allowCreateFile         = false;
+    info.allowAsyncFileIo        = true;
+    info.useBufferedReadMemory   = (bufferSize > 0);
+    info.maxReadBufferMem        = bufferSize;
+
+    size_t memSize = Util::GetArchiveFileObjectSize(&info);
+    void*  pMem    = m_pInstance->AllocMem(memSize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+    if (pMem != nullptr)
+    {
+        Util::Result openResult = Util::OpenArchiveFile(&info, pMem, &pFile);
+
+        if (openResult == Util::Result::Success)
+        {
+            if (info.useBufferedReadMemory)
+            {
+                pFile->Preload(0, info.maxReadBufferMem);
+            }
+        }
+        else
+        {
+            m_pInstance->FreeMem(pMem);
+            pFile = nullptr;
+        }
+    }
+
+    return pFile;
+}
+
+// =====================================================================================================================
+// Open an archive file from disk for read + write
+Util::IArchiveFile* PipelineBinaryCache::OpenWritableArchive(
+    const char* pFilePath,
+    const char* pFileName,
+    size_t      bufferSize)
+{
+    VK_ASSERT(pFilePath != nullptr);
+    VK_ASSERT(pFileName != nullptr);
+
+    Util::ArchiveFileOpenInfo info  = {};
+    Util::IArchiveFile*       pFile = nullptr;
+
+    Util::AllocCallbacks allocCbs = {
+        m_pInstance->GetAllocCallbacks(),
+        allocator::PalAllocFuncDelegator,
+        allocator::PalFreeFuncDelegator
+    };
+
+    Util::Strncpy(info.filePath, pFilePath, sizeof(info.filePath));
+    Util::Strncpy(info.fileName, pFileName, sizeof(info.fileName));
+
+    info.pMemoryCallbacks        = &allocCbs;
+    info.pPlatformKey            = m_pPlatformKey;
+    info.archiveType             = ArchiveType;
+    info.useStrictVersionControl = true;
+    info.allowWriteAccess        = true;
+    info.allowCreateFile         = true;
+    info.allowAsyncFileIo        = true;
+    info.useBufferedReadMemory   = (bufferSize > 0);
+    info.maxReadBufferMem        = bufferSize;
+
+    size_t memSize = Util::GetArchiveFileObjectSize(&info);
+    void*  pMem    = m_pInstance->AllocMem(memSize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+    if (pMem != nullptr)
+    {
+        Util::Result openResult = Util::OpenArchiveFile(&info, pMem, &pFile);
+
+        if (openResult == Util::Result::ErrorIncompatibleLibrary)
+        {
+            if (Util::DeleteArchiveFile(&info)  == Util::Result::Success)
+            {
+                openResult = Util::OpenArchiveFile(&info, pMem, &pFile);
+            }
+        }
+
+        if (openResult == Util::Result::Success)
+        {
+            if (info.useBufferedReadMemory)
+            {
+                pFile->Preload(0, info.maxReadBufferMem);
+            }
+        }
+        else
+        {
+            m_pInstance->FreeMem(pMem);
+            pFile = nullptr;
+        }
+    }
+
+    return pFile;
+}
+
+// =====================================================================================================================
+// Create a cache layer from an open file
+Util::ICacheLayer* PipelineBinaryCache::CreateFileLayer(
+    Util::IArchiveFile* pFile)
+{
+    VK_ASSERT(pFile != nullptr);
+    Util::ArchiveFileCacheCreateInfo info   = {};
+    Util::ICacheLayer*               pLayer = nullptr;
+
+    Util::AllocCallbacks allocCbs = {
+        m_pInstance->GetAllocCallbacks(),
+        allocator::PalAllocFuncDelegator,
+        allocator::PalFreeFuncDelegator
+    };
+
+    info.baseInfo.pCallbacks = &allocCbs;
+    info.pFile               = pFile;
+    info.pPlatformKey        = m_pPlatformKey;
+    info.dataTypeId          = ElfType;
+
+    size_t memSize = Util::GetArchiveFileCacheLayerSize(&info);
+    void*  pMem    = m_pInstance->AllocMem(memSize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+    if (pMem != nullptr)
+    {
+        if (Util::CreateArchiveFileCacheLayer(&info, pMem, &pLayer) != Util::Result::Success)
+        {
+            m_pInstance->FreeMem(pMem);
+            pLayer = nullptr;
+        }
+    }
+
+    return pLayer;
+}
+
+// =====================================================================================================================
+// Map a read-only blob in the format returned by vkGetPipelineCacheData().  Only its header is validated here; entries
+// are indexed and validated as they are looked up, see FindMappedEntry() and LoadMappedPipelineBinary().
+VkResult PipelineBinaryCache::InitMappedBlob(
+    const PhysicalDevice* pPhysicalDevice,
+    const char*           pFilePath,
+    const char*           pFileName)
+{
+    VK_ASSERT(m_pMappedBlob == nullptr);
+
+    // Memory-mapping is only implemented for POSIX platforms
+    VkResult result = VK_ERROR_FEATURE_NOT_PRESENT;
+
+#if defined(__unix__)
+    char fullPath[PATH_MAX] = {};
+    Util::Snprintf(fullPath, sizeof(fullPath), "%s/%s", pFilePath, pFileName);
+
+    const int fd = open(fullPath, O_RDONLY | O_CLOEXEC);
+
+    result = VK_ERROR_INITIALIZATION_FAILED;
+
+    if (fd >= 0)
+    {
+        struct stat fileStat = {};
+
+        if ((fstat(fd, &fileStat) == 0) &&
+            (static_cast<size_t>(fileStat.st_size) >
+             (sizeof(PipelineCacheHeaderData) + sizeof(PipelineBinaryCachePrivateHeader))))
+        {
+            void* pMapping = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+            if (pMapping != MAP_FAILED)
+            {
+                m_pMappedBlob    = pMapping;
+                m_mappedBlobSize = fileStat.st_size;
+                result           = VK_SUCCESS;
+            }
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        close(fd);
+    }
+#endif
+
+    if (result == VK_SUCCESS)
+    {
+        const PipelineCacheHeaderData* pHeader  = static_cast<const PipelineCacheHeaderData*>(m_pMappedBlob);
+        const Pal::DeviceProperties&   palProps = pPhysicalDevice->PalProperties();
+        VkPhysicalDeviceProperties     physicalDeviceProps = {};
+
+        pPhysicalDevice->GetDeviceProperties(&physicalDeviceProps);
+
+        if ((pHeader->headerLength  != sizeof(PipelineCacheHeaderData))       ||
+            (pHeader->headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) ||
+            (pHeader->vendorID      != palProps.vendorId)                     ||
+            (pHeader->deviceID      != palProps.deviceId)                     ||
+            (memcmp(pHeader->UUID, physicalDeviceProps.pipelineCacheUUID, sizeof(pHeader->UUID)) != 0))
+        {
+            result = VK_ERROR_INCOMPATIBLE_DRIVER;
+        }
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(m_mappedEntries.Init());
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(m_mappedLock.Init());
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        m_mappedScanOffset = sizeof(PipelineBinaryCachePrivateHeader);
+    }
+    else
+    {
+        UnmapBlob();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Release the memory-mapped blob, if any
+void PipelineBinaryCache::UnmapBlob()
+{
+#if defined(__unix__)
+    if (m_pMappedBlob != nullptr)
+    {
+        munmap(const_cast<void*>(m_pMappedBlob), m_mappedBlobSize);
+    }
+#endif
+
+    m_pMappedBlob    = nullptr;
+    m_mappedBlobSize = 0;
+}
+
+// =====================================================================================================================
+// Open the archive file and initialize its cache layer
+VkResult PipelineBinaryCache::InitArchiveLayers(
+    const PhysicalDevice*  pPhysicalDevice,
+    const RuntimeSettings& settings)
+{
+    VkResult result = VK_SUCCESS;
+
+    // Buffer to hold constructed path
+    char pathBuffer[_MAX_FNAME] = {};
+    // If the environment variable AMD_VK_PIPELINE_CACHE_PATH is set, obey it first
+    const char* pCachePath = getenv(EnvVarPath);
+
+    // otherwise fetch the cache location from PAL
+    if (pCachePath == nullptr)
+    {
+        // Default to a fail state here in case we cannot build the default path
+        result = VK_ERROR_INITIALIZATION_FAILED;
+
+        if (settings.usePipelineCachingDefaultLocation)
+        {
+            const char* pCacheSubPath = settings.pipelineCachingDefaultLocation;
+            const char* pUserDataPath = pPhysicalDevice->PalDevice()->GetCacheFilePath();
+
+            if ((pCacheSubPath != nullptr) &&
+                (pUserDataPath != nullptr))
+            {
+                // Construct the path in the local buffer. Consider it valid if not empty
+                if (Util::Snprintf(pathBuffer, _MAX_FNAME, "%s%s", pUserDataPath, pCacheSubPath) > 0)
+                {
+                    pCachePath = pathBuffer;
+                    result = VK_SUCCESS;
+                }
+            }
+        }
+    }
+
+    // Load the primary archive file
+    if (result == VK_SUCCESS)
+    {
+        // Assume that the first layer we open should be the "primary" source and optimize its memory access
+        constexpr size_t PrimayrLayerBufferSize   = 64 * 1024 * 1024;
+        constexpr size_t SecondaryLayerBufferSize = 8 * 1024 * 1024;
+
+        // Open the optional read only cache file. This may fail gracefully
+        const char* const  pThirdPartyFileName = getenv(EnvVarReadOnlyFileName);
+        Util::ICacheLayer* pThirdPartyLayer    = nullptr;
+
+        if (pThirdPartyFileName != nullptr)
+        {
+            Util::IArchiveFile* pFile = OpenReadOnlyArchive(pCachePath, pThirdPartyFileName, PrimayrLayerBufferSize);
+
+            if (pFile != nullptr)
+            {
+                Util::ICacheLayer* pLayer = CreateFileLayer(pFile);
+
+                if (pLayer != nullptr)
+                {
+                    m_openFiles.PushBack(pFile);
+                    m_archiveLayers.PushBack(pLayer);
+
                     pThirdPartyLayer = pLayer;
 
-                    // If third party layer is given to us, have it be the primary layer
-                    m_pArchiveLayer = pLayer;
+                    // If third party layer is given to us, have it be the primary layer
+                    m_pArchiveLayer = pLayer;
+                }
+                else
+                {
+                    pFile->Destroy();
+                    m_pInstance->FreeMem(pFile);
+                }
+            }
+        }
+
+        // Map the optional read-only cache blob. This may fail gracefully
+        const char* const pMappedFileName = getenv(EnvVarMappedFileName);
+
+        if (pMappedFileName != nullptr)
+        {
+            InitMappedBlob(pPhysicalDevice, pCachePath, pMappedFileName);
+        }
+
+        // Buffer to hold constructed filename
+        char nameBuffer[_MAX_FNAME] = {};
+
+        const char* const pCacheFileName = getenv(EnvVarFileName);
+
+        if (pCacheFileName == nullptr)
+        {
+            // If no naming scheme is given, compute the name by AppHash + PlatformKey
+            Util::Hash128 appHash        = {};
+            char*         pExecutablePtr = nullptr;
+
+            Util::Result palResult = Util::GetExecutableName(nameBuffer, &pExecutablePtr, sizeof(nameBuffer));
+            VK_ASSERT(IsErrorResult(palResult) == false);
+            Util::MetroHash128::Hash(reinterpret_cast<const uint8_t*>(nameBuffer), sizeof(nameBuffer), appHash.bytes);
+
+            Util::Snprintf(
+                nameBuffer,
+                sizeof(nameBuffer),
+                "%llX%llX",
+                Util::MetroHash::Compact64(&appHash),
+                m_pPlatformKey->GetKey64());
+        }
+        else
+        {
+            Util::Strncpy(nameBuffer, pCacheFileName, sizeof(nameBuffer));
+        }
+
+        Util::ICacheLayer* pWriteLayer    = nullptr;
+        Util::ICacheLayer* pLastReadLayer = pThirdPartyLayer;
+
+        char* const  nameEnd        = &nameBuffer[strnlen(nameBuffer, sizeof(nameBuffer))];
+        const size_t charsRemaining = sizeof(nameBuffer) - (nameEnd - nameBuffer);
+
+        constexpr int MaxAttempts = 10;
+        for (int attemptCt = 0; attemptCt < MaxAttempts; ++attemptCt)
+        {
+            size_t bufferSize = (m_pArchiveLayer == nullptr) ? PrimayrLayerBufferSize : SecondaryLayerBufferSize;
+
+            // Create the final name based off the attempt
+            *nameEnd = '\0';
+            if (attemptCt == 0)
+            {
+                Util::Strncat(nameBuffer, sizeof(nameBuffer), ".parc");
+            }
+            else
+            {
+                Util::Snprintf(nameEnd, charsRemaining, "_%d.parc", attemptCt);
+            }
+
+            Util::IArchiveFile* pFile    = OpenWritableArchive(pCachePath, nameBuffer, bufferSize);
+            bool                readOnly = false;
+
+            // Attempt to open the file as a read only instead if we failed
+            if (pFile == nullptr)
+            {
+                pFile    = OpenReadOnlyArchive(pCachePath, nameBuffer, bufferSize);
+                readOnly = true;
+            }
+
+            // Only create the layer if one of the two above calls successfully openned the file
+            if (pFile != nullptr)
+            {
+                Util::ICacheLayer* pLayer = CreateFileLayer(pFile);
+
+                if (pLayer != nullptr)
+                {
+                    m_openFiles.PushBack(pFile);
+                    m_archiveLayers.PushBack(pLayer);
+
+                    if (pLastReadLayer != nullptr)
+                    {
+                        pLastReadLayer->SetLoadPolicy(Util::ICacheLayer::LinkPolicy::PassCalls);
+                        pLastReadLayer->SetStorePolicy(Util::ICacheLayer::LinkPolicy::Skip | Util::ICacheLayer::LinkPolicy::PassData);
+                        // Connect to previous read layer as read-through / write-through + skip
+                        pLastReadLayer->Link(pLayer);
+                    }
+
+                    // Ensure the first read or write layer is set to "top" of the chain.
+                    if (m_pArchiveLayer == nullptr)
+                    {
+                        m_pArchiveLayer = pLayer;
+                    }
+
+                    if (readOnly)
+                    {
+                        pLastReadLayer = pLayer;
+                    }
+                    else
+                    {
+                        pWriteLayer = pLayer;
+                        break;
+                    }
                 }
                 else
                 {
@@ -976,306 +2029,692 @@ VkResult PipelineBinaryCache::InitArchiveLayers(
             }
         }
 
-        // Buffer to hold constructed filename
-        char nameBuffer[_MAX_FNAME] = {};
+        if (m_pArchiveLayer == nullptr)
+        {
+            result = VK_ERROR_INITIALIZATION_FAILED;
+        }
 
-        const char* const pCacheFileName = getenv(EnvVarFileName);
+        VK_ASSERT(pWriteLayer != nullptr);
+    }
 
-        if (pCacheFileName == nullptr)
+    return result;
+}
+
+// =====================================================================================================================
+// Initialize layers (a single layer that supports storage for binaries needs to succeed)
+VkResult PipelineBinaryCache::InitLayers(
+    const PhysicalDevice*  pPhysicalDevice,
+    bool                   internal,
+    const RuntimeSettings& settings)
+{
+    VkResult result = VK_ERROR_INITIALIZATION_FAILED;
+
+#if ICD_GPUOPEN_DEVMODE_BUILD
+    if ((InitReinjectionLayer(settings) == VK_SUCCESS))
+    {
+        result = VK_SUCCESS;
+    }
+#endif
+
+    // If cache handle is vkPipelineCache, we shouldn't store it to disk.  The archive layers are initialized first
+    // because the memory layer is only bounded if an archive layer backs it.
+    if (internal)
+    {
+        if (InitArchiveLayers(pPhysicalDevice, settings) == VK_SUCCESS)
         {
-            // If no naming scheme is given, compute the name by AppHash + PlatformKey
-            Util::Hash128 appHash        = {};
-            char*         pExecutablePtr = nullptr;
+            result = VK_SUCCESS;
+        }
+    }
 
-            Util::Result palResult = Util::GetExecutableName(nameBuffer, &pExecutablePtr, sizeof(nameBuffer));
-            VK_ASSERT(IsErrorResult(palResult) == false);
-            Util::MetroHash128::Hash(reinterpret_cast<const uint8_t*>(nameBuffer), sizeof(nameBuffer), appHash.bytes);
+    if (InitMemoryCacheLayer(settings) == VK_SUCCESS)
+    {
+        result = VK_SUCCESS;
+    }
 
-            Util::Snprintf(
-                nameBuffer,
-                sizeof(nameBuffer),
-                "%llX%llX",
-                Util::MetroHash::Compact64(&appHash),
-                m_pPlatformKey->GetKey64());
+    return result;
+}
+
+VkResult PipelineBinaryCache::AddLayerToChain(
+    Util::ICacheLayer*  pLayer,
+    Util::ICacheLayer** pBottomLayer)
+{
+    VkResult result = VK_SUCCESS;
+
+    if (pLayer != nullptr)
+    {
+        if (m_pTopLayer == nullptr)
+        {
+            m_pTopLayer = pLayer;
+            *pBottomLayer = pLayer;
         }
         else
         {
-            Util::Strncpy(nameBuffer, pCacheFileName, sizeof(nameBuffer));
+            if ((*pBottomLayer)->Link(pLayer) == Util::Result::Success)
+            {
+                *pBottomLayer = pLayer;
+            }
+            else
+            {
+                result = VK_ERROR_INITIALIZATION_FAILED;
+            }
         }
+    }
 
-        Util::ICacheLayer* pWriteLayer    = nullptr;
-        Util::ICacheLayer* pLastReadLayer = pThirdPartyLayer;
+    return result;
+}
+
+// =====================================================================================================================
+// Order the layers for desired caching behaviour
+VkResult PipelineBinaryCache::OrderLayers(
+    const RuntimeSettings& settings)
+{
+    VkResult result                 = VK_SUCCESS;
+    Util::ICacheLayer* pBottomLayer = nullptr;
+    m_pTopLayer                     = nullptr;
+
+    if (result == VK_SUCCESS)
+    {
+        result = AddLayerToChain(m_pMemoryLayer, &pBottomLayer);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        result = AddLayerToChain(m_pArchiveLayer, &pBottomLayer);
+    }
+
+    if ((result == VK_SUCCESS) &&
+        (m_pTopLayer == nullptr))
+    {
+        // The cache is not very useful if no layers are available.
+        result = VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Copies the pipeline cache data to the memory blob provided by the calling function.
+//
+// The serialized data, its layout (the cache IDs, sizes and offsets of the entries) and a running hash over it are kept
+// between calls.  Each call only loads and hashes the entries stored since the previous call, and then copies the
+// whole serialized data into the blob.  A size query loads the new entries as well, so that the following call only
+// has to copy them.
+//
+// NOTE: It is expected that the calling function has not used this pipeline cache since querying the size
+VkResult PipelineBinaryCache::Serialize(
+    void*              pBlob,       // [out] System memory pointer where the serialized data should be placed
+    size_t*            pSize,       // [in,out] Size of the memory pointed to by pBlob. If the value stored in pSize is
+                                    // zero then no data will be copied and instead the size required for
+                                    // serialization will be returned in pSize
+    CompileThreadPool* pThreadPool) // [in] Optional workers used to load the new entries
+{
+    VkResult result = VK_ERROR_INITIALIZATION_FAILED;
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 534
+    if (m_pMemoryLayer != nullptr)
+    {
+        Util::MutexAuto lock(&m_serializeLock);
+
+        result = UpdateSerializedEntries();
+
+        if (result == VK_SUCCESS)
+        {
+            result = WriteSerializedEntries(pThreadPool);
+        }
+
+        if (result == VK_SUCCESS)
+        {
+            result = FinishSerializedHash();
+        }
+
+        if (result == VK_SUCCESS)
+        {
+            if (*pSize == 0)
+            {
+                *pSize = m_serializedSize;
+            }
+            else if (*pSize >= m_serializedSize)
+            {
+                memcpy(pBlob, m_pSerializedData, m_serializedSize);
+
+                *pSize = m_serializedSize;
+            }
+            else if (*pSize >= sizeof(PipelineBinaryCachePrivateHeader))
+            {
+                // Only whole entries are copied, and the hash has to be computed over them from scratch
+                size_t   copySize   = sizeof(PipelineBinaryCachePrivateHeader);
+                uint32_t entryCount = 0;
+
+                while (entryCount < m_serializedEntries.NumElements())
+                {
+                    const SerializedCacheEntry& entry    = m_serializedEntries.At(entryCount);
+                    const size_t                entryEnd = GetEntryDataOffset(entry.offset) + entry.dataSize;
+
+                    if (entryEnd > *pSize)
+                    {
+                        break;
+                    }
+
+                    copySize = entryEnd;
+                    entryCount++;
+                }
+
+                auto pBinaryPrivateHeader = static_cast<PipelineBinaryCachePrivateHeader*>(pBlob);
+
+                memcpy(pBlob, m_pSerializedData, copySize);
+
+                *pSize = copySize;
+
+                result = PalToVkResult(CalculateHashId(
+                                            m_pInstance,
+                                            m_pPlatformKey,
+                                            Util::VoidPtrInc(pBlob, sizeof(PipelineBinaryCachePrivateHeader)),
+                                            copySize - sizeof(PipelineBinaryCachePrivateHeader),
+                                            pBinaryPrivateHeader->hashId));
+
+                if (result == VK_SUCCESS)
+                {
+                    result = VK_INCOMPLETE;
+                }
+            }
+            else
+            {
+                result = VK_ERROR_INITIALIZATION_FAILED;
+            }
+        }
+    }
+#endif
+    return result;
+}
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 534
+// =====================================================================================================================
+// Bring the serialized entry layout in sync with the memory layer, appending the entries stored since the last update.
+// The layout is rebuilt from scratch the first time and whenever the memory layer evicted or replaced entries, since
+// those cannot be removed incrementally.
+VkResult PipelineBinaryCache::UpdateSerializedEntries()
+{
+    VkResult result = VK_SUCCESS;
+
+    if (m_pSerializedHash != nullptr)
+    {
+        result = AppendSerializedEntries();
+    }
+
+    if (m_pSerializedHash != nullptr)
+    {
+        size_t curCount, curDataSize;
+
+        result = PalToVkResult(Util::GetMemoryCacheLayerCurSize(m_pMemoryLayer, &curCount, &curDataSize));
+
+        if ((result != VK_SUCCESS) || (curCount != m_serializedEntries.NumElements()))
+        {
+            ResetSerializedEntries();
+        }
+    }
+
+    if (m_pSerializedHash == nullptr)
+    {
+        result = RebuildSerializedEntries();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Add a serialized entry to the end of the layout
+VkResult PipelineBinaryCache::AddSerializedEntry(
+    const CacheId& cacheId,
+    size_t         dataSize)
+{
+    SerializedCacheEntry entry = {};
+
+    entry.cacheId  = cacheId;
+    entry.dataSize = dataSize;
+    entry.offset   = m_serializedSize;
+
+    VkResult result = PalToVkResult(m_serializedEntries.PushBack(entry));
+
+    if (result == VK_SUCCESS)
+    {
+        m_serializedSize = GetEntryDataOffset(entry.offset) + dataSize;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Append the entries stored since the last update to the serialized entry layout.  Their data is hashed by the next
+// call writing the whole blob.
+VkResult PipelineBinaryCache::AppendSerializedEntries()
+{
+    VK_ASSERT(m_pSerializedHash != nullptr);
+
+    // Stores wait while the new entries are appended, which keeps the work here proportional to the new entries
+    Util::MutexAuto lock(&m_dirtyLock);
+
+    VkResult result = VK_SUCCESS;
+
+    for (CacheIdVector::Iter i = m_dirtyEntries.Begin(); i.IsValid() && (result == VK_SUCCESS); i.Next())
+    {
+        Util::QueryResult query = {};
+
+        // Entries which are no longer resident are skipped; UpdateSerializedEntries() notices the count mismatch
+        if (m_pTopLayer->Query(&i.Get(), &query) == Util::Result::Success)
+        {
+            result = AddSerializedEntry(i.Get(), query.dataSize);
+        }
+    }
+
+    m_dirtyEntries.Clear();
+
+    if (result != VK_SUCCESS)
+    {
+        m_trackDirtyEntries = false;
+        ResetSerializedEntries();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Compute the serialized entry layout of every entry of the memory layer and start a new running hash.  Afterwards,
+// stores are recorded as dirty entries so that later updates only append them.
+VkResult PipelineBinaryCache::RebuildSerializedEntries()
+{
+    VK_ASSERT(m_pSerializedHash == nullptr);
+
+    const size_t contextSize = m_pPlatformKey->GetKeyContext()->GetDuplicateObjectSize();
+    size_t       curCount    = 0;
+    size_t       curDataSize = 0;
+
+    m_pSerializedHashMem = m_pInstance->AllocMem(contextSize, VK_DEFAULT_MEM_ALIGN, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+    VkResult result = (m_pSerializedHashMem != nullptr) ? VK_SUCCESS : VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(m_pPlatformKey->GetKeyContext()->Duplicate(m_pSerializedHashMem, &m_pSerializedHash));
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(Util::GetMemoryCacheLayerCurSize(m_pMemoryLayer, &curCount, &curDataSize));
+    }
 
-        char* const  nameEnd        = &nameBuffer[strnlen(nameBuffer, sizeof(nameBuffer))];
-        const size_t charsRemaining = sizeof(nameBuffer) - (nameEnd - nameBuffer);
+    if ((result == VK_SUCCESS) && (curCount > 0))
+    {
+        Util::AutoBuffer<Util::Hash128, 8, PalAllocator> cacheIds(curCount, m_pInstance->Allocator());
 
-        constexpr int MaxAttempts = 10;
-        for (int attemptCt = 0; attemptCt < MaxAttempts; ++attemptCt)
+        result = PalToVkResult(Util::GetMemoryCacheLayerHashIds(m_pMemoryLayer, curCount, &cacheIds[0]));
+
+        for (uint32_t i = 0; (i < curCount) && (result == VK_SUCCESS); ++i)
         {
-            size_t bufferSize = (m_pArchiveLayer == nullptr) ? PrimayrLayerBufferSize : SecondaryLayerBufferSize;
+            Util::QueryResult query = {};
 
-            // Create the final name based off the attempt
-            *nameEnd = '\0';
-            if (attemptCt == 0)
-            {
-                Util::Strncat(nameBuffer, sizeof(nameBuffer), ".parc");
-            }
-            else
+            result = PalToVkResult(m_pTopLayer->Query(&cacheIds[i], &query));
+
+            if (result == VK_SUCCESS)
             {
-                Util::Snprintf(nameEnd, charsRemaining, "_%d.parc", attemptCt);
+                result = AddSerializedEntry(cacheIds[i], query.dataSize);
             }
+        }
+    }
 
-            Util::IArchiveFile* pFile    = OpenWritableArchive(pCachePath, nameBuffer, bufferSize);
-            bool                readOnly = false;
+    if (result == VK_SUCCESS)
+    {
+        Util::MutexAuto lock(&m_dirtyLock);
 
-            // Attempt to open the file as a read only instead if we failed
-            if (pFile == nullptr)
-            {
-                pFile    = OpenReadOnlyArchive(pCachePath, nameBuffer, bufferSize);
-                readOnly = true;
-            }
+        m_dirtyEntries.Clear();
+        m_trackDirtyEntries = true;
+    }
+    else
+    {
+        ResetSerializedEntries();
+    }
 
-            // Only create the layer if one of the two above calls successfully openned the file
-            if (pFile != nullptr)
-            {
-                Util::ICacheLayer* pLayer = CreateFileLayer(pFile);
+    return result;
+}
 
-                if (pLayer != nullptr)
-                {
-                    m_openFiles.PushBack(pFile);
-                    m_archiveLayers.PushBack(pLayer);
+// =====================================================================================================================
+// Load one entry of the layout from the layer into the serialized data at its offset.  Fails if the entry is no longer
+// resident or its size no longer matches the layout.
+static bool LoadSerializedEntry(
+    Util::ICacheLayer*          pLayer,
+    const SerializedCacheEntry& entry,
+    void*                       pData)
+{
+    BinaryCacheEntry* pEntry  = static_cast<BinaryCacheEntry*>(Util::VoidPtrInc(pData, entry.offset));
+    const size_t      padSize = GetEntryDataOffset(entry.offset) - (entry.offset + sizeof(BinaryCacheEntry));
+    Util::QueryResult query   = {};
 
-                    if (pLastReadLayer != nullptr)
-                    {
-                        pLastReadLayer->SetLoadPolicy(Util::ICacheLayer::LinkPolicy::PassCalls);
-                        pLastReadLayer->SetStorePolicy(Util::ICacheLayer::LinkPolicy::Skip | Util::ICacheLayer::LinkPolicy::PassData);
-                        // Connect to previous read layer as read-through / write-through + skip
-                        pLastReadLayer->Link(pLayer);
-                    }
+    pEntry->hashId   = entry.cacheId;
+    pEntry->dataSize = entry.dataSize;
 
-                    // Ensure the first read or write layer is set to "top" of the chain.
-                    if (m_pArchiveLayer == nullptr)
-                    {
-                        m_pArchiveLayer = pLayer;
-                    }
+    // The padding is part of the hashed blob, so it has to be deterministic
+    memset(Util::VoidPtrInc(pEntry, sizeof(BinaryCacheEntry)), 0, padSize);
 
-                    if (readOnly)
-                    {
-                        pLastReadLayer = pLayer;
-                    }
-                    else
-                    {
-                        pWriteLayer = pLayer;
-                        break;
-                    }
-                }
-                else
-                {
-                    pFile->Destroy();
-                    m_pInstance->FreeMem(pFile);
-                }
-            }
-        }
+    return (pLayer->Query(&entry.cacheId, &query) == Util::Result::Success) &&
+           (query.dataSize == entry.dataSize) &&
+           (pLayer->Load(&query, Util::VoidPtrInc(pEntry, sizeof(BinaryCacheEntry) + padSize)) ==
+            Util::Result::Success);
+}
 
-        if (m_pArchiveLayer == nullptr)
+// =====================================================================================================================
+// Job data for loading the serialized entries from the memory layer in parallel
+struct LoadSerializedEntriesData
+{
+    Util::ICacheLayer*          pLayer;
+    const SerializedCacheEntry* pEntries;
+    void*                       pData;
+    uint32_t                    entryCount;
+    uint32_t                    entriesPerJob;
+    volatile uint32_t           failedCount;
+};
+
+// =====================================================================================================================
+// Load one contiguous range of entries.  Each entry is written to its offset from the layout, so jobs do not overlap.
+void PipelineBinaryCache::LoadSerializedEntriesJob(
+    void*    pJobData,
+    uint32_t index)
+{
+    LoadSerializedEntriesData* pData = static_cast<LoadSerializedEntriesData*>(pJobData);
+
+    const uint32_t firstEntry = index * pData->entriesPerJob;
+    const uint32_t endEntry   = Util::Min(firstEntry + pData->entriesPerJob, pData->entryCount);
+
+    for (uint32_t i = firstEntry; i < endEntry; ++i)
+    {
+        if (LoadSerializedEntry(pData->pLayer, pData->pEntries[i], pData->pData) == false)
         {
-            result = VK_ERROR_INITIALIZATION_FAILED;
+            Util::AtomicIncrement(&pData->failedCount);
         }
-
-        VK_ASSERT(pWriteLayer != nullptr);
     }
-
-    return result;
 }
 
 // =====================================================================================================================
-// Initialize layers (a single layer that supports storage for binaries needs to succeed)
-VkResult PipelineBinaryCache::InitLayers(
-    const PhysicalDevice*  pPhysicalDevice,
-    bool                   internal,
-    const RuntimeSettings& settings)
+// Grow the serialized data to hold at least size bytes, keeping its contents.
+VkResult PipelineBinaryCache::ReserveSerializedData(
+    size_t size)
 {
-    VkResult result = VK_ERROR_INITIALIZATION_FAILED;
+    VkResult result = VK_SUCCESS;
 
-#if ICD_GPUOPEN_DEVMODE_BUILD
-    if ((InitReinjectionLayer(settings) == VK_SUCCESS))
+    if (size > m_serializedDataCapacity)
     {
-        result = VK_SUCCESS;
-    }
-#endif
+        const size_t capacity = Util::Max(size, m_serializedDataCapacity * 2);
+        void*        pData    = m_pInstance->AllocMem(capacity,
+                                                      VK_DEFAULT_MEM_ALIGN,
+                                                      VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
 
-    if (InitMemoryCacheLayer(settings) == VK_SUCCESS)
-    {
-        result = VK_SUCCESS;
-    }
+        if (pData != nullptr)
+        {
+            if (m_pSerializedData != nullptr)
+            {
+                memcpy(pData, m_pSerializedData, m_serializedDataCapacity);
+                m_pInstance->FreeMem(m_pSerializedData);
+            }
 
-    // If cache handle is vkPipelineCache, we shouldn't store it to disk.
-    if (internal)
-    {
-        if (InitArchiveLayers(pPhysicalDevice, settings) == VK_SUCCESS)
+            m_pSerializedData         = pData;
+            m_serializedDataCapacity = capacity;
+        }
+        else
         {
-            result = VK_SUCCESS;
+            result = VK_ERROR_OUT_OF_HOST_MEMORY;
         }
     }
 
     return result;
 }
 
-VkResult PipelineBinaryCache::AddLayerToChain(
-    Util::ICacheLayer*  pLayer,
-    Util::ICacheLayer** pBottomLayer)
+// =====================================================================================================================
+// Load the entries laid out since the previous call into the serialized data.  Loading is spread across the thread
+// pool if one is given.  The entries written by previous calls are kept as they are.
+VkResult PipelineBinaryCache::WriteSerializedEntries(
+    CompileThreadPool* pThreadPool)
 {
-    VkResult result = VK_SUCCESS;
+    // Number of entries loaded by one job, which amortizes the pool's per-job overhead
+    constexpr uint32_t EntriesPerJob = 16;
 
-    if (pLayer != nullptr)
+    const uint32_t firstEntry = m_hashedCount;
+    const uint32_t entryCount = m_serializedEntries.NumElements() - firstEntry;
+
+    VkResult result = ReserveSerializedData(m_serializedSize);
+
+    if ((result == VK_SUCCESS) && (entryCount > 0))
     {
-        if (m_pTopLayer == nullptr)
+        LoadSerializedEntriesData jobData = {};
+
+        jobData.pLayer        = m_pTopLayer;
+        jobData.pEntries      = &m_serializedEntries.At(firstEntry);
+        jobData.pData         = m_pSerializedData;
+        jobData.entryCount    = entryCount;
+        jobData.entriesPerJob = EntriesPerJob;
+
+        const uint32_t jobCount = (entryCount + EntriesPerJob - 1) / EntriesPerJob;
+
+        if (pThreadPool != nullptr)
         {
-            m_pTopLayer = pLayer;
-            *pBottomLayer = pLayer;
+            pThreadPool->Execute(jobCount, &LoadSerializedEntriesJob, &jobData);
         }
         else
         {
-            if ((*pBottomLayer)->Link(pLayer) == Util::Result::Success)
-            {
-                *pBottomLayer = pLayer;
-            }
-            else
+            for (uint32_t i = 0; i < jobCount; ++i)
             {
-                result = VK_ERROR_INITIALIZATION_FAILED;
+                LoadSerializedEntriesJob(&jobData, i);
             }
         }
+
+        if (jobData.failedCount > 0)
+        {
+            result = RelayoutSerializedEntries(firstEntry);
+        }
     }
 
     return result;
 }
 
 // =====================================================================================================================
-// Order the layers for desired caching behaviour
-VkResult PipelineBinaryCache::OrderLayers(
-    const RuntimeSettings& settings)
+// Lay out and load the entries starting at firstEntry again one at a time, after some of them were replaced or evicted
+// between being laid out and being loaded.  Entries which still can't be loaded are left out of the layout; the next
+// update notices that the layout is missing entries of the memory layer and rebuilds it.
+VkResult PipelineBinaryCache::RelayoutSerializedEntries(
+    uint32_t firstEntry)
 {
-    VkResult result                 = VK_SUCCESS;
-    Util::ICacheLayer* pBottomLayer = nullptr;
-    m_pTopLayer                     = nullptr;
+    const uint32_t endEntry  = m_serializedEntries.NumElements();
+    uint32_t       keptCount = firstEntry;
+    VkResult       result    = VK_SUCCESS;
 
-    if (result == VK_SUCCESS)
+    m_serializedSize = m_serializedEntries.At(firstEntry).offset;
+
+    for (uint32_t i = firstEntry; (i < endEntry) && (result == VK_SUCCESS); ++i)
     {
-        result = AddLayerToChain(m_pMemoryLayer, &pBottomLayer);
+        SerializedCacheEntry entry = m_serializedEntries.At(i);
+        Util::QueryResult    query = {};
+
+        if (m_pTopLayer->Query(&entry.cacheId, &query) == Util::Result::Success)
+        {
+            entry.dataSize = query.dataSize;
+            entry.offset   = m_serializedSize;
+
+            result = ReserveSerializedData(GetEntryDataOffset(entry.offset) + entry.dataSize);
+
+            if ((result == VK_SUCCESS) && LoadSerializedEntry(m_pTopLayer, entry, m_pSerializedData))
+            {
+                m_serializedEntries.At(keptCount++) = entry;
+                m_serializedSize = GetEntryDataOffset(entry.offset) + entry.dataSize;
+            }
+        }
     }
 
-    if (result == VK_SUCCESS)
+    SerializedCacheEntry droppedEntry = {};
+
+    while (m_serializedEntries.NumElements() > keptCount)
     {
-        result = AddLayerToChain(m_pArchiveLayer, &pBottomLayer);
+        m_serializedEntries.PopBack(&droppedEntry);
     }
 
-    if ((result == VK_SUCCESS) &&
-        (m_pTopLayer == nullptr))
+    if (result != VK_SUCCESS)
     {
-        // The cache is not very useful if no layers are available.
-        result = VK_ERROR_INITIALIZATION_FAILED;
+        ResetSerializedEntries();
     }
 
     return result;
 }
 
 // =====================================================================================================================
-// Copies the pipeline cache data to the memory blob provided by the calling function.
-//
-// NOTE: It is expected that the calling function has not used this pipeline cache since querying the size
-VkResult PipelineBinaryCache::Serialize(
-    void*   pBlob,    // [out] System memory pointer where the serialized data should be placed
-    size_t* pSize)    // [in,out] Size of the memory pointed to by pBlob. If the value stored in pSize is zero then no
-                      // data will be copied and instead the size required for serialization will be returned in pSize
+// Add the entries which were loaded for the first time to the running hash, and store a finished duplicate of it in
+// the private header of the serialized data so that later calls can keep appending to the running hash.
+VkResult PipelineBinaryCache::FinishSerializedHash()
 {
-    VkResult result = VK_ERROR_INITIALIZATION_FAILED;
+    VK_ASSERT(m_pSerializedHash != nullptr);
 
-#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 534
-    if (m_pMemoryLayer != nullptr)
+    VkResult result = VK_SUCCESS;
+
+    if (m_hashedCount < m_serializedEntries.NumElements())
     {
-        if (*pSize == 0)
-        {
-            size_t curCount, curDataSize;
+        const size_t hashOffset = m_serializedEntries.At(m_hashedCount).offset;
 
-            result = PalToVkResult(Util::GetMemoryCacheLayerCurSize(m_pMemoryLayer, &curCount, &curDataSize));
-            if (result == VK_SUCCESS)
-            {
-                *pSize = curCount * sizeof(BinaryCacheEntry) + curDataSize + sizeof(PipelineBinaryCachePrivateHeader);
-            }
+        result = PalToVkResult(m_pSerializedHash->AddData(Util::VoidPtrInc(m_pSerializedData, hashOffset),
+                                                          m_serializedSize - hashOffset));
+
+        if (result == VK_SUCCESS)
+        {
+            m_hashedCount = m_serializedEntries.NumElements();
         }
         else
         {
-            size_t curCount, curDataSize;
+            ResetSerializedEntries();
+        }
+    }
 
-            result = PalToVkResult(Util::GetMemoryCacheLayerCurSize(m_pMemoryLayer, &curCount, &curDataSize));
-            if (result == VK_SUCCESS)
-            {
-                if (*pSize > (sizeof(BinaryCacheEntry) + sizeof(PipelineBinaryCachePrivateHeader)))
-                {
-                    Util::AutoBuffer<Util::Hash128, 8, PalAllocator> cacheIds(curCount, m_pInstance->Allocator());
-                    size_t remainingSpace    = *pSize - sizeof(PipelineBinaryCachePrivateHeader);
+    if (result == VK_SUCCESS)
+    {
+        auto pBinaryPrivateHeader = static_cast<PipelineBinaryCachePrivateHeader*>(m_pSerializedData);
 
-                    result = PalToVkResult(Util::GetMemoryCacheLayerHashIds(m_pMemoryLayer, curCount, &cacheIds[0]));
-                    if (result == VK_SUCCESS)
-                    {
-                        void* pDataDst = pBlob;
+        const size_t        contextSize = m_pPlatformKey->GetKeyContext()->GetDuplicateObjectSize();
+        void*               pContextMem = m_pInstance->AllocMem(
+                                            contextSize,
+                                            VK_DEFAULT_MEM_ALIGN,
+                                            VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+        Util::IHashContext* pContext    = nullptr;
 
-                        // reserved for privateHeader
-                        pDataDst = Util::VoidPtrInc(pDataDst, sizeof(PipelineBinaryCachePrivateHeader));
+        result = (pContextMem != nullptr) ?
+                 PalToVkResult(m_pSerializedHash->Duplicate(pContextMem, &pContext)) :
+                 VK_ERROR_OUT_OF_HOST_MEMORY;
 
-                        for (uint32_t i = 0; i < curCount && remainingSpace > sizeof(BinaryCacheEntry); i++)
-                        {
-                            size_t           dataSize;
-                            const void*      pBinaryCacheData;
+        if (result == VK_SUCCESS)
+        {
+            result = PalToVkResult(pContext->Finish(pBinaryPrivateHeader->hashId));
+        }
 
-                            result = PalToVkResult(LoadPipelineBinary(&cacheIds[i], &dataSize, &pBinaryCacheData));
-                            if (result == VK_SUCCESS)
-                            {
-                                if (remainingSpace >= (sizeof(BinaryCacheEntry) + dataSize))
-                                {
-                                    BinaryCacheEntry* pEntry =  static_cast<BinaryCacheEntry*>(pDataDst);
+        if (pContext != nullptr)
+        {
+            pContext->Destroy();
+        }
 
-                                    pEntry->hashId    = cacheIds[i];
-                                    pEntry->dataSize  = dataSize;
+        if (pContextMem != nullptr)
+        {
+            m_pInstance->FreeMem(pContextMem);
+        }
+    }
 
-                                    pDataDst = Util::VoidPtrInc(pDataDst, sizeof(BinaryCacheEntry));
-                                    memcpy(pDataDst, pBinaryCacheData, dataSize);
-                                    pDataDst = Util::VoidPtrInc(pDataDst, dataSize);
-                                    remainingSpace -= (sizeof(BinaryCacheEntry) + dataSize);
-                                }
-                                m_pInstance->FreeMem(const_cast<void*>(pBinaryCacheData));
-                            }
-                        }
-                    }
-                    if (*pSize < (sizeof(BinaryCacheEntry) * curCount + curDataSize + sizeof(PipelineBinaryCachePrivateHeader)))
-                    {
-                        result = VK_INCOMPLETE;
-                    }
-                    *pSize -= remainingSpace;
+    return result;
+}
 
-                    auto pBinaryPrivateHeader = static_cast<PipelineBinaryCachePrivateHeader*>(pBlob);
-                    void* pData               = Util::VoidPtrInc(pBlob, sizeof(PipelineBinaryCachePrivateHeader));
+// =====================================================================================================================
+// Copy the entries of pSrcCache that this cache doesn't hold yet into this cache.  The cache IDs are taken from the
+// source's serialized entry layout instead of querying its memory layer.  Returns false if the layout is not in sync
+// with the memory layer, in which case nothing was merged.
+bool PipelineBinaryCache::MergeSerializedEntries(
+    const PipelineBinaryCache* pSrcCache,
+    VkResult*                  pResult)
+{
+    Util::MutexAuto lock(&pSrcCache->m_serializeLock);
 
-                    result = PalToVkResult(CalculateHashId(
-                                                m_pInstance,
-                                                m_pPlatformKey,
-                                                pData,
-                                                *pSize - sizeof(PipelineBinaryCachePrivateHeader),
-                                                pBinaryPrivateHeader->hashId));
-                }
-                else
+    bool isInSync = (pSrcCache->m_pSerializedHash != nullptr);
+
+    if (isInSync)
+    {
+        Util::MutexAuto dirtyLock(&pSrcCache->m_dirtyLock);
+
+        isInSync = pSrcCache->m_dirtyEntries.IsEmpty();
+    }
+
+    if (isInSync)
+    {
+        size_t curCount, curDataSize;
+
+        isInSync = (Util::GetMemoryCacheLayerCurSize(pSrcCache->m_pMemoryLayer, &curCount, &curDataSize) ==
+                    Util::Result::Success) &&
+                   (curCount == pSrcCache->m_serializedEntries.NumElements());
+    }
+
+    if (isInSync)
+    {
+        *pResult = VK_SUCCESS;
+
+        for (uint32_t i = 0; (i < pSrcCache->m_serializedEntries.NumElements()) && (*pResult == VK_SUCCESS); ++i)
+        {
+            const CacheId&    cacheId = pSrcCache->m_serializedEntries.At(i).cacheId;
+            Util::QueryResult query   = {};
+
+            if (m_pTopLayer->Query(&cacheId, &query) != Util::Result::Success)
+            {
+                size_t      dataSize         = 0;
+                const void* pBinaryCacheData = nullptr;
+
+                // Keep compressed entries compressed, they are stored as-is
+                *pResult = PalToVkResult(pSrcCache->LoadFromLayers(&cacheId, false, &dataSize, &pBinaryCacheData));
+
+                if (*pResult == VK_SUCCESS)
                 {
-                    result = VK_ERROR_INITIALIZATION_FAILED;
+                    *pResult = PalToVkResult(StorePipelineBinary(&cacheId, dataSize, pBinaryCacheData));
+                    m_pInstance->FreeMem(const_cast<void*>(pBinaryCacheData));
                 }
             }
         }
     }
+
+    return isInSync;
+}
 #endif
-    return result;
+
+// =====================================================================================================================
+// Release the serialized entry layout and the running hash, and stop recording dirty entries until the layout is
+// rebuilt.
+void PipelineBinaryCache::ResetSerializedEntries()
+{
+    // Only set while the layout is valid, in which case m_dirtyLock has been initialized
+    if (m_trackDirtyEntries)
+    {
+        Util::MutexAuto lock(&m_dirtyLock);
+
+        m_trackDirtyEntries = false;
+        m_dirtyEntries.Clear();
+    }
+
+    if (m_pSerializedHash != nullptr)
+    {
+        m_pSerializedHash->Destroy();
+        m_pSerializedHash = nullptr;
+    }
+
+    if (m_pSerializedHashMem != nullptr)
+    {
+        m_pInstance->FreeMem(m_pSerializedHashMem);
+        m_pSerializedHashMem = nullptr;
+    }
+
+    m_serializedEntries.Clear();
+
+    m_serializedSize = sizeof(PipelineBinaryCachePrivateHeader);
+    m_hashedCount    = 0;
 }
 
 // =====================================================================================================================
-// Merge the pipeline cache data into one
+// Merge the pipeline cache data into one.  Sources whose serialized entry layout is up to date are merged using the
+// cache IDs of the layout; otherwise their memory layer is walked.  Entries already present in this cache are not
+// copied again.
 //
 VkResult PipelineBinaryCache::Merge(
     uint32_t                    srcCacheCount,
@@ -1288,6 +2727,16 @@ VkResult PipelineBinaryCache::Merge(
     {
         for (uint32_t i = 0; i < srcCacheCount; i++)
         {
+            if (MergeSerializedEntries(ppSrcCaches[i], &result))
+            {
+                if (result != VK_SUCCESS)
+                {
+                    break;
+                }
+
+                continue;
+            }
+
             Util::ICacheLayer* pMemoryLayer = ppSrcCaches[i]->GetMemoryLayer();
             size_t curCount, curDataSize;
 
@@ -1301,10 +2750,20 @@ VkResult PipelineBinaryCache::Merge(
                 {
                     for (uint32_t j = 0; j < curCount; j++)
                     {
-                        size_t           dataSize;
-                        const void*      pBinaryCacheData;
+                        size_t            dataSize;
+                        const void*       pBinaryCacheData;
+                        Util::QueryResult query = {};
+
+                        if (m_pTopLayer->Query(&cacheIds[j], &query) == Util::Result::Success)
+                        {
+                            continue;
+                        }
 
-                        result = PalToVkResult(ppSrcCaches[i]->LoadPipelineBinary(&cacheIds[j], &dataSize, &pBinaryCacheData));
+                        // Keep compressed entries compressed, they are stored as-is
+                        result = PalToVkResult(ppSrcCaches[i]->LoadFromLayers(&cacheIds[j],
+                                                                              false,
+                                                                              &dataSize,
+                                                                              &pBinaryCacheData));
                         if (result == VK_SUCCESS)
                         {
                             result = PalToVkResult(StorePipelineBinary(&cacheIds[j], dataSize, pBinaryCacheData));
@@ -43,6 +43,7 @@
 #include <vector>
 
 #include "palFile.h"
+#include "palHashMapImpl.h"
 #include "palHashSetImpl.h"
 
 #include "include/pipeline_binary_cache.h"
@@ -67,6 +68,11 @@ PipelineCompiler::PipelineCompiler(
     m_pPhysicalDevice(pPhysicalDevice)
     , m_compilerSolutionLlpc(pPhysicalDevice)
     , m_pBinaryCache(nullptr)
+    , m_inFlightCompiles(32, pPhysicalDevice->VkInstance()->Allocator())
+    , m_graphicsCacheIds(256, pPhysicalDevice->VkInstance()->Allocator())
+    , m_pGraphicsCacheIdKeys(nullptr)
+    , m_graphicsCacheIdKeyCount(0)
+    , m_graphicsCacheIdKeyHead(0)
     , m_cacheAttempts(0)
     , m_cacheHits(0)
     , m_totalBinaries(0)
@@ -99,7 +105,34 @@ void PipelineCompiler::GetElfCacheMetricString(
         "Total time spent - %0.1f ms\n"
         "Average time spent per request - %0.3f ms\n";
 
-    Util::Snprintf(pOutStr, outStrSize, metricFmtString, hitRate * 100, m_totalBinaries, totalMs, avgMs);
+    const int32_t length =
+        Util::Snprintf(pOutStr, outStrSize, metricFmtString, hitRate * 100, m_totalBinaries, totalMs, avgMs);
+
+    if ((m_pBinaryCache != nullptr) && (length > 0) && (static_cast<size_t>(length) < outStrSize))
+    {
+        PipelineBinaryCache::Statistics stats = {};
+        m_pBinaryCache->GetStatistics(&stats);
+
+        static constexpr char layerFmtString[] =
+            "Internal cache hits - %u\n"
+            "Internal cache misses - %u\n"
+            "Memory layer stores - %u\n"
+            "Memory layer evictions - %u\n"
+            "Memory layer resident - %zu entries, %zu bytes\n";
+
+        Util::Snprintf(pOutStr + length, outStrSize - length, layerFmtString,
+            stats.hits, stats.misses, stats.stores, stats.evictions, stats.residentEntries, stats.residentBytes);
+    }
+}
+
+// =====================================================================================================================
+// Wait until binaries queued for the internal cache's background writer have been written
+void PipelineCompiler::FlushBinaryCache()
+{
+    if (m_pBinaryCache != nullptr)
+    {
+        m_pBinaryCache->FlushPendingStores();
+    }
 }
 
 // =====================================================================================================================
@@ -161,6 +194,39 @@ VkResult PipelineCompiler::Initialize()
         result = m_compilerSolutionLlpc.Initialize(m_gfxIp, info.gfxLevel);
     }
 
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(m_inFlightLock.Init());
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(m_inFlightCompiles.Init());
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(m_graphicsCacheIdLock.Init());
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(m_graphicsCacheIds.Init());
+    }
+
+    if ((result == VK_SUCCESS) && settings.enablePipelineCacheIdFastPath && (settings.pipelineCacheIdMaxEntries > 0))
+    {
+        m_pGraphicsCacheIdKeys = static_cast<uint64_t*>(m_pPhysicalDevice->VkInstance()->AllocMem(
+            sizeof(uint64_t) * settings.pipelineCacheIdMaxEntries,
+            VK_DEFAULT_MEM_ALIGN,
+            VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE));
+
+        if (m_pGraphicsCacheIdKeys == nullptr)
+        {
+            result = VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+    }
+
     if ((result == VK_SUCCESS) &&
         ((settings.usePalPipelineCaching) ||
          (m_pPhysicalDevice->VkInstance()->GetDevModeMgr() != nullptr)))
@@ -181,6 +247,17 @@ void PipelineCompiler::Destroy()
 {
     m_compilerSolutionLlpc.Destroy();
 
+    for (GraphicsCacheIdMap::Iterator it = m_graphicsCacheIds.Begin(); it.Get() != nullptr; it.Next())
+    {
+        m_pPhysicalDevice->VkInstance()->FreeMem(it.Get()->value);
+    }
+
+    if (m_pGraphicsCacheIdKeys != nullptr)
+    {
+        m_pPhysicalDevice->VkInstance()->FreeMem(m_pGraphicsCacheIdKeys);
+        m_pGraphicsCacheIdKeys = nullptr;
+    }
+
     if (m_pBinaryCache)
     {
         m_pBinaryCache->Destroy();
@@ -571,16 +648,35 @@ Util::Result PipelineCompiler::GetCachedPipelineBinary(
 
     if (m_pBinaryCache != nullptr)
     {
+        // Binaries from the memory-mapped blob are returned without a copy, unless a debug option needs to patch them.
+        const RuntimeSettings& settings  = m_pPhysicalDevice->GetRuntimeSettings();
+        const bool             useMapped = (settings.shaderReplaceMode != ShaderReplaceShaderISA) &&
+                                           (settings.enableDropPipelineBinaryInst == false);
+
         // If user cache is already hit, we just need query if it is in internal cache,
         // don't need heavy loading work.
         if (*pIsUserCacheHit)
         {
-            Util::QueryResult query = {};
-            cacheResult = m_pBinaryCache->QueryPipelineBinary(pCacheId, &query);
+            size_t mappedSize = 0;
+
+            cacheResult = m_pBinaryCache->LoadMappedPipelineBinary(pCacheId, &mappedSize, nullptr);
+
+            if (cacheResult != Util::Result::Success)
+            {
+                Util::QueryResult query = {};
+                cacheResult = m_pBinaryCache->QueryPipelineBinary(pCacheId, &query);
+            }
         }
         else
         {
-            cacheResult = m_pBinaryCache->LoadPipelineBinary(pCacheId, pPipelineBinarySize, ppPipelineBinary);
+            cacheResult = useMapped ?
+                m_pBinaryCache->LoadMappedPipelineBinary(pCacheId, pPipelineBinarySize, ppPipelineBinary) :
+                Util::Result::NotFound;
+
+            if (cacheResult != Util::Result::Success)
+            {
+                cacheResult = m_pBinaryCache->LoadPipelineBinary(pCacheId, pPipelineBinarySize, ppPipelineBinary);
+            }
         }
         if (cacheResult == Util::Result::Success)
         {
@@ -597,6 +693,181 @@ Util::Result PipelineCompiler::GetCachedPipelineBinary(
     return cacheResult;
 }
 
+// =====================================================================================================================
+// Registers the calling thread as interested in the binary with the given cache ID.  If no other thread is compiling
+// it, the caller becomes the owner and must call CompleteInFlightCompile() after compiling and storing it.  Otherwise
+// the caller must call WaitInFlightCompile().  Returns nullptr if the compile can't be tracked, in which case the
+// caller simply compiles on its own.
+PipelineCompiler::InFlightCompile* PipelineCompiler::JoinInFlightCompile(
+    const Util::MetroHash::Hash* pCacheId,
+    bool*                        pIsOwner)
+{
+    Instance*         pInstance = m_pPhysicalDevice->VkInstance();
+    InFlightCompile*  pInFlight = nullptr;
+    InFlightCompile** ppEntry   = nullptr;
+    bool              existed   = false;
+
+    *pIsOwner = false;
+
+    Util::MutexAuto lock(&m_inFlightLock);
+
+    if (m_inFlightCompiles.FindAllocate(Util::MetroHash::Compact64(pCacheId), &existed, &ppEntry) ==
+        Pal::Result::Success)
+    {
+        if (existed)
+        {
+            // A different cache ID colliding on the compacted key is compiled independently.
+            if (memcmp(&(*ppEntry)->cacheId, pCacheId, sizeof(*pCacheId)) == 0)
+            {
+                pInFlight = *ppEntry;
+                pInFlight->refCount++;
+            }
+        }
+        else
+        {
+            void* pMemory = pInstance->AllocMem(sizeof(InFlightCompile), VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+            if (pMemory != nullptr)
+            {
+                pInFlight = VK_PLACEMENT_NEW(pMemory) InFlightCompile();
+
+                Util::EventCreateFlags flags = {};
+                flags.manualReset       = true;
+                flags.initiallySignaled = false;
+
+                if (pInFlight->doneEvent.Init(flags) == Pal::Result::Success)
+                {
+                    pInFlight->cacheId    = *pCacheId;
+                    pInFlight->refCount   = 1;
+                    pInFlight->succeeded  = false;
+                    pInFlight->binarySize = 0;
+                    pInFlight->pBinary    = nullptr;
+
+                    *ppEntry  = pInFlight;
+                    *pIsOwner = true;
+                }
+                else
+                {
+                    Util::Destructor(pInFlight);
+                    pInstance->FreeMem(pInFlight);
+                    pInFlight = nullptr;
+                }
+            }
+
+            if (pInFlight == nullptr)
+            {
+                m_inFlightCompiles.Erase(Util::MetroHash::Compact64(pCacheId));
+            }
+        }
+    }
+
+    return pInFlight;
+}
+
+// =====================================================================================================================
+// Blocks until the owner of an in-flight compile finishes and returns a private copy of its binary, which must be freed
+// like a binary loaded from the cache.  Returns false if the owner failed, in which case the caller compiles itself.
+bool PipelineCompiler::WaitInFlightCompile(
+    InFlightCompile* pInFlight,
+    size_t*          pPipelineBinarySize,
+    const void**     ppPipelineBinary)
+{
+    bool success = false;
+
+    pInFlight->doneEvent.Wait(Util::InfiniteTimeout);
+
+    if (pInFlight->succeeded)
+    {
+        void* pBinary = m_pPhysicalDevice->VkInstance()->AllocMem(
+            pInFlight->binarySize,
+            VK_DEFAULT_MEM_ALIGN,
+            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+        if (pBinary != nullptr)
+        {
+            memcpy(pBinary, pInFlight->pBinary, pInFlight->binarySize);
+
+            *pPipelineBinarySize = pInFlight->binarySize;
+            *ppPipelineBinary    = pBinary;
+            success              = true;
+        }
+    }
+
+    ReleaseInFlightCompile(pInFlight);
+
+    return success;
+}
+
+// =====================================================================================================================
+// Publishes the result of an in-flight compile to any waiting threads.  Must be called by the owner after the binary
+// has been stored to the caches, so that later requests hit the cache instead of the in-flight table.
+void PipelineCompiler::CompleteInFlightCompile(
+    InFlightCompile* pInFlight,
+    VkResult         result,
+    size_t           pipelineBinarySize,
+    const void*      pPipelineBinary)
+{
+    bool hasWaiters = false;
+
+    {
+        Util::MutexAuto lock(&m_inFlightLock);
+
+        m_inFlightCompiles.Erase(Util::MetroHash::Compact64(&pInFlight->cacheId));
+
+        // No thread can join once the entry is erased, and the waiters hold their reference until the event is set.
+        hasWaiters = (pInFlight->refCount > 1);
+    }
+
+    // The owner's binary may be freed as soon as this returns, so waiters get a copy that lives with the entry.  The
+    // copy is published to them by setting the event.
+    if (hasWaiters && (result == VK_SUCCESS))
+    {
+        pInFlight->pBinary = m_pPhysicalDevice->VkInstance()->AllocMem(
+            pipelineBinarySize,
+            VK_DEFAULT_MEM_ALIGN,
+            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+        if (pInFlight->pBinary != nullptr)
+        {
+            memcpy(pInFlight->pBinary, pPipelineBinary, pipelineBinarySize);
+
+            pInFlight->binarySize = pipelineBinarySize;
+            pInFlight->succeeded  = true;
+        }
+    }
+
+    pInFlight->doneEvent.Set();
+
+    ReleaseInFlightCompile(pInFlight);
+}
+
+// =====================================================================================================================
+// Drops one reference to an in-flight compile and frees it after the last one.
+void PipelineCompiler::ReleaseInFlightCompile(
+    InFlightCompile* pInFlight)
+{
+    bool lastRef = false;
+
+    {
+        Util::MutexAuto lock(&m_inFlightLock);
+
+        lastRef = (--pInFlight->refCount == 0);
+    }
+
+    if (lastRef)
+    {
+        Instance* pInstance = m_pPhysicalDevice->VkInstance();
+
+        if (pInFlight->pBinary != nullptr)
+        {
+            pInstance->FreeMem(pInFlight->pBinary);
+        }
+
+        Util::Destructor(pInFlight);
+        pInstance->FreeMem(pInFlight);
+    }
+}
+
 // =====================================================================================================================
 // Creates partial pipeline binary.
 VkResult PipelineCompiler::CreatePartialPipelineBinary(
@@ -712,7 +983,7 @@ VkResult PipelineCompiler::CreateGraphicsPipelineBinary(
         pPipelineBinaryCache = pPipelineCache->GetPipelineCache();
     }
 
-    if (shouldCompile && ((pPipelineBinaryCache != nullptr) || (m_pBinaryCache != nullptr)))
+    if (shouldCompile)
     {
         int64_t startTime = Util::GetPerfCpuTime();
         Util::MetroHash128 hash = {};
@@ -731,16 +1002,43 @@ VkResult PipelineCompiler::CreateGraphicsPipelineBinary(
         hash.Update(pCreateInfo->compilerType);
         hash.Finalize(pCacheId->bytes);
 
-        cacheResult = GetCachedPipelineBinary(pCacheId, pPipelineBinaryCache, pPipelineBinarySize, ppPipelineBinary,
-            &isUserCacheHit, &isInternalCacheHit, &pCreateInfo->elfWasCached, &pCreateInfo->pipelineFeedback);
-        if (cacheResult == Util::Result::Success)
+        // The cache ID also keys the in-flight compiles below, so it is computed even without a cache.
+        if ((pPipelineBinaryCache != nullptr) || (m_pBinaryCache != nullptr))
         {
-            shouldCompile = false;
+            cacheResult = GetCachedPipelineBinary(pCacheId, pPipelineBinaryCache, pPipelineBinarySize,
+                ppPipelineBinary, &isUserCacheHit, &isInternalCacheHit, &pCreateInfo->elfWasCached,
+                &pCreateInfo->pipelineFeedback);
+            if (cacheResult == Util::Result::Success)
+            {
+                shouldCompile = false;
+            }
         }
 
         cacheTime = Util::GetPerfCpuTime() - startTime;
     }
 
+    InFlightCompile* pInFlight    = nullptr;
+    bool             ownsInFlight = false;
+
+    if (shouldCompile)
+    {
+        // If another thread is already compiling this pipeline, reuse its binary instead of compiling it again.
+        pInFlight = JoinInFlightCompile(pCacheId, &ownsInFlight);
+
+        if ((pInFlight != nullptr) && (ownsInFlight == false))
+        {
+            if (WaitInFlightCompile(pInFlight, pPipelineBinarySize, ppPipelineBinary))
+            {
+                // The owner already stored the binary to the internal cache, if there is one.
+                shouldCompile             = false;
+                isInternalCacheHit        = (m_pBinaryCache != nullptr);
+                pCreateInfo->elfWasCached = true;
+            }
+
+            pInFlight = nullptr;
+        }
+    }
+
     if (shouldCompile)
     {
         {
@@ -787,6 +1085,11 @@ VkResult PipelineCompiler::CreateGraphicsPipelineBinary(
         VK_ASSERT(Util::IsErrorResult(cacheResult) == false);
     }
 
+    if (ownsInFlight)
+    {
+        CompleteInFlightCompile(pInFlight, result, *pPipelineBinarySize, *ppPipelineBinary);
+    }
+
     m_totalTimeSpent += pCreateInfo->elfWasCached ? cacheTime : compileTime;
     m_totalBinaries++;
 
@@ -821,6 +1124,243 @@ VkResult PipelineCompiler::CreateGraphicsPipelineBinary(
     return result;
 }
 
+// =====================================================================================================================
+// Everything derived from the create info of a graphics pipeline that is needed besides the binary itself once its
+// cache ID is known.
+struct PipelineCompiler::GraphicsCacheIdEntry
+{
+    Util::MetroHash::Hash basePipelineHash;     // Full API hash, the map is keyed by its compacted value
+    uint32_t              deviceIdx;
+    uint64_t              optionsHash;          // See GetPipelineOptionsHash()
+    Util::MetroHash::Hash cacheId;
+    PipelineOptimizerKey  pipelineProfileKey;
+    VbBindingInfo         vbInfo;
+};
+
+// =====================================================================================================================
+uint64_t PipelineCompiler::GetGraphicsCacheIdKey(
+    const Util::MetroHash::Hash& basePipelineHash,
+    uint32_t                     deviceIdx,
+    uint64_t                     optionsHash)
+{
+    return Util::MetroHash::Compact64(&basePipelineHash) ^ optionsHash ^ deviceIdx;
+}
+
+// =====================================================================================================================
+// Hashes the pipeline options which ApplyPipelineOptions() takes from the VkDevice, such as robustBufferAccess.  The
+// API hash only covers the create info, but the compiler is shared by every VkDevice of the physical device.
+uint64_t PipelineCompiler::GetPipelineOptionsHash(
+    const Device*         pDevice,
+    VkPipelineCreateFlags flags)
+{
+    Vkgc::PipelineOptions options;
+    uint64_t              hash = 0;
+
+    memset(&options, 0, sizeof(options));
+    ApplyPipelineOptions(pDevice, flags, &options);
+
+    Util::MetroHash64::Hash(
+        reinterpret_cast<const uint8_t*>(&options),
+        sizeof(options),
+        reinterpret_cast<uint8_t*>(&hash));
+
+    return hash;
+}
+
+// =====================================================================================================================
+// The cache ID lookup has to be bypassed whenever a debug option alters the binary or needs the converted create info.
+bool PipelineCompiler::UseCacheIdFastPath(
+    const PipelineCache* pPipelineCache) const
+{
+    const RuntimeSettings& settings = m_pPhysicalDevice->GetRuntimeSettings();
+
+    const bool hasCache = (m_pBinaryCache != nullptr) ||
+                          ((pPipelineCache != nullptr) && (pPipelineCache->GetPipelineCache() != nullptr));
+
+    return hasCache                                                   &&
+           settings.enablePipelineCacheIdFastPath                     &&
+           (settings.shaderReplaceMode == ShaderReplaceDisable)       &&
+           (settings.enablePipelineDump == false)                     &&
+           (settings.enableDropPipelineBinaryInst == false);
+}
+
+// =====================================================================================================================
+// Looks up the cache ID of a previously created graphics pipeline by its API hash, which must already be stored in
+// pCreateInfo->basePipelineHash, and loads the binary from the pipeline caches.  On success pCreateInfo and pVbInfo
+// hold what ConvertGraphicsPipelineInfo() would have produced for creating the pipeline from the binary, and neither
+// ConvertGraphicsPipelineInfo() nor CreateGraphicsPipelineBinary() needs to be called.  Returns false if the pipeline
+// is unknown or no longer cached.
+bool PipelineCompiler::LoadCachedGraphicsPipelineBinary(
+    Device*                                         pDevice,
+    uint32_t                                        deviceIdx,
+    PipelineCache*                                  pPipelineCache,
+    const VkGraphicsPipelineCreateInfo*             pIn,
+    GraphicsPipelineCreateInfo*                     pCreateInfo,
+    VbBindingInfo*                                  pVbInfo,
+    size_t*                                         pPipelineBinarySize,
+    const void**                                    ppPipelineBinary,
+    Util::MetroHash::Hash*                          pCacheId,
+    const VkPipelineCreationFeedbackCreateInfoEXT** ppPipelineCreationFeadbackCreateInfo)
+{
+    GraphicsCacheIdEntry entry    = {};
+    bool                 hasEntry = false;
+
+    if (UseCacheIdFastPath(pPipelineCache))
+    {
+        const uint64_t optionsHash = GetPipelineOptionsHash(pDevice, pIn->flags);
+
+        Util::RWLockAuto<Util::RWLock::LockType::ReadOnly> lock(&m_graphicsCacheIdLock);
+
+        GraphicsCacheIdEntry** ppEntry =
+            m_graphicsCacheIds.FindKey(GetGraphicsCacheIdKey(pCreateInfo->basePipelineHash, deviceIdx, optionsHash));
+
+        // Entries can be evicted once the lock is dropped, so a copy is used.
+        if ((ppEntry != nullptr) &&
+            ((*ppEntry)->deviceIdx == deviceIdx) &&
+            ((*ppEntry)->optionsHash == optionsHash) &&
+            (memcmp(&(*ppEntry)->basePipelineHash, &pCreateInfo->basePipelineHash, sizeof(Util::MetroHash::Hash)) ==
+             0))
+        {
+            entry    = **ppEntry;
+            hasEntry = true;
+        }
+    }
+
+    bool isCacheHit = false;
+
+    if (hasEntry)
+    {
+        int64_t startTime = Util::GetPerfCpuTime();
+
+        PipelineBinaryCache* pPipelineBinaryCache = (pPipelineCache != nullptr) ?
+                                                    pPipelineCache->GetPipelineCache() : nullptr;
+
+        bool isUserCacheHit     = false;
+        bool isInternalCacheHit = false;
+
+        isCacheHit = (GetCachedPipelineBinary(&entry.cacheId,
+                                              pPipelineBinaryCache,
+                                              pPipelineBinarySize,
+                                              ppPipelineBinary,
+                                              &isUserCacheHit,
+                                              &isInternalCacheHit,
+                                              &pCreateInfo->elfWasCached,
+                                              &pCreateInfo->pipelineFeedback) == Util::Result::Success);
+
+        if (isCacheHit)
+        {
+            // Keep both caches populated, as CreateGraphicsPipelineBinary() does
+            if ((pPipelineBinaryCache != nullptr) && (isUserCacheHit == false))
+            {
+                Util::Result cacheResult = pPipelineBinaryCache->StorePipelineBinary(
+                    &entry.cacheId,
+                    *pPipelineBinarySize,
+                    *ppPipelineBinary);
+
+                VK_ASSERT(Util::IsErrorResult(cacheResult) == false);
+            }
+
+            if ((m_pBinaryCache != nullptr) && (isInternalCacheHit == false))
+            {
+                Util::Result cacheResult = m_pBinaryCache->StorePipelineBinary(
+                    &entry.cacheId,
+                    *pPipelineBinarySize,
+                    *ppPipelineBinary);
+
+                VK_ASSERT(Util::IsErrorResult(cacheResult) == false);
+            }
+
+            if (ppPipelineCreationFeadbackCreateInfo != nullptr)
+            {
+                GetPipelineCreationInfoNext(
+                    reinterpret_cast<const VkStructHeader*>(pIn->pNext),
+                    ppPipelineCreationFeadbackCreateInfo);
+            }
+
+            pCreateInfo->flags              = pIn->flags;
+            pCreateInfo->pipelineProfileKey = entry.pipelineProfileKey;
+            *pVbInfo                        = entry.vbInfo;
+            *pCacheId                       = entry.cacheId;
+
+            m_totalTimeSpent += Util::GetPerfCpuTime() - startTime;
+            m_totalBinaries++;
+        }
+    }
+
+    return isCacheHit;
+}
+
+// =====================================================================================================================
+// Remembers the cache ID and conversion results of a graphics pipeline created through CreateGraphicsPipelineBinary()
+// for LoadCachedGraphicsPipelineBinary().  Evicts the oldest entry if the map is full.
+void PipelineCompiler::RegisterGraphicsPipelineCacheId(
+    const Device*                     pDevice,
+    uint32_t                          deviceIdx,
+    PipelineCache*                    pPipelineCache,
+    const GraphicsPipelineCreateInfo& createInfo,
+    const VbBindingInfo&              vbInfo,
+    const Util::MetroHash::Hash&      cacheId)
+{
+    if (UseCacheIdFastPath(pPipelineCache) && (m_pGraphicsCacheIdKeys != nullptr))
+    {
+        const uint32_t maxEntries  = m_pPhysicalDevice->GetRuntimeSettings().pipelineCacheIdMaxEntries;
+        const uint64_t optionsHash = GetPipelineOptionsHash(pDevice, createInfo.flags);
+        const uint64_t key         = GetGraphicsCacheIdKey(createInfo.basePipelineHash, deviceIdx, optionsHash);
+
+        Util::RWLockAuto<Util::RWLock::LockType::ReadWrite> lock(&m_graphicsCacheIdLock);
+
+        bool                   existed = false;
+        GraphicsCacheIdEntry** ppEntry = nullptr;
+
+        Util::Result result = m_graphicsCacheIds.FindAllocate(key, &existed, &ppEntry);
+
+        // On a compacted key collision the first pipeline keeps the entry and the other one takes the slow path.
+        if ((result == Util::Result::Success) && (existed == false))
+        {
+            GraphicsCacheIdEntry* pEntry = static_cast<GraphicsCacheIdEntry*>(
+                m_pPhysicalDevice->VkInstance()->AllocMem(
+                    sizeof(GraphicsCacheIdEntry),
+                    VK_DEFAULT_MEM_ALIGN,
+                    VK_SYSTEM_ALLOCATION_SCOPE_OBJECT));
+
+            if (pEntry != nullptr)
+            {
+                pEntry->basePipelineHash   = createInfo.basePipelineHash;
+                pEntry->deviceIdx          = deviceIdx;
+                pEntry->optionsHash        = optionsHash;
+                pEntry->cacheId            = cacheId;
+                pEntry->pipelineProfileKey = createInfo.pipelineProfileKey;
+                pEntry->vbInfo             = vbInfo;
+
+                *ppEntry = pEntry;
+
+                if (m_graphicsCacheIdKeyCount < maxEntries)
+                {
+                    m_pGraphicsCacheIdKeys[m_graphicsCacheIdKeyCount++] = key;
+                }
+                else
+                {
+                    const uint64_t         oldKey     = m_pGraphicsCacheIdKeys[m_graphicsCacheIdKeyHead];
+                    GraphicsCacheIdEntry** ppOldEntry = m_graphicsCacheIds.FindKey(oldKey);
+
+                    if (ppOldEntry != nullptr)
+                    {
+                        m_pPhysicalDevice->VkInstance()->FreeMem(*ppOldEntry);
+                        m_graphicsCacheIds.Erase(oldKey);
+                    }
+
+                    m_pGraphicsCacheIdKeys[m_graphicsCacheIdKeyHead] = key;
+                    m_graphicsCacheIdKeyHead = (m_graphicsCacheIdKeyHead + 1) % maxEntries;
+                }
+            }
+            else
+            {
+                m_graphicsCacheIds.Erase(key);
+            }
+        }
+    }
+}
+
 // =====================================================================================================================
 // Creates compute pipeline binary.
 VkResult PipelineCompiler::CreateComputePipelineBinary(
@@ -903,7 +1443,7 @@ VkResult PipelineCompiler::CreateComputePipelineBinary(
         pPipelineBinaryCache = pPipelineCache->GetPipelineCache();
     }
 
-    if (shouldCompile && ((pPipelineBinaryCache != nullptr) || (m_pBinaryCache != nullptr)))
+    if (shouldCompile)
     {
         int64_t startTime = Util::GetPerfCpuTime();
         Util::MetroHash128 hash = {};
@@ -916,16 +1456,43 @@ VkResult PipelineCompiler::CreateComputePipelineBinary(
         hash.Update(pCreateInfo->compilerType);
         hash.Finalize(pCacheId->bytes);
 
-        cacheResult = GetCachedPipelineBinary(pCacheId, pPipelineBinaryCache, pPipelineBinarySize, ppPipelineBinary,
-            &isUserCacheHit, &isInternalCacheHit, &pCreateInfo->elfWasCached, &pCreateInfo->pipelineFeedback);
-        if (cacheResult == Util::Result::Success)
+        // The cache ID also keys the in-flight compiles below, so it is computed even without a cache.
+        if ((pPipelineBinaryCache != nullptr) || (m_pBinaryCache != nullptr))
         {
-            shouldCompile = false;
+            cacheResult = GetCachedPipelineBinary(pCacheId, pPipelineBinaryCache, pPipelineBinarySize,
+                ppPipelineBinary, &isUserCacheHit, &isInternalCacheHit, &pCreateInfo->elfWasCached,
+                &pCreateInfo->pipelineFeedback);
+            if (cacheResult == Util::Result::Success)
+            {
+                shouldCompile = false;
+            }
         }
 
         cacheTime = Util::GetPerfCpuTime() - startTime;
     }
 
+    InFlightCompile* pInFlight    = nullptr;
+    bool             ownsInFlight = false;
+
+    if (shouldCompile)
+    {
+        // If another thread is already compiling this pipeline, reuse its binary instead of compiling it again.
+        pInFlight = JoinInFlightCompile(pCacheId, &ownsInFlight);
+
+        if ((pInFlight != nullptr) && (ownsInFlight == false))
+        {
+            if (WaitInFlightCompile(pInFlight, pPipelineBinarySize, ppPipelineBinary))
+            {
+                // The owner already stored the binary to the internal cache, if there is one.
+                shouldCompile             = false;
+                isInternalCacheHit        = (m_pBinaryCache != nullptr);
+                pCreateInfo->elfWasCached = true;
+            }
+
+            pInFlight = nullptr;
+        }
+    }
+
     if (shouldCompile)
     {
         {
@@ -970,6 +1537,11 @@ VkResult PipelineCompiler::CreateComputePipelineBinary(
         VK_ASSERT(Util::IsErrorResult(cacheResult) == false);
     }
 
+    if (ownsInFlight)
+    {
+        CompleteInFlightCompile(pInFlight, result, *pPipelineBinarySize, *ppPipelineBinary);
+    }
+
     m_totalTimeSpent += pCreateInfo->elfWasCached ? cacheTime : compileTime;
     m_totalBinaries++;
     if (settings.shaderReplaceMode == ShaderReplaceShaderISA)
@@ -1679,7 +2251,11 @@ void PipelineCompiler::FreeComputePipelineBinary(
 {
     if (pCreateInfo->elfWasCached)
     {
-        m_pPhysicalDevice->Manager()->VkInstance()->FreeMem(const_cast<void*>(pPipelineBinary));
+        // Binaries in the memory-mapped blob are owned by the cache
+        if ((m_pBinaryCache == nullptr) || (m_pBinaryCache->IsMappedPipelineBinary(pPipelineBinary) == false))
+        {
+            m_pPhysicalDevice->Manager()->VkInstance()->FreeMem(const_cast<void*>(pPipelineBinary));
+        }
     }
     else
     {
@@ -1700,7 +2276,11 @@ void PipelineCompiler::FreeGraphicsPipelineBinary(
 {
     if (pCreateInfo->elfWasCached)
     {
-        m_pPhysicalDevice->Manager()->VkInstance()->FreeMem(const_cast<void*>(pPipelineBinary));
+        // Binaries in the memory-mapped blob are owned by the cache
+        if ((m_pBinaryCache == nullptr) || (m_pBinaryCache->IsMappedPipelineBinary(pPipelineBinary) == false))
+        {
+            m_pPhysicalDevice->Manager()->VkInstance()->FreeMem(const_cast<void*>(pPipelineBinary));
+        }
     }
     else
     {
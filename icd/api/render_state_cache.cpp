@@ -41,6 +41,26 @@
 namespace vk
 {
 
+// =====================================================================================================================
+// Adds a reference to a cached state.  States are looked up and referenced while only holding the lock for reading, so
+// the count is incremented with a compare-and-swap that fails instead of wrapping around once it reached UINT_MAX.
+static bool AddStateRef(
+    uint32_t* pRefCount)
+{
+    uint32_t refCount = *pRefCount;
+    bool     added    = false;
+
+    while ((added == false) && (refCount < UINT_MAX))
+    {
+        const uint32_t prevRefCount = Util::AtomicCompareAndSwap(pRefCount, refCount, refCount + 1);
+
+        added    = (prevRefCount == refCount);
+        refCount = prevRefCount;
+    }
+
+    return added;
+}
+
 // =====================================================================================================================
 RenderStateCache::RenderStateCache(
     Device* pDevice)
@@ -80,7 +100,29 @@ RenderStateCache::RenderStateCache(
 // Initializes the render state cache.  Should be called during device create.
 VkResult RenderStateCache::Init()
 {
-    Pal::Result result = m_mutex.Init();
+    Util::RWLock* const pLocks[] =
+    {
+        &m_inputAssemblyStateLock,
+        &m_triangleRasterStateLock,
+        &m_pointLineRasterStateLock,
+        &m_lineStippleStateLock,
+        &m_depthBiasLock,
+        &m_blendConstLock,
+        &m_depthBoundsLock,
+        &m_viewportLock,
+        &m_scissorRectLock,
+        &m_msaaStatesLock,
+        &m_samplePatternLock,
+        &m_colorBlendStatesLock,
+        &m_depthStencilStatesLock
+    };
+
+    Pal::Result result = Pal::Result::Success;
+
+    for (uint32_t i = 0; (i < VK_ARRAY_SIZE(pLocks)) && (result == Pal::Result::Success); ++i)
+    {
+        result = pLocks[i]->Init();
+    }
 
     if (result == Pal::Result::Success)
     {
@@ -183,7 +225,7 @@ RenderStateCache::EraseFromMaps(
 
 // =====================================================================================================================
 // Destroys the render state cache.  Should be called during device destroy.
-// Not necessary to take the mutex in this function because, an application should ensure that no work is active on
+// Not necessary to take the locks in this function because, an application should ensure that no work is active on
 // the device, and an application is responsible for destroying / freeing any Vulkan objects that were created using
 // that device.
 void RenderStateCache::Destroy()
@@ -519,6 +561,7 @@ Pal::Result RenderStateCache::CreateStaticPalObjectState(
     const typename StateObject::CreateInfo& createInfo,
     const VkAllocationCallbacks*            pAllocator,
     VkSystemAllocationScope                 parentScope,
+    Util::RWLock*                           pLock,
     InfoMap*                                pStateMap,
     RefMap*                                 pRefMap,
     typename StateObject::PalObject*        pStates[MaxPalDevices])
@@ -528,12 +571,34 @@ Pal::Result RenderStateCache::CreateStaticPalObjectState(
         return CreatePalObjects(createInfo, pAllocator, parentScope, pStates);
     }
 
+    // Most pipelines share their state with existing ones, so first look for an existing state object while only
+    // holding the lock for reading.  Entries are only erased while the lock is held for writing.
+    {
+        Util::RWLockAuto<Util::RWLock::LockType::ReadOnly> readLock(pLock);
+
+        StateObject** ppExisting = pStateMap->FindKey(createInfo);
+
+        if ((ppExisting != nullptr) && AddStateRef(&(*ppExisting)->refCount))
+        {
+            StateObject* pState = *ppExisting;
+
+            for (uint32_t deviceIdx = 0; deviceIdx < m_pDevice->NumPalDevices(); ++deviceIdx)
+            {
+                VK_ASSERT(pState->pObjects[deviceIdx] != nullptr);
+
+                pStates[deviceIdx] = pState->pObjects[deviceIdx];
+            }
+
+            return Pal::Result::Success;
+        }
+    }
+
     // Try to find an existing static state object
     Pal::Result result = Pal::Result::Success;
     bool existed = false;
     StateObject** ppState = nullptr;
 
-    Util::MutexAuto lock(&m_mutex);
+    Util::RWLockAuto<Util::RWLock::LockType::ReadWrite> lock(pLock);
 
     // Map the createinfo to a pre-existing state object.  Allocate a new (empty) entry if one does not exist.
     result = pStateMap->FindAllocate(createInfo, &existed, &ppState);
@@ -579,18 +644,17 @@ Pal::Result RenderStateCache::CreateStaticPalObjectState(
                 FreeMem(pNewState, nullptr);
             }
         }
-        else
+
+        // Increment reference count and output PAL object handles
+        if ((result == Pal::Result::Success) && (AddStateRef(&(*ppState)->refCount) == false))
         {
-            VK_ASSERT((*ppState)->refCount > 0);
+            result = Pal::Result::ErrorOutOfMemory;
         }
 
-        // Increment reference count and output PAL object handles
         if (result == Pal::Result::Success)
         {
             auto* pState = *ppState;
 
-            pState->refCount++;
-
             for (uint32_t deviceIdx = 0; deviceIdx < m_pDevice->NumPalDevices(); ++deviceIdx)
             {
                 VK_ASSERT(pState->pObjects[deviceIdx] != nullptr);
@@ -613,6 +677,7 @@ void RenderStateCache::DestroyStaticPalObjectState(
     uint32_t                          settingsMask,
     typename StateObject::PalObject** ppStates,
     const VkAllocationCallbacks*      pAllocator,
+    Util::RWLock*                     pLock,
     InfoMap*                          pInfoMap,
     RefMap*                           pRefMap)
 {
@@ -627,31 +692,43 @@ void RenderStateCache::DestroyStaticPalObjectState(
     }
     else
     {
-        Util::MutexAuto lock(&m_mutex);
+        bool released = false;
 
-        // Find the state object containing the given PAL object.  This should always exist.
-        auto** pValue = pRefMap->FindKey(ppStates[0]);
-
-        if (pValue != nullptr)
         {
-            StateObject* pState = *pValue;
+            Util::RWLockAuto<Util::RWLock::LockType::ReadOnly> readLock(pLock);
+
+            // Find the state object containing the given PAL object.  This should always exist.
+            auto** pValue = pRefMap->FindKey(ppStates[0]);
+
+            if (pValue != nullptr)
+            {
+                VK_ASSERT((*pValue)->refCount > 0);
+
+                // Decrement the reference count and destroy the object below if it hits zero.
+                released = (Util::AtomicDecrement(&(*pValue)->refCount) == 0);
+            }
+            else
+            {
+                VK_NEVER_CALLED();
+            }
+        }
 
-            VK_ASSERT(pState->refCount > 0);
+        if (released)
+        {
+            Util::RWLockAuto<Util::RWLock::LockType::ReadWrite> lock(pLock);
 
-            // Decrement the reference count and destroy if it hits zero.
-            pState->refCount--;
+            // Another pipeline may have picked up the state again before the lock was taken for writing.
+            auto** pValue = pRefMap->FindKey(ppStates[0]);
 
-            if (pState->refCount == 0)
+            if ((pValue != nullptr) && ((*pValue)->refCount == 0))
             {
+                StateObject* pState = *pValue;
+
                 EraseFromMaps(pState, pInfoMap, pRefMap);
                 DestroyPalObjects(pState->pObjects, nullptr);
                 FreeMem(pState, nullptr);
             }
         }
-        else
-        {
-            VK_NEVER_CALLED();
-        }
     }
 }
 
@@ -669,6 +746,7 @@ Pal::Result RenderStateCache::CreateMsaaState(
         createInfo,
         pAllocator,
         parentScope,
+        &m_msaaStatesLock,
         &m_msaaStates,
         &m_msaaRefs,
         pStates);
@@ -685,6 +763,7 @@ void RenderStateCache::DestroyMsaaState(
         OptRenderStateCacheMsaaState,
         ppStates,
         pAllocator,
+        &m_msaaStatesLock,
         &m_msaaStates,
         &m_msaaRefs);
 }
@@ -703,6 +782,7 @@ Pal::Result RenderStateCache::CreateColorBlendState(
         createInfo,
         pAllocator,
         parentScope,
+        &m_colorBlendStatesLock,
         &m_colorBlendStates,
         &m_colorBlendRefs,
         pStates);
@@ -719,6 +799,7 @@ void RenderStateCache::DestroyColorBlendState(
         OptRenderStateCacheColorBlendState,
         ppStates,
         pAllocator,
+        &m_colorBlendStatesLock,
         &m_colorBlendStates,
         &m_colorBlendRefs);
 }
@@ -737,6 +818,7 @@ Pal::Result RenderStateCache::CreateDepthStencilState(
         createInfo,
         pAllocator,
         parentScope,
+        &m_depthStencilStatesLock,
         &m_depthStencilStates,
         &m_depthStencilRefs,
         pStates);
@@ -753,6 +835,7 @@ void RenderStateCache::DestroyDepthStencilState(
         OptRenderStateCacheDepthStencilState,
         ppStates,
         pAllocator,
+        &m_depthStencilStatesLock,
         &m_depthStencilStates,
         &m_depthStencilRefs);
 }
@@ -772,6 +855,7 @@ template<typename ParamInfo, typename ParamHashMap>
 uint32_t RenderStateCache::CreateStaticParamsState(
     uint32_t         enabledType,
     const ParamInfo& params,
+    Util::RWLock*    pLock,
     ParamHashMap*    pMap,
     uint32_t*        pNextId)
 {
@@ -779,7 +863,20 @@ uint32_t RenderStateCache::CreateStaticParamsState(
 
     if (IsEnabled(enabledType))
     {
-        Util::MutexAuto lock(&m_mutex);
+        // First look for existing state while only holding the lock for reading.
+        Util::RWLockAuto<Util::RWLock::LockType::ReadOnly> readLock(pLock);
+
+        StaticParamState* pExisting = pMap->FindKey(params);
+
+        if ((pExisting != nullptr) && AddStateRef(&pExisting->refCount))
+        {
+            token = pExisting->paramToken;
+        }
+    }
+
+    if (IsEnabled(enabledType) && (token == DynamicRenderStateToken))
+    {
+        Util::RWLockAuto<Util::RWLock::LockType::ReadWrite> lock(pLock);
 
         bool existed = false;
         StaticParamState* pState = nullptr;
@@ -803,15 +900,10 @@ uint32_t RenderStateCache::CreateStaticParamsState(
                     result = Pal::Result::ErrorOutOfMemory;
                 }
             }
-            else if (pState->refCount == UINT_MAX)
-            {
-                result = Pal::Result::ErrorOutOfMemory;
-            }
         }
 
-        if (result == Pal::Result::Success)
+        if ((result == Pal::Result::Success) && AddStateRef(&pState->refCount))
         {
-            pState->refCount++;
             token = pState->paramToken;
         }
     }
@@ -826,21 +918,34 @@ void RenderStateCache::DestroyStaticParamsState(
     uint32_t         enabledType,
     const ParamInfo& params,
     uint32_t         token,
+    Util::RWLock*    pLock,
     ParamHashMap*    pMap)
 {
     if (IsEnabled(enabledType) && (token != DynamicRenderStateToken))
     {
-        Util::MutexAuto lock(&m_mutex);
+        bool released = false;
+
+        {
+            Util::RWLockAuto<Util::RWLock::LockType::ReadOnly> readLock(pLock);
+
+            StaticParamState* pValue = pMap->FindKey(params);
 
-        StaticParamState* pValue = pMap->FindKey(params);
+            if (pValue != nullptr)
+            {
+                VK_ASSERT(pValue->refCount > 0);
+
+                released = (Util::AtomicDecrement(&pValue->refCount) == 0);
+            }
+        }
 
-        if (pValue != nullptr)
+        if (released)
         {
-            VK_ASSERT(pValue->refCount > 0);
+            Util::RWLockAuto<Util::RWLock::LockType::ReadWrite> lock(pLock);
 
-            pValue->refCount--;
+            // Another pipeline may have picked up the state again before the lock was taken for writing.
+            StaticParamState* pValue = pMap->FindKey(params);
 
-            if (pValue->refCount == 0)
+            if ((pValue != nullptr) && (pValue->refCount == 0))
             {
                 pMap->Erase(params);
             }
@@ -855,6 +960,7 @@ uint32_t RenderStateCache::CreateInputAssemblyState(
     return CreateStaticParamsState(
         OptRenderStateCacheInputAssemblyState,
         params,
+        &m_inputAssemblyStateLock,
         &m_inputAssemblyState,
         &m_inputAssemblyStateNextId);
 }
@@ -868,6 +974,7 @@ void RenderStateCache::DestroyInputAssemblyState(
         OptRenderStateCacheInputAssemblyState,
         params,
         token,
+        &m_inputAssemblyStateLock,
         &m_inputAssemblyState);
 }
 
@@ -878,6 +985,7 @@ uint32_t RenderStateCache::CreateTriangleRasterState(
     return CreateStaticParamsState(
         OptRenderStateCacheTriangleRasterState,
         params,
+        &m_triangleRasterStateLock,
         &m_triangleRasterState,
         &m_triangleRasterStateNextId);
 }
@@ -891,6 +999,7 @@ void RenderStateCache::DestroyTriangleRasterState(
         OptRenderStateCacheTriangleRasterState,
         params,
         token,
+        &m_triangleRasterStateLock,
         &m_triangleRasterState);
 }
 
@@ -901,6 +1010,7 @@ uint32_t RenderStateCache::CreatePointLineRasterState(
     return CreateStaticParamsState(
         OptRenderStateCacheStaticPointLineRasterState,
         params,
+        &m_pointLineRasterStateLock,
         &m_pointLineRasterState,
         &m_pointLineRasterStateNextId);
 }
@@ -914,6 +1024,7 @@ void RenderStateCache::DestroyPointLineRasterState(
         OptRenderStateCacheStaticPointLineRasterState,
         params,
         token,
+        &m_pointLineRasterStateLock,
         &m_pointLineRasterState);
 }
 
@@ -924,6 +1035,7 @@ uint32_t RenderStateCache::CreateDepthBias(
     return CreateStaticParamsState(
         OptRenderStateCacheStaticDepthBias,
         params,
+        &m_depthBiasLock,
         &m_depthBias,
         &m_depthBiasNextId);
 }
@@ -937,6 +1049,7 @@ void RenderStateCache::DestroyDepthBias(
         OptRenderStateCacheStaticDepthBias,
         params,
         token,
+        &m_depthBiasLock,
         &m_depthBias);
 }
 
@@ -947,6 +1060,7 @@ uint32_t RenderStateCache::CreateBlendConst(
     return CreateStaticParamsState(
         OptRenderStateCacheStaticBlendConst,
         params,
+        &m_blendConstLock,
         &m_blendConst,
         &m_blendConstNextId);
 }
@@ -960,6 +1074,7 @@ void RenderStateCache::DestroyBlendConst(
         OptRenderStateCacheStaticBlendConst,
         params,
         token,
+        &m_blendConstLock,
         &m_blendConst);
 }
 
@@ -970,6 +1085,7 @@ uint32_t RenderStateCache::CreateDepthBounds(
     return CreateStaticParamsState(
         OptRenderStateCacheStaticDepthBounds,
         params,
+        &m_depthBoundsLock,
         &m_depthBounds,
         &m_depthBoundsNextId);
 }
@@ -983,6 +1099,7 @@ void RenderStateCache::DestroyDepthBounds(
         OptRenderStateCacheStaticDepthBounds,
         params,
         token,
+        &m_depthBoundsLock,
         &m_depthBounds);
 }
 
@@ -993,6 +1110,7 @@ uint32_t RenderStateCache::CreateViewport(
     return CreateStaticParamsState(
         OptRenderStateCacheStaticViewport,
         params,
+        &m_viewportLock,
         &m_viewport,
         &m_viewportNextId);
 }
@@ -1006,6 +1124,7 @@ void RenderStateCache::DestroyViewport(
         OptRenderStateCacheStaticViewport,
         params,
         token,
+        &m_viewportLock,
         &m_viewport);
 }
 
@@ -1016,6 +1135,7 @@ uint32_t RenderStateCache::CreateScissorRect(
     return CreateStaticParamsState(
         OptRenderStateCacheStaticScissorRect,
         params,
+        &m_scissorRectLock,
         &m_scissorRect,
         &m_scissorRectNextId);
 }
@@ -1029,6 +1149,7 @@ void RenderStateCache::DestroyScissorRect(
         OptRenderStateCacheStaticScissorRect,
         params,
         token,
+        &m_scissorRectLock,
         &m_scissorRect);
 }
 
@@ -1039,6 +1160,7 @@ uint32_t RenderStateCache::CreateSamplePattern(
     return CreateStaticParamsState(
         OptRenderStateCacheStaticSamplePattern,
         samplePattern,
+        &m_samplePatternLock,
         &m_samplePattern,
         &m_samplePatternNextId);
 }
@@ -1052,6 +1174,7 @@ void RenderStateCache::DestroySamplePattern(
         OptRenderStateCacheStaticSamplePattern,
         samplePattern,
         token,
+        &m_samplePatternLock,
         &m_samplePattern);
 }
 
@@ -1062,6 +1185,7 @@ uint32_t RenderStateCache::CreateLineStipple(
     return CreateStaticParamsState(
         OptRenderStateCacheStaticLineStipple,
         params,
+        &m_lineStippleStateLock,
         &m_lineStippleState,
         &m_lineStippleStateNextId);
 }
@@ -1075,6 +1199,7 @@ void RenderStateCache::DestroyLineStipple(
         OptRenderStateCacheStaticLineStipple,
         params,
         token,
+        &m_lineStippleStateLock,
         &m_lineStippleState);
 }
 
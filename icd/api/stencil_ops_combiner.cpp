@@ -48,10 +48,14 @@ StencilRefMaskParams::StencilRefMaskParams()
 }
 
 // =====================================================================================================================
-void StencilOpsCombiner::PalCmdSetStencilState(CmdBuffer* pCmdBuffer)
+// Writes the combined stencil state to PAL if it differs from the last written state.  Returns false if the write was
+// skipped as redundant.
+bool StencilOpsCombiner::PalCmdSetStencilState(CmdBuffer* pCmdBuffer)
 {
     const uint32_t palDeviceMask = pCmdBuffer->GetDeviceMask();
 
+    bool written = false;
+
     if ((m_previous_state.Get64bitRef() != m_state.Get64bitRef()) ||
         (m_palDeviceMask                != palDeviceMask))
     {
@@ -65,7 +69,11 @@ void StencilOpsCombiner::PalCmdSetStencilState(CmdBuffer* pCmdBuffer)
 
         m_previous_state.Get64bitRef() = m_state.Get64bitRef();
         m_palDeviceMask                = palDeviceMask;
+
+        written = true;
     }
+
+    return written;
 }
 
 } // namespace vk
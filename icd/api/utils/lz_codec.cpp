@@ -0,0 +1,318 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "lz_codec.h"
+
+#include <string.h>
+
+namespace vk { namespace utils {
+
+static constexpr size_t   MinMatch     = 4;
+static constexpr size_t   MaxOffset    = 0xFFFF;
+static constexpr size_t   LastLiterals = 8;        // Trailing bytes that are never part of a match
+static constexpr uint32_t HashLog      = 12;
+static constexpr uint32_t NibbleMax    = 15;
+
+// =====================================================================================================================
+static uint32_t Read32(
+    const uint8_t* pData)
+{
+    uint32_t value;
+    memcpy(&value, pData, sizeof(value));
+    return value;
+}
+
+// =====================================================================================================================
+static uint32_t HashSequence(
+    uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - HashLog);
+}
+
+// =====================================================================================================================
+// Writes the 255-continued extension of a length whose token nibble is saturated.  Returns nullptr on overflow.
+static uint8_t* WriteLengthExtension(
+    uint8_t*       pOut,
+    const uint8_t* pOutEnd,
+    size_t         length)
+{
+    const size_t byteCount = (length / 255) + 1;
+
+    if (static_cast<size_t>(pOutEnd - pOut) >= byteCount)
+    {
+        memset(pOut, 255, byteCount - 1);
+        pOut += byteCount - 1;
+        *pOut++ = static_cast<uint8_t>(length % 255);
+    }
+    else
+    {
+        pOut = nullptr;
+    }
+
+    return pOut;
+}
+
+// =====================================================================================================================
+// Reads the 255-continued extension of a length whose token nibble is saturated.
+static bool ReadLengthExtension(
+    const uint8_t** ppIn,
+    const uint8_t*  pInEnd,
+    size_t*         pLength)
+{
+    uint8_t value = 255;
+
+    while ((value == 255) && (*ppIn < pInEnd))
+    {
+        value     = *(*ppIn)++;
+        *pLength += value;
+    }
+
+    return (value != 255);
+}
+
+// =====================================================================================================================
+// Emits one block.  A matchLength of 0 marks the final, literal-only block.  Returns nullptr if pDst is too small.
+static uint8_t* WriteBlock(
+    uint8_t*       pOut,
+    const uint8_t* pOutEnd,
+    const uint8_t* pLiterals,
+    size_t         literalLength,
+    size_t         offset,
+    size_t         matchLength)
+{
+    uint8_t* pToken = (pOut < pOutEnd) ? pOut++ : nullptr;
+    uint8_t  token  = static_cast<uint8_t>(((literalLength < NibbleMax) ? literalLength : NibbleMax) << 4);
+
+    pOut = (pToken != nullptr) ? pOut : nullptr;
+
+    if ((pOut != nullptr) && (literalLength >= NibbleMax))
+    {
+        pOut = WriteLengthExtension(pOut, pOutEnd, literalLength - NibbleMax);
+    }
+
+    if ((pOut != nullptr) && (static_cast<size_t>(pOutEnd - pOut) >= literalLength))
+    {
+        if (literalLength > 0)
+        {
+            memcpy(pOut, pLiterals, literalLength);
+        }
+
+        pOut += literalLength;
+    }
+    else
+    {
+        pOut = nullptr;
+    }
+
+    if ((pOut != nullptr) && (matchLength > 0))
+    {
+        const size_t matchCode = matchLength - MinMatch;
+
+        token |= static_cast<uint8_t>((matchCode < NibbleMax) ? matchCode : NibbleMax);
+
+        if ((pOutEnd - pOut) >= 2)
+        {
+            pOut[0] = static_cast<uint8_t>(offset & 0xFF);
+            pOut[1] = static_cast<uint8_t>(offset >> 8);
+            pOut   += 2;
+
+            if (matchCode >= NibbleMax)
+            {
+                pOut = WriteLengthExtension(pOut, pOutEnd, matchCode - NibbleMax);
+            }
+        }
+        else
+        {
+            pOut = nullptr;
+        }
+    }
+
+    if (pOut != nullptr)
+    {
+        *pToken = token;
+    }
+
+    return pOut;
+}
+
+// =====================================================================================================================
+size_t LzCompressBound(
+    size_t srcSize)
+{
+    // One token plus the literal length extension when nothing matches.
+    return srcSize + (srcSize / 255) + 16;
+}
+
+// =====================================================================================================================
+// Greedy single-probe compressor.  The search step grows while no match is found, so incompressible data is skipped
+// quickly.
+size_t LzCompress(
+    const void* pSrc,
+    size_t      srcSize,
+    void*       pDst,
+    size_t      dstCapacity)
+{
+    const uint8_t* pIn     = static_cast<const uint8_t*>(pSrc);
+    uint8_t*       pOut    = static_cast<uint8_t*>(pDst);
+    const uint8_t* pOutEnd = pOut + dstCapacity;
+
+    // Positions are tracked in 32 bits.
+    if (srcSize > UINT32_MAX)
+    {
+        pOut = nullptr;
+    }
+
+    size_t anchor = 0;
+
+    if ((pOut != nullptr) && (srcSize > (MinMatch + LastLiterals)))
+    {
+        uint32_t hashTable[1 << HashLog];
+        memset(hashTable, 0, sizeof(hashTable));
+
+        const size_t matchLimit = srcSize - LastLiterals;
+        size_t       pos        = 1;
+
+        while ((pos < matchLimit) && (pOut != nullptr))
+        {
+            const uint32_t sequence  = Read32(pIn + pos);
+            const uint32_t hash      = HashSequence(sequence);
+            const size_t   candidate = hashTable[hash];
+
+            hashTable[hash] = static_cast<uint32_t>(pos);
+
+            if ((candidate < pos) && ((pos - candidate) <= MaxOffset) && (Read32(pIn + candidate) == sequence))
+            {
+                size_t matchLength = MinMatch;
+
+                while (((pos + matchLength) < matchLimit) && (pIn[candidate + matchLength] == pIn[pos + matchLength]))
+                {
+                    matchLength++;
+                }
+
+                pOut = WriteBlock(pOut, pOutEnd, pIn + anchor, pos - anchor, pos - candidate, matchLength);
+
+                pos   += matchLength;
+                anchor = pos;
+            }
+            else
+            {
+                pos += 1 + ((pos - anchor) >> 6);
+            }
+        }
+    }
+
+    if (pOut != nullptr)
+    {
+        pOut = WriteBlock(pOut, pOutEnd, pIn + anchor, srcSize - anchor, 0, 0);
+    }
+
+    return (pOut != nullptr) ? static_cast<size_t>(pOut - static_cast<uint8_t*>(pDst)) : 0;
+}
+
+// =====================================================================================================================
+bool LzDecompress(
+    const void* pSrc,
+    size_t      srcSize,
+    void*       pDst,
+    size_t      dstSize)
+{
+    const uint8_t* pIn      = static_cast<const uint8_t*>(pSrc);
+    const uint8_t* pInEnd   = pIn + srcSize;
+    uint8_t* const pOutBase = static_cast<uint8_t*>(pDst);
+    uint8_t*       pOut     = pOutBase;
+    uint8_t* const pOutEnd  = pOutBase + dstSize;
+    bool           valid    = true;
+
+    while (valid && (pIn < pInEnd))
+    {
+        const uint8_t token         = *pIn++;
+        size_t        literalLength = token >> 4;
+
+        if (literalLength == NibbleMax)
+        {
+            valid = ReadLengthExtension(&pIn, pInEnd, &literalLength);
+        }
+
+        valid = valid &&
+                (literalLength <= static_cast<size_t>(pInEnd - pIn)) &&
+                (literalLength <= static_cast<size_t>(pOutEnd - pOut));
+
+        if (valid && (literalLength > 0))
+        {
+            memcpy(pOut, pIn, literalLength);
+            pIn  += literalLength;
+            pOut += literalLength;
+        }
+
+        // The final block has no match
+        if (valid && (pIn < pInEnd))
+        {
+            size_t offset      = 0;
+            size_t matchLength = token & NibbleMax;
+
+            valid = ((pInEnd - pIn) >= 2);
+
+            if (valid)
+            {
+                offset = pIn[0] | (static_cast<size_t>(pIn[1]) << 8);
+                pIn   += 2;
+                valid  = (offset != 0) && (offset <= static_cast<size_t>(pOut - pOutBase));
+            }
+
+            if (valid && (matchLength == NibbleMax))
+            {
+                valid = ReadLengthExtension(&pIn, pInEnd, &matchLength);
+            }
+
+            matchLength += MinMatch;
+
+            valid = valid && (matchLength <= static_cast<size_t>(pOutEnd - pOut));
+
+            if (valid)
+            {
+                const uint8_t* pMatch = pOut - offset;
+
+                if (offset >= matchLength)
+                {
+                    memcpy(pOut, pMatch, matchLength);
+                }
+                else
+                {
+                    // Overlapping copy repeats the last offset bytes
+                    for (size_t i = 0; i < matchLength; ++i)
+                    {
+                        pOut[i] = pMatch[i];
+                    }
+                }
+
+                pOut += matchLength;
+            }
+        }
+    }
+
+    return valid && (pOut == pOutEnd);
+}
+
+} } // namespace vk::utils
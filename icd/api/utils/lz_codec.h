@@ -0,0 +1,70 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+**************************************************************************************************
+* @file  lz_codec.h
+* @brief Fast LZ77 byte codec used to compress pipeline cache entries.
+**************************************************************************************************
+*/
+#ifndef __UTILS_LZ_CODEC_H__
+#define __UTILS_LZ_CODEC_H__
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace vk
+{
+
+namespace utils
+{
+
+// The stream is a sequence of LZ4-style blocks: a token byte holding the literal length (high nibble) and the match
+// length minus MinMatch (low nibble), each extended by 255-continued bytes when the nibble is 15, followed by the
+// literals and a 16-bit little-endian match offset.  The final block carries literals only.
+
+// Returns the worst-case compressed size of srcSize bytes.
+size_t LzCompressBound(size_t srcSize);
+
+// Compresses pSrc into pDst.  Returns the compressed size, or 0 if the result does not fit into dstCapacity bytes.
+size_t LzCompress(
+    const void* pSrc,
+    size_t      srcSize,
+    void*       pDst,
+    size_t      dstCapacity);
+
+// Decompresses pSrc into exactly dstSize bytes at pDst.  Returns false if the stream is malformed or does not
+// decompress to dstSize bytes.
+bool LzDecompress(
+    const void* pSrc,
+    size_t      srcSize,
+    void*       pDst,
+    size_t      dstSize);
+
+};
+
+};
+
+#endif /* __UTILS_LZ_CODEC_H__ */
@@ -62,6 +62,40 @@
 
 namespace vk
 {
+
+#if ICD_CMDBUF_STATS
+// Column names used when dumping CmdBufferStats; must match the order of the CmdBufferStat enum.
+const char* const CmdBufferStatNames[CmdBufferStatCount] =
+{
+    "BindPipeline",
+    "BindIndexData",
+    "BindMsaaState",
+    "BindColorBlendState",
+    "BindDepthStencilState",
+    "SetUserData",
+    "SetMsaaQuadSamplePattern",
+    "Draw",
+    "DrawIndexed",
+    "DrawIndirect",
+    "Dispatch",
+    "DispatchIndirect",
+    "Barrier",
+    "CopyBuffer",
+    "UpdateBuffer",
+    "FillBuffer",
+    "CopyImage",
+    "ScaledCopyImage",
+    "CopyMemoryToImage",
+    "CopyImageToMemory",
+    "ClearColorImage",
+    "ClearDepthStencil",
+    "ResolveImage",
+    "SetResetEvent",
+    "RedundantPipelineBind",
+    "RedundantStateBind",
+    "ElidedDynamicState",
+};
+#endif
 namespace
 {
 
@@ -357,6 +391,8 @@ CmdBuffer::CmdBuffer(
     m_isRecording(false),
     m_needResetState(true),
     m_recordingResult(VK_SUCCESS),
+    m_elidedDynamicStateCount(0),
+    m_lastCmdDataSize(0),
     m_barrierPolicy(barrierPolicy),
     m_pSqttState(nullptr),
     m_renderPassInstance(pDevice->VkInstance()->Allocator()),
@@ -612,6 +648,8 @@ void CmdBuffer::PalCmdBufferDestroy()
 // =====================================================================================================================
 void CmdBuffer::PalCmdBindIndexData(Buffer* pBuffer, Pal::gpusize offset, Pal::IndexType indexType)
 {
+    CountStat(CmdBufferStatBindIndexData);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
@@ -628,6 +666,8 @@ void CmdBuffer::PalCmdBindIndexData(Buffer* pBuffer, Pal::gpusize offset, Pal::I
 // =====================================================================================================================
 void CmdBuffer::PalCmdUnbindIndexData(Pal::IndexType indexType)
 {
+    CountStat(CmdBufferStatBindIndexData);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
@@ -637,6 +677,116 @@ void CmdBuffer::PalCmdUnbindIndexData(Pal::IndexType indexType)
     }
 }
 
+// =====================================================================================================================
+// Copies new user data values into a shadow and widens the given dirty range to cover every register whose value
+// changed.  Registers at or beyond the high-water mark have never been programmed and are always considered dirty.
+void CmdBuffer::UpdateUserDataShadow(
+    uint32_t        regOffset,
+    uint32_t        regCount,
+    const uint32_t* pValues,
+    uint32_t        writtenRegCount,
+    uint32_t*       pShadow,
+    uint32_t*       pDirtyBegin,
+    uint32_t*       pDirtyEnd)
+{
+    uint32_t changedBegin = UINT32_MAX;
+    uint32_t changedEnd   = 0;
+
+    for (uint32_t i = 0; i < regCount; ++i)
+    {
+        const uint32_t reg = regOffset + i;
+
+        if ((reg >= writtenRegCount) || (pShadow[reg] != pValues[i]))
+        {
+            pShadow[reg] = pValues[i];
+
+            changedBegin = Util::Min(changedBegin, reg);
+            changedEnd   = reg + 1;
+        }
+    }
+
+    if (changedEnd != 0)
+    {
+        if (*pDirtyEnd == 0)
+        {
+            *pDirtyBegin = changedBegin;
+            *pDirtyEnd   = changedEnd;
+        }
+        else
+        {
+            *pDirtyBegin = Util::Min(*pDirtyBegin, changedBegin);
+            *pDirtyEnd   = Util::Max(*pDirtyEnd, changedEnd);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Writes any descriptor set bindings and push constants that were shadowed since the last draw or dispatch.  Must be
+// called before every draw or dispatch on the given bind point.
+void CmdBuffer::FlushUserData(
+    PipelineBind           apiBindPoint,
+    Pal::PipelineBindPoint palBindPoint)
+{
+    const PipelineBindState& bindState = m_state.allGpuState.pipelineState[apiBindPoint];
+
+    if ((bindState.dirtySetRegEnd | bindState.dirtyPushConstEnd) != 0)
+    {
+        FlushDirtyUserData(apiBindPoint, palBindPoint);
+    }
+}
+
+// =====================================================================================================================
+// Issues a single CmdSetUserData for the dirty range of set binding registers and a single one for the dirty range of
+// push constant registers.  Registers outside of the current layout are dropped; a future layout change that makes
+// them visible will rebind them through RebindCompatibleUserData().
+void CmdBuffer::FlushDirtyUserData(
+    PipelineBind           apiBindPoint,
+    Pal::PipelineBindPoint palBindPoint)
+{
+    PipelineBindState* pBindState        = &m_state.allGpuState.pipelineState[apiBindPoint];
+    const UserDataLayout& userDataLayout = pBindState->userDataLayout;
+
+    VK_ASSERT(PalPipelineBindingOwnedBy(palBindPoint, apiBindPoint));
+
+    const uint32_t setRegEnd = Util::Min(pBindState->dirtySetRegEnd, userDataLayout.setBindingRegCount);
+
+    if (pBindState->dirtySetRegBegin < setRegEnd)
+    {
+        CountStat(CmdBufferStatSetUserData);
+
+        uint32_t deviceIdx = 0;
+        do
+        {
+            PalCmdBuffer(deviceIdx)->CmdSetUserData(
+                palBindPoint,
+                userDataLayout.setBindingRegBase + pBindState->dirtySetRegBegin,
+                setRegEnd - pBindState->dirtySetRegBegin,
+                &(m_state.perGpuState[deviceIdx].setBindingData[apiBindPoint][pBindState->dirtySetRegBegin]));
+
+            deviceIdx++;
+        }
+        while (deviceIdx < m_pDevice->NumPalDevices());
+    }
+
+    const uint32_t pushConstEnd = Util::Min(pBindState->dirtyPushConstEnd, userDataLayout.pushConstRegCount);
+
+    if (pBindState->dirtyPushConstBegin < pushConstEnd)
+    {
+        // Push constant data is replicated for all devices.
+        PalCmdBufferSetUserData(
+            palBindPoint,
+            userDataLayout.pushConstRegBase + pBindState->dirtyPushConstBegin,
+            pushConstEnd - pBindState->dirtyPushConstBegin,
+            0,
+            &(pBindState->pushConstData[pBindState->dirtyPushConstBegin]));
+    }
+
+    pBindState->dirtySetRegBegin    = 0;
+    pBindState->dirtySetRegEnd      = 0;
+    pBindState->dirtyPushConstBegin = 0;
+    pBindState->dirtyPushConstEnd   = 0;
+}
+
 // =====================================================================================================================
 void CmdBuffer::PalCmdDraw(
     uint32_t firstVertex,
@@ -644,10 +794,14 @@ void CmdBuffer::PalCmdDraw(
     uint32_t firstInstance,
     uint32_t instanceCount)
 {
+    CountStat(CmdBufferStatDraw);
+
     // Currently only Vulkan graphics pipelines use PAL graphics pipeline bindings so there's no need to
     // add a delayed validation check for graphics.
     VK_ASSERT(PalPipelineBindingOwnedBy(Pal::PipelineBindPoint::Graphics, PipelineBindGraphics));
 
+    FlushUserData(PipelineBindGraphics, Pal::PipelineBindPoint::Graphics);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
@@ -668,10 +822,14 @@ void CmdBuffer::PalCmdDrawIndexed(
     uint32_t firstInstance,
     uint32_t instanceCount)
 {
+    CountStat(CmdBufferStatDrawIndexed);
+
     // Currently only Vulkan graphics pipelines use PAL graphics pipeline bindings so there's no need to
     // add a delayed validation check for graphics.
     VK_ASSERT(PalPipelineBindingOwnedBy(Pal::PipelineBindPoint::Graphics, PipelineBindGraphics));
 
+    FlushUserData(PipelineBindGraphics, Pal::PipelineBindPoint::Graphics);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
@@ -691,6 +849,10 @@ void CmdBuffer::PalCmdDispatch(
     uint32_t y,
     uint32_t z)
 {
+    CountStat(CmdBufferStatDispatch);
+
+    FlushUserData(PipelineBindCompute, Pal::PipelineBindPoint::Compute);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
@@ -707,6 +869,10 @@ void CmdBuffer::PalCmdDispatchOffset(
     uint32_t size_y,
     uint32_t size_z)
 {
+    CountStat(CmdBufferStatDispatch);
+
+    FlushUserData(PipelineBindCompute, Pal::PipelineBindPoint::Compute);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
@@ -719,6 +885,10 @@ void CmdBuffer::PalCmdDispatchIndirect(
     Buffer*      pBuffer,
     Pal::gpusize offset)
 {
+    CountStat(CmdBufferStatDispatchIndirect);
+
+    FlushUserData(PipelineBindCompute, Pal::PipelineBindPoint::Compute);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
@@ -740,6 +910,8 @@ void CmdBuffer::PalCmdCopyBuffer(
     uint32_t               regionCount,
     Pal::MemoryCopyRegion* pRegions)
 {
+    CountStat(CmdBufferStatCopyBuffer);
+
     if (m_pDevice->IsMultiGpu() == false)
     {
         Pal::IGpuMemory* const pSrcMemory = pSrcBuffer->PalMemory(DefaultDeviceIndex);
@@ -776,6 +948,8 @@ void CmdBuffer::PalCmdUpdateBuffer(
     Pal::gpusize    size,
     const uint32_t* pData)
 {
+    CountStat(CmdBufferStatUpdateBuffer);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
@@ -792,6 +966,8 @@ void CmdBuffer::PalCmdFillBuffer(
     Pal::gpusize    size,
     uint32_t        data)
 {
+    CountStat(CmdBufferStatFillBuffer);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
@@ -810,6 +986,8 @@ void CmdBuffer::PalCmdCopyImage(
     uint32_t              regionCount,
     Pal::ImageCopyRegion* pRegions)
 {
+    CountStat(CmdBufferStatCopyImage);
+
     if (m_pDevice->IsMultiGpu() == false)
     {
         PalCmdBuffer(DefaultDeviceIndex)->CmdCopyImage(
@@ -846,6 +1024,8 @@ void CmdBuffer::PalCmdScaledCopyImage(
     const Image* const   pDstImage,
     Pal::ScaledCopyInfo& copyInfo)
 {
+    CountStat(CmdBufferStatScaledCopyImage);
+
     if (m_pDevice->IsMultiGpu() == false)
     {
         copyInfo.pSrcImage = pSrcImage->PalImage(DefaultDeviceIndex);
@@ -878,6 +1058,8 @@ void CmdBuffer::PalCmdCopyMemoryToImage(
     uint32_t                    regionCount,
     Pal::MemoryImageCopyRegion* pRegions)
 {
+    CountStat(CmdBufferStatCopyMemoryToImage);
+
     if (m_pDevice->IsMultiGpu() == false)
     {
         PalCmdBuffer(DefaultDeviceIndex)->CmdCopyMemoryToImage(
@@ -912,6 +1094,8 @@ void CmdBuffer::PalCmdCopyImageToMemory(
     uint32_t                    regionCount,
     Pal::MemoryImageCopyRegion* pRegions)
 {
+    CountStat(CmdBufferStatCopyImageToMemory);
+
     if (m_pDevice->IsMultiGpu() == false)
     {
         PalCmdBuffer(DefaultDeviceIndex)->CmdCopyImageToMemory(
@@ -990,6 +1174,16 @@ VkResult CmdBuffer::Begin(
             palFlags.optimizeOneTimeSubmit = (pInfo->flags & VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT) ? 1 : 0;
             palFlags.optimizeExclusiveSubmit = (pInfo->flags & VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT) ? 0 : 1;
 
+            // PAL chains into exclusive-submit nested command buffers but copies the commands of the others inline
+            // into the caller's command stream.  If the last recording of this secondary was small enough, ask for
+            // the copy instead so the primary doesn't pay for chaining out to and back from a few packets.
+            if (m_is2ndLvl &&
+                (m_lastCmdDataSize != 0) &&
+                (m_lastCmdDataSize <= m_pDevice->GetRuntimeSettings().secondaryCmdBufferInlineThreshold))
+            {
+                palFlags.optimizeExclusiveSubmit = 0;
+            }
+
             switch (m_pDevice->GetRuntimeSettings().optimizeCmdbufMode)
             {
             case EnableOptimizeForRenderPassContinue:
@@ -1139,6 +1333,21 @@ VkResult CmdBuffer::End(void)
 
     m_isRecording = false;
 
+    if (m_is2ndLvl && (m_pDevice->GetRuntimeSettings().secondaryCmdBufferInlineThreshold != 0))
+    {
+        // Remember how large this recording was so the next one can decide whether it should be inlined.
+        m_lastCmdDataSize = 0;
+
+        utils::IterateMask deviceGroup(m_cbBeginDeviceMask);
+        while (deviceGroup.Iterate())
+        {
+            const uint32_t deviceIdx = deviceGroup.Index();
+
+            m_lastCmdDataSize = Util::Max(m_lastCmdDataSize,
+                                          PalCmdBuffer(deviceIdx)->GetUsedSize(Pal::CommandDataAlloc));
+        }
+    }
+
     return (m_recordingResult == VK_SUCCESS ? PalToVkResult(result) : m_recordingResult);
 }
 
@@ -1152,6 +1361,8 @@ void CmdBuffer::ResetPipelineState()
 
     memset(&m_state.allGpuState.staticTokens, 0u, sizeof(m_state.allGpuState.staticTokens));
 
+    m_state.allGpuState.dynamicStateValid.u32All = 0;
+
     uint32_t bindIdx = 0;
     do
     {
@@ -1159,8 +1370,12 @@ void CmdBuffer::ResetPipelineState()
             0,
             sizeof(m_state.allGpuState.pipelineState[bindIdx].userDataLayout));
 
-        m_state.allGpuState.pipelineState[bindIdx].boundSetCount    = 0;
-        m_state.allGpuState.pipelineState[bindIdx].pushedConstCount = 0;
+        m_state.allGpuState.pipelineState[bindIdx].boundSetCount       = 0;
+        m_state.allGpuState.pipelineState[bindIdx].pushedConstCount    = 0;
+        m_state.allGpuState.pipelineState[bindIdx].dirtySetRegBegin    = 0;
+        m_state.allGpuState.pipelineState[bindIdx].dirtySetRegEnd      = 0;
+        m_state.allGpuState.pipelineState[bindIdx].dirtyPushConstBegin = 0;
+        m_state.allGpuState.pipelineState[bindIdx].dirtyPushConstEnd   = 0;
 
         bindIdx++;
     }
@@ -1216,6 +1431,12 @@ void CmdBuffer::ResetState()
     m_renderPassInstance.flags.u32All = 0;
 
     m_recordingResult = VK_SUCCESS;
+
+    m_elidedDynamicStateCount = 0;
+
+#if ICD_CMDBUF_STATS
+    memset(&m_stats, 0, sizeof(m_stats));
+#endif
 }
 
 // =====================================================================================================================
@@ -1280,6 +1501,8 @@ void CmdBuffer::BindPipeline(
 {
     DbgBarrierPreCmd(DbgBarrierBindPipeline);
 
+    CountStat(CmdBufferStatBindPipeline);
+
     static_assert(VK_PIPELINE_BIND_POINT_RANGE_SIZE == 2, "New pipeline bind point added");
 
     PipelineBind apiBindPoint;
@@ -1340,6 +1563,10 @@ void CmdBuffer::BindPipeline(
                     m_state.allGpuState.pGraphicsPipeline = pPipeline;
                     pNewUserDataLayout = pPipeline->GetUserDataLayout();
                 }
+                else
+                {
+                    CountStat(CmdBufferStatRedundantPipelineBind);
+                }
             }
             else
             {
@@ -1429,15 +1656,21 @@ void CmdBuffer::RebindCompatibleUserData(
 {
     VK_ASSERT(flags != 0);
 
-    const PipelineBindState& bindState   = m_state.allGpuState.pipelineState[apiBindPoint];
-    const UserDataLayout& userDataLayout = bindState.userDataLayout;
+    PipelineBindState* pBindState        = &m_state.allGpuState.pipelineState[apiBindPoint];
+    const UserDataLayout& userDataLayout = pBindState->userDataLayout;
 
     if ((flags & RebindUserDataDescriptorSets) != 0)
     {
-        const uint32_t count = Util::Min(userDataLayout.setBindingRegCount, bindState.boundSetCount);
+        const uint32_t count = Util::Min(userDataLayout.setBindingRegCount, pBindState->boundSetCount);
+
+        // Every shadowed set binding visible to this layout is written below, so nothing is left to flush.
+        pBindState->dirtySetRegBegin = 0;
+        pBindState->dirtySetRegEnd   = 0;
 
         if (count > 0)
         {
+            CountStat(CmdBufferStatSetUserData);
+
             uint32_t deviceIdx = 0;
             do
             {
@@ -1453,7 +1686,10 @@ void CmdBuffer::RebindCompatibleUserData(
 
     if ((flags & RebindUserDataPushConstants) != 0)
     {
-        const uint32_t count = Util::Min(userDataLayout.pushConstRegCount, bindState.pushedConstCount);
+        const uint32_t count = Util::Min(userDataLayout.pushConstRegCount, pBindState->pushedConstCount);
+
+        pBindState->dirtyPushConstBegin = 0;
+        pBindState->dirtyPushConstEnd   = 0;
 
         if (count > 0)
         {
@@ -1466,7 +1702,7 @@ void CmdBuffer::RebindCompatibleUserData(
                 userDataLayout.pushConstRegBase,
                 count,
                 perDeviceStride,
-                bindState.pushConstData);
+                pBindState->pushConstData);
         }
     }
 }
@@ -1491,6 +1727,19 @@ void CmdBuffer::ExecuteCommands(
             Pal::ICmdBuffer* pPalNestedCmdBuffer = pInteralCmdBuf->PalCmdBuffer(deviceIdx);
             PalCmdBuffer(deviceIdx)->CmdExecuteNestedCmdBuffers(1, &pPalNestedCmdBuffer);
         }
+
+#if ICD_CMDBUF_STATS
+        // Queue::LogCmdBufferStats() only sees the primary command buffers, so the work of the secondary command
+        // buffer is accounted to this one every time it is executed.
+        const CmdBufferStats& nestedStats = pInteralCmdBuf->GetStats();
+
+        for (uint32_t stat = 0; stat < CmdBufferStatCount; ++stat)
+        {
+            m_stats.counters[stat] += nestedStats.counters[stat];
+        }
+
+        m_stats.counters[CmdBufferStatElidedDynamicState] += pInteralCmdBuf->GetElidedDynamicStateCount();
+#endif
     }
 
     // Executing secondary command buffer will clear the states of Graphic Pipeline
@@ -1590,9 +1839,13 @@ void CmdBuffer::BindDescriptorSets(
         // Get user data register information from the given pipeline layout
         const PipelineLayout::Info& layoutInfo = pLayout->GetInfo();
 
-        // Update descriptor set binding data shadow.
+        // Update descriptor set binding data shadow.  Registers whose values actually change are accumulated into the
+        // dirty range and written with a single CmdSetUserData at the next draw or dispatch.  Rebinding the same sets
+        // (and dynamic offsets) leaves the dirty range untouched.
         VK_ASSERT((firstSet + setCount) <= layoutInfo.setCount);
 
+        const uint32_t writtenRegCount = pBindState->boundSetCount;
+
         for (uint32_t i = 0; i < setCount; ++i)
         {
             // Compute set binding point index
@@ -1606,18 +1859,30 @@ void CmdBuffer::BindDescriptorSets(
             {
                 // NOTE: We currently have to supply patched SRDs directly in used data registers. If we'll have proper
                 // support for dynamic descriptors in SC then we'll only need to write the dynamic offsets directly.
+                uint64_t dynDescData[MaxDynDescRegCount / 2];
+
+                VK_ASSERT(setLayoutInfo.dynDescDataRegCount <= MaxDynDescRegCount);
+
                 uint32_t deviceIdx = 0;
                 do
                 {
                     DescriptorSet<numPalDevices>::PatchedDynamicDataFromHandle(
                         pDescriptorSets[i],
                         deviceIdx,
-                        &(m_state.perGpuState[deviceIdx].
-                            setBindingData[apiBindPoint][setLayoutInfo.dynDescDataRegOffset]),
+                        reinterpret_cast<uint32_t*>(dynDescData),
                         pDynamicOffsets,
                         setLayoutInfo.dynDescCount,
                         robustBufferAccess);
 
+                    UpdateUserDataShadow(
+                        setLayoutInfo.dynDescDataRegOffset,
+                        setLayoutInfo.dynDescDataRegCount,
+                        reinterpret_cast<const uint32_t*>(dynDescData),
+                        writtenRegCount,
+                        m_state.perGpuState[deviceIdx].setBindingData[apiBindPoint],
+                        &pBindState->dirtySetRegBegin,
+                        &pBindState->dirtySetRegEnd);
+
                     deviceIdx++;
                 } while (deviceIdx < numPalDevices);
 
@@ -1631,11 +1896,21 @@ void CmdBuffer::BindDescriptorSets(
                 uint32_t deviceIdx = 0;
                 do
                 {
+                    uint32_t setPtr;
+
                     DescriptorSet<numPalDevices>::UserDataPtrValueFromHandle(
                         pDescriptorSets[i],
                         deviceIdx,
-                        &(m_state.perGpuState[deviceIdx].
-                            setBindingData[apiBindPoint][setLayoutInfo.setPtrRegOffset]));
+                        &setPtr);
+
+                    UpdateUserDataShadow(
+                        setLayoutInfo.setPtrRegOffset,
+                        PipelineLayout::SetPtrRegCount,
+                        &setPtr,
+                        writtenRegCount,
+                        m_state.perGpuState[deviceIdx].setBindingData[apiBindPoint],
+                        &pBindState->dirtySetRegBegin,
+                        &pBindState->dirtySetRegEnd);
 
                     deviceIdx++;
                 } while (deviceIdx < numPalDevices);
@@ -1643,43 +1918,13 @@ void CmdBuffer::BindDescriptorSets(
         }
 
         // Figure out the total range of user data registers written by this sequence of descriptor set binds
-        const PipelineLayout::SetUserDataLayout& firstSetLayout = layoutInfo.setUserData[firstSet];
         const PipelineLayout::SetUserDataLayout& lastSetLayout = layoutInfo.setUserData[firstSet + setCount - 1];
 
-        const uint32_t rangeOffsetBegin = firstSetLayout.firstRegOffset;
         const uint32_t rangeOffsetEnd = lastSetLayout.firstRegOffset + lastSetLayout.totalRegCount;
 
         // Update the high watermark of number of user data entries written for currently bound descriptor sets and
         // their dynamic offsets in the current command buffer state.
         pBindState->boundSetCount = Util::Max(pBindState->boundSetCount, rangeOffsetEnd);
-
-        // Descriptor set with zero resource binding is allowed in spec, so we need to check this and only proceed when
-        // there are at least 1 user data to update.
-        const uint32_t rangeRegCount = rangeOffsetEnd - rangeOffsetBegin;
-
-        if (rangeRegCount > 0)
-        {
-            // Program the user data register only if the current user data layout base matches that of the given
-            // layout.  Otherwise, what's happening is that the application is binding descriptor sets for a future
-            // pipeline layout (e.g. at the top of the command buffer) and this register write will be redundant.  A
-            // future vkCmdBindPipeline will reprogram the user data register.
-            if (PalPipelineBindingOwnedBy(palBindPoint, apiBindPoint) &&
-                (pBindState->userDataLayout.setBindingRegBase == layoutInfo.userDataLayout.setBindingRegBase))
-            {
-                uint32_t deviceIdx = 0;
-                do
-                {
-                    PalCmdBuffer(deviceIdx)->CmdSetUserData(
-                        palBindPoint,
-                        pBindState->userDataLayout.setBindingRegBase + rangeOffsetBegin,
-                        rangeRegCount,
-                        &(m_state.perGpuState[deviceIdx].setBindingData[apiBindPoint][rangeOffsetBegin]));
-
-                    deviceIdx++;
-                }
-                while (deviceIdx < numPalDevices);
-            }
-        }
     }
 
     DbgBarrierPostCmd(DbgBarrierBindSetsPushConstants);
@@ -1857,6 +2102,10 @@ void CmdBuffer::DrawIndirect(
         const Pal::gpusize paramOffset = pBuffer->MemOffset() + offset;
         Pal::gpusize countVirtAddr = 0;
 
+        CountStat(CmdBufferStatDrawIndirect);
+
+        FlushUserData(PipelineBindGraphics, Pal::PipelineBindPoint::Graphics);
+
         utils::IterateMask deviceGroup(m_curDeviceMask);
 
         while (deviceGroup.Iterate())
@@ -2602,6 +2851,8 @@ void CmdBuffer::PalCmdClearColorImage(
     const Pal::Box*         pBoxes,
     uint32_t                flags)
 {
+    CountStat(CmdBufferStatClearColorImage);
+
     DbgBarrierPreCmd(DbgBarrierClearColor);
 
     PreBltBindMsaaState(image);
@@ -2641,6 +2892,8 @@ void CmdBuffer::PalCmdClearDepthStencil(
     const Pal::Rect*        pRects,
     uint32_t                flags)
 {
+    CountStat(CmdBufferStatClearDepthStencil);
+
     DbgBarrierPreCmd(DbgBarrierClearDepth);
 
     PreBltBindMsaaState(image);
@@ -2674,6 +2927,8 @@ void CmdBuffer::PalCmdResetEvent(
     EventContainer_T*       pEvent,
     Pal::HwPipePoint        resetPoint)
 {
+    CountStat(CmdBufferStatSetResetEvent);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
@@ -2689,6 +2944,8 @@ void CmdBuffer::PalCmdSetEvent(
     EventContainer_T*       pEvent,
     Pal::HwPipePoint        setPoint)
 {
+    CountStat(CmdBufferStatSetResetEvent);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
@@ -2710,6 +2967,8 @@ void CmdBuffer::PalCmdResolveImage(
     const Pal::ImageResolveRegion* pRegions,
     uint32_t                       deviceMask)
 {
+    CountStat(CmdBufferStatResolveImage);
+
     DbgBarrierPreCmd(DbgBarrierResolve);
 
     PreBltBindMsaaState(srcImage);
@@ -3621,6 +3880,8 @@ void CmdBuffer::PalCmdBarrier(
     const Pal::BarrierInfo& info,
     uint32_t                deviceMask)
 {
+    CountStat(CmdBufferStatBarrier);
+
     // If you trip this assert, you've forgotten to populate a value for this field.  You should use one of the
     // RgpBarrierReason enum values from sqtt_rgp_annotations.h.  Preferably you should add a new one as described
     // in the header, but temporarily you may use the generic "unknown" reason so as not to block your main code change.
@@ -3654,6 +3915,8 @@ void CmdBuffer::PalCmdBarrier(
     const Image** const           pTransitionImages,
     uint32_t                      deviceMask)
 {
+    CountStat(CmdBufferStatBarrier);
+
     // If you trip this assert, you've forgot to populate a value for this field.  You should use one of the
     // RgpBarrierReason enum values from sqtt_rgp_annotations.h.  Preferably you should add a new one as described
     // in the header, but temporarily you may use the generic "unknown" reason so as not to block you.
@@ -3711,6 +3974,8 @@ void CmdBuffer::PalCmdSetMsaaQuadSamplePattern(
     uint32_t                          numSamplesPerPixel,
     const Pal::MsaaQuadSamplePattern& quadSamplePattern)
 {
+    CountStat(CmdBufferStatSetMsaaQuadSamplePattern);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
@@ -4931,44 +5196,24 @@ void CmdBuffer::EndRenderPass()
 // =====================================================================================================================
 VK_INLINE void CmdBuffer::WritePushConstants(
     PipelineBind           apiBindPoint,
-    Pal::PipelineBindPoint palBindPoint,
-    const PipelineLayout*  pLayout,
     uint32_t               startInDwords,
     uint32_t               lengthInDwords,
     const uint32_t* const  pInputValues)
 {
     PipelineBindState* pBindState = &m_state.allGpuState.pipelineState[apiBindPoint];
-    Pal::uint32* pUserData = reinterpret_cast<Pal::uint32*>(&pBindState->pushConstData[0]);
-    uint32_t* pUserDataPtr = pUserData + startInDwords;
 
-    for (uint32_t i = 0; i < lengthInDwords; i++)
-    {
-        pUserDataPtr[i] = pInputValues[i];
-    }
+    // Only constants that actually change are added to the dirty range; they are written to the PAL command buffer at
+    // the next draw or dispatch (or by the vkCmdBindPipeline rebind if the layout changes before then).
+    UpdateUserDataShadow(
+        startInDwords,
+        lengthInDwords,
+        pInputValues,
+        pBindState->pushedConstCount,
+        pBindState->pushConstData,
+        &pBindState->dirtyPushConstBegin,
+        &pBindState->dirtyPushConstEnd);
 
     pBindState->pushedConstCount = Util::Max(pBindState->pushedConstCount, startInDwords + lengthInDwords);
-
-    const UserDataLayout& userDataLayout = pLayout->GetInfo().userDataLayout;
-
-    // Program the user data register only if the current user data layout base matches that of the given
-    // layout.  Otherwise, what's happening is that the application is pushing constants for a future
-    // pipeline layout (e.g. at the top of the command buffer) and this register write will be redundant because
-    // a future vkCmdBindPipeline will reprogram the user data registers during the rebase.
-    if (PalPipelineBindingOwnedBy(palBindPoint, apiBindPoint) &&
-        pBindState->userDataLayout.pushConstRegBase == userDataLayout.pushConstRegBase)
-    {
-        utils::IterateMask deviceGroup(m_curDeviceMask);
-        while (deviceGroup.Iterate())
-        {
-            const uint32_t deviceIdx = deviceGroup.Index();
-
-            PalCmdBuffer(deviceIdx)->CmdSetUserData(
-                palBindPoint,
-                pBindState->userDataLayout.pushConstRegBase + startInDwords,
-                lengthInDwords,
-                pUserDataPtr);
-        }
-    }
 }
 
 // =====================================================================================================================
@@ -4987,15 +5232,11 @@ void CmdBuffer::PushConstants(
 
     const uint32_t* const pInputValues = reinterpret_cast<const uint32_t*>(values);
 
-    const PipelineLayout* pLayout = PipelineLayout::ObjectFromHandle(layout);
-
     stageFlags &= m_validShaderStageFlags;
 
     if ((stageFlags & VK_SHADER_STAGE_COMPUTE_BIT) != 0)
     {
         WritePushConstants(PipelineBindCompute,
-                           Pal::PipelineBindPoint::Compute,
-                           pLayout,
                            startInDwords,
                            lengthInDwords,
                            pInputValues);
@@ -5004,8 +5245,6 @@ void CmdBuffer::PushConstants(
     if ((stageFlags & VK_SHADER_STAGE_ALL_GRAPHICS) != 0)
     {
         WritePushConstants(PipelineBindGraphics,
-                           Pal::PipelineBindPoint::Graphics,
-                           pLayout,
                            startInDwords,
                            lengthInDwords,
                            pInputValues);
@@ -5029,20 +5268,37 @@ void CmdBuffer::SetViewport(
     const bool khrMaintenance1 = ((m_pDevice->VkPhysicalDevice(DefaultDeviceIndex)->GetEnabledAPIVersion() >= VK_MAKE_VERSION(1, 1, 0)) ||
                                   m_pDevice->IsExtensionEnabled(DeviceExtensions::KHR_MAINTENANCE1));
 
+    bool redundant = (m_state.allGpuState.dynamicStateValid.viewports != 0) &&
+                     (m_state.allGpuState.staticTokens.viewports == DynamicRenderStateToken);
+
     for (uint32_t i = 0; i < viewportCount; ++i)
     {
+        const Pal::Viewport prevViewport = m_state.allGpuState.viewport.viewports[firstViewport + i];
+
         VkToPalViewport(pViewports[i], firstViewport + i, khrMaintenance1, &m_state.allGpuState.viewport);
+
+        redundant &= (memcmp(&prevViewport,
+                             &m_state.allGpuState.viewport.viewports[firstViewport + i],
+                             sizeof(prevViewport)) == 0);
     }
 
-    utils::IterateMask deviceGroup(m_curDeviceMask);
+    if (redundant == false)
+    {
+        utils::IterateMask deviceGroup(m_curDeviceMask);
 
-    while (deviceGroup.Iterate())
+        while (deviceGroup.Iterate())
+        {
+            PalCmdBuffer(deviceGroup.Index())->CmdSetViewports(m_state.allGpuState.viewport);
+        }
+
+        m_state.allGpuState.staticTokens.viewports      = DynamicRenderStateToken;
+        m_state.allGpuState.dynamicStateValid.viewports = 1;
+    }
+    else
     {
-        PalCmdBuffer(deviceGroup.Index())->CmdSetViewports(m_state.allGpuState.viewport);
+        m_elidedDynamicStateCount++;
     }
 
-    m_state.allGpuState.staticTokens.viewports = DynamicRenderStateToken;
-
     DbgBarrierPostCmd(DbgBarrierSetDynamicPipelineState);
 }
 
@@ -5082,20 +5338,37 @@ void CmdBuffer::SetScissor(
 {
     DbgBarrierPreCmd(DbgBarrierSetDynamicPipelineState);
 
+    bool redundant = (m_state.allGpuState.dynamicStateValid.scissorRect != 0) &&
+                     (m_state.allGpuState.staticTokens.scissorRect == DynamicRenderStateToken);
+
     for (uint32_t i = 0; i < scissorCount; ++i)
     {
+        const Pal::Rect prevScissor = m_state.allGpuState.scissor.scissors[firstScissor + i];
+
         VkToPalScissorRect(pScissors[i], firstScissor + i, &m_state.allGpuState.scissor);
+
+        redundant &= (memcmp(&prevScissor,
+                             &m_state.allGpuState.scissor.scissors[firstScissor + i],
+                             sizeof(prevScissor)) == 0);
     }
 
-    utils::IterateMask deviceGroup(m_curDeviceMask);
+    if (redundant == false)
+    {
+        utils::IterateMask deviceGroup(m_curDeviceMask);
 
-    while (deviceGroup.Iterate())
+        while (deviceGroup.Iterate())
+        {
+            PalCmdBuffer(deviceGroup.Index())->CmdSetScissorRects(m_state.allGpuState.scissor);
+        }
+
+        m_state.allGpuState.staticTokens.scissorRect      = DynamicRenderStateToken;
+        m_state.allGpuState.dynamicStateValid.scissorRect = 1;
+    }
+    else
     {
-        PalCmdBuffer(deviceGroup.Index())->CmdSetScissorRects(m_state.allGpuState.scissor);
+        m_elidedDynamicStateCount++;
     }
 
-    m_state.allGpuState.staticTokens.scissorRect = DynamicRenderStateToken;
-
     DbgBarrierPostCmd(DbgBarrierSetDynamicPipelineState);
 }
 
@@ -5163,15 +5436,26 @@ void CmdBuffer::SetDepthBias(
 
     const Pal::DepthBiasParams params = {depthBias, depthBiasClamp, slopeScaledDepthBias};
 
-    utils::IterateMask deviceGroup(m_curDeviceMask);
+    if ((m_state.allGpuState.dynamicStateValid.depthBias == 0) ||
+        (m_state.allGpuState.staticTokens.depthBiasState != DynamicRenderStateToken) ||
+        (memcmp(&params, &m_state.allGpuState.depthBias, sizeof(params)) != 0))
+    {
+        utils::IterateMask deviceGroup(m_curDeviceMask);
 
-    while (deviceGroup.Iterate())
+        while (deviceGroup.Iterate())
+        {
+            PalCmdBuffer(deviceGroup.Index())->CmdSetDepthBiasState(params);
+        }
+
+        m_state.allGpuState.staticTokens.depthBiasState = DynamicRenderStateToken;
+        m_state.allGpuState.depthBias                   = params;
+        m_state.allGpuState.dynamicStateValid.depthBias = 1;
+    }
+    else
     {
-        PalCmdBuffer(deviceGroup.Index())->CmdSetDepthBiasState(params);
+        m_elidedDynamicStateCount++;
     }
 
-    m_state.allGpuState.staticTokens.depthBiasState = DynamicRenderStateToken;
-
     DbgBarrierPostCmd(DbgBarrierSetDynamicPipelineState);
 }
 
@@ -5183,15 +5467,26 @@ void CmdBuffer::SetBlendConstants(
 
     const Pal::BlendConstParams params = { blendConst[0], blendConst[1], blendConst[2], blendConst[3] };
 
-    utils::IterateMask deviceGroup(m_curDeviceMask);
+    if ((m_state.allGpuState.dynamicStateValid.blendConst == 0) ||
+        (m_state.allGpuState.staticTokens.blendConst != DynamicRenderStateToken) ||
+        (memcmp(&params, &m_state.allGpuState.blendConst, sizeof(params)) != 0))
+    {
+        utils::IterateMask deviceGroup(m_curDeviceMask);
 
-    while (deviceGroup.Iterate())
+        while (deviceGroup.Iterate())
+        {
+            PalCmdBuffer(deviceGroup.Index())->CmdSetBlendConst(params);
+        }
+
+        m_state.allGpuState.staticTokens.blendConst      = DynamicRenderStateToken;
+        m_state.allGpuState.blendConst                   = params;
+        m_state.allGpuState.dynamicStateValid.blendConst = 1;
+    }
+    else
     {
-        PalCmdBuffer(deviceGroup.Index())->CmdSetBlendConst(params);
+        m_elidedDynamicStateCount++;
     }
 
-    m_state.allGpuState.staticTokens.blendConst = DynamicRenderStateToken;
-
     DbgBarrierPostCmd(DbgBarrierSetDynamicPipelineState);
 }
 
@@ -5204,15 +5499,26 @@ void CmdBuffer::SetDepthBounds(
 
     const Pal::DepthBoundsParams params = { minDepthBounds, maxDepthBounds };
 
-    utils::IterateMask deviceGroup(m_curDeviceMask);
+    if ((m_state.allGpuState.dynamicStateValid.depthBounds == 0) ||
+        (m_state.allGpuState.staticTokens.depthBounds != DynamicRenderStateToken) ||
+        (memcmp(&params, &m_state.allGpuState.depthBounds, sizeof(params)) != 0))
+    {
+        utils::IterateMask deviceGroup(m_curDeviceMask);
 
-    while (deviceGroup.Iterate())
+        while (deviceGroup.Iterate())
+        {
+            PalCmdBuffer(deviceGroup.Index())->CmdSetDepthBounds(params);
+        }
+
+        m_state.allGpuState.staticTokens.depthBounds      = DynamicRenderStateToken;
+        m_state.allGpuState.depthBounds                   = params;
+        m_state.allGpuState.dynamicStateValid.depthBounds = 1;
+    }
+    else
     {
-        PalCmdBuffer(deviceGroup.Index())->CmdSetDepthBounds(params);
+        m_elidedDynamicStateCount++;
     }
 
-    m_state.allGpuState.staticTokens.depthBounds = DynamicRenderStateToken;
-
     DbgBarrierPostCmd(DbgBarrierSetDynamicPipelineState);
 }
 
@@ -5233,8 +5539,10 @@ void CmdBuffer::SetStencilCompareMask(
     }
     // Flush the stencil setting, knowing a subsequent vkCmdSetStencilxxx call will also write its own PM4 packets
     // It is done this way to avoid draw-time validation
-
-    m_stencilCombiner.PalCmdSetStencilState(this);
+    if (m_stencilCombiner.PalCmdSetStencilState(this) == false)
+    {
+        m_elidedDynamicStateCount++;
+    }
     DbgBarrierPostCmd(DbgBarrierSetDynamicPipelineState);
 }
 
@@ -5256,7 +5564,10 @@ void CmdBuffer::SetStencilWriteMask(
 
     // Flush the stencil setting, knowing a subsequent vkCmdSetStencilxxx call will also write its own PM4 packets
     // It is done this way to avoid draw-time validation
-    m_stencilCombiner.PalCmdSetStencilState(this);
+    if (m_stencilCombiner.PalCmdSetStencilState(this) == false)
+    {
+        m_elidedDynamicStateCount++;
+    }
 
     DbgBarrierPostCmd(DbgBarrierSetDynamicPipelineState);
 }
@@ -5279,7 +5590,10 @@ void CmdBuffer::SetStencilReference(
 
     // Flush the stencil setting, knowing a subsequent vkCmdSetStencilxxx call will also write its own PM4 packets
     // It is done this way to avoid draw-time validation
-    m_stencilCombiner.PalCmdSetStencilState(this);
+    if (m_stencilCombiner.PalCmdSetStencilState(this) == false)
+    {
+        m_elidedDynamicStateCount++;
+    }
 
     DbgBarrierPostCmd(DbgBarrierSetDynamicPipelineState);
 }
@@ -5530,6 +5844,11 @@ void CmdBuffer::DrawIndirectByteCount(
     uint32_t        vertexStride)
 {
     Buffer* pCounterBuffer = Buffer::ObjectFromHandle(counterBuffer);
+
+    CountStat(CmdBufferStatDrawIndirect);
+
+    FlushUserData(PipelineBindGraphics, Pal::PipelineBindPoint::Graphics);
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     while (deviceGroup.Iterate())
     {
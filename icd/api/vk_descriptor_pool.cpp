@@ -95,9 +95,12 @@ VkResult DescriptorPool::Create(
 DescriptorPool::DescriptorPool(
     Device* pDevice)
     :
-    m_pDevice(pDevice)
+    m_pDevice(pDevice),
+    m_recycleFreedSets(false),
+    m_recycledSetCount(0)
 {
     memset(m_addresses, 0, sizeof(m_addresses));
+    memset(m_recycledSets, 0, sizeof(m_recycledSets));
 }
 
 // =====================================================================================================================
@@ -112,6 +115,10 @@ VkResult DescriptorPool::Init(
 
     VkResult result = VK_SUCCESS;
 
+    // Freed sets can only be recycled if sets can be freed individually
+    m_recycleFreedSets = ((poolUsage & VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT) != 0) &&
+                         pDevice->GetRuntimeSettings().enableDescriptorSetRecycling;
+
     result = m_setHeap.Init<numPalDevices>(pDevice, poolUsage, maxSets);
 
     if (result == VK_SUCCESS)
@@ -225,6 +232,10 @@ VkResult DescriptorPool::Init(
 template <uint32_t numPalDevices>
 VkResult DescriptorPool::Reset()
 {
+    // The recycled sets are released together with everything else
+    memset(m_recycledSets, 0, sizeof(m_recycledSets));
+    m_recycledSetCount = 0;
+
     m_setHeap.Reset<numPalDevices>();
     m_gpuMemHeap.Reset();
 
@@ -282,31 +293,37 @@ VkResult DescriptorPool::AllocDescriptorSets(
 
     while ((result == VK_SUCCESS) && (allocCount < count))
     {
-        if (m_setHeap.AllocSetState<numPalDevices>(&pDescriptorSets[allocCount]))
-        {
-            // Try to allocate GPU memory for the descriptor set
-            DescriptorSetLayout* pLayout = DescriptorSetLayout::ObjectFromHandle(pSetLayouts[allocCount]);
+        DescriptorSetLayout* pLayout = DescriptorSetLayout::ObjectFromHandle(pSetLayouts[allocCount]);
 
-            uint32_t variableDescriptorCounts = 0;
+        uint32_t variableDescriptorCounts = 0;
 
-            // Get variable descriptor counts for the last layout binding
-            if (pVariableDescriptorCount != nullptr)
-            {
-                VK_ASSERT(pVariableDescriptorCount->sType ==
-                    VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO_EXT);
+        // Get variable descriptor counts for the last layout binding
+        if (pVariableDescriptorCount != nullptr)
+        {
+            VK_ASSERT(pVariableDescriptorCount->sType ==
+                VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO_EXT);
 
-                VK_ASSERT(pVariableDescriptorCount->descriptorSetCount == pAllocateInfo->descriptorSetCount);
+            VK_ASSERT(pVariableDescriptorCount->descriptorSetCount == pAllocateInfo->descriptorSetCount);
 
-                uint32_t lastBindingIdx = pLayout->Info().count - 1;
+            uint32_t lastBindingIdx = pLayout->Info().count - 1;
 
-                if (pLayout->Binding(lastBindingIdx).bindingFlags &
-                    VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT)
-                {
-                    variableDescriptorCounts = pVariableDescriptorCount->pDescriptorCounts[allocCount];
-                    VK_ASSERT(variableDescriptorCounts <= pLayout->Binding(lastBindingIdx).info.descriptorCount);
-                }
+            if (pLayout->Binding(lastBindingIdx).bindingFlags &
+                VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT)
+            {
+                variableDescriptorCounts = pVariableDescriptorCount->pDescriptorCounts[allocCount];
+                VK_ASSERT(variableDescriptorCounts <= pLayout->Binding(lastBindingIdx).info.descriptorCount);
             }
+        }
 
+        // First try to take over a recently freed set of the same layout along with its GPU memory
+        if ((m_recycledSetCount > 0) &&
+            AllocRecycledSet<numPalDevices>(pLayout, variableDescriptorCounts, &pDescriptorSets[allocCount]))
+        {
+            allocCount++;
+        }
+        else if (m_setHeap.AllocSetState<numPalDevices>(&pDescriptorSets[allocCount]))
+        {
+            // Try to allocate GPU memory for the descriptor set
             Pal::gpusize setGpuMemOffset;
             void* pSetAllocHandle;
 
@@ -353,6 +370,15 @@ VkResult DescriptorPool::AllocDescriptorSets(
             // No partial failures allowed for creating multiple descriptor sets. Update all to VK_NULL_HANDLE.
             pDescriptorSets[setIdx] = VK_NULL_HANDLE;
         }
+
+        // The pool may only have run out because recycled sets of other layouts still hold on to their state and GPU
+        // memory, so release them and try once more.
+        if (m_recycledSetCount > 0)
+        {
+            ReleaseRecycledSets<numPalDevices>();
+
+            result = AllocDescriptorSets<numPalDevices>(pAllocateInfo, pDescriptorSets);
+        }
     }
 
     return result;
@@ -372,6 +398,12 @@ VkResult DescriptorPool::FreeDescriptorSets(
             continue;
         }
 
+        // Keep the set for a following allocation of the same layout if possible
+        if (m_recycleFreedSets && RecycleSet<numPalDevices>(pDescriptorSets[i]))
+        {
+            continue;
+        }
+
         // Free this set's GPU memory
         DescriptorSet<numPalDevices>* pSet  = DescriptorSet<numPalDevices>::StateFromHandle(pDescriptorSets[i]);
         m_gpuMemHeap.FreeSetGpuMem(pSet->AllocHandle());
@@ -383,10 +415,98 @@ VkResult DescriptorPool::FreeDescriptorSets(
     return VK_SUCCESS;
 }
 
+// =====================================================================================================================
+// Adds a freed descriptor set to the recycled sets of its layout.  Returns false if the set has to be freed instead.
+template <uint32_t numPalDevices>
+bool DescriptorPool::RecycleSet(
+    VkDescriptorSet set)
+{
+    // The layout may already have been destroyed so it must not be dereferenced here.
+    const DescriptorSetLayout* pLayout = DescriptorSet<numPalDevices>::StateFromHandle(set)->Layout();
+
+    if (pLayout == nullptr)
+    {
+        return false;
+    }
+
+    RecycledSetList* pList = GetRecycledSetList(pLayout);
+
+    // Take over the list if it holds the sets of another layout that have all been reused since
+    if (pList->count == 0)
+    {
+        pList->pLayout = pLayout;
+    }
+    else if ((pList->pLayout != pLayout) || (pList->count == RecycledSetListCapacity))
+    {
+        return false;
+    }
+
+    pList->sets[pList->count++] = set;
+    m_recycledSetCount++;
+
+    return true;
+}
+
+// =====================================================================================================================
+// Pops a recycled descriptor set of the given layout.  The set keeps the state and GPU memory it had when it was freed,
+// so it needs neither a new heap allocation nor reassignment.
+template <uint32_t numPalDevices>
+bool DescriptorPool::AllocRecycledSet(
+    const DescriptorSetLayout* pLayout,
+    uint32_t                   variableDescriptorCounts,
+    VkDescriptorSet*           pSet)
+{
+    RecycledSetList* pList = GetRecycledSetList(pLayout);
+
+    if ((pList->count > 0) && (pList->pLayout == pLayout))
+    {
+        const VkDescriptorSet set = pList->sets[pList->count - 1];
+
+        // The GPU memory of the set has to be checked as it depends on the variable descriptor count the set was
+        // allocated with, and the layout object may have been destroyed and its memory reused for another layout.
+        if (m_gpuMemHeap.SetGpuMemFits(
+                DescriptorSet<numPalDevices>::StateFromHandle(set)->AllocHandle(),
+                pLayout,
+                variableDescriptorCounts))
+        {
+            *pSet = set;
+
+            pList->count--;
+            m_recycledSetCount--;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// =====================================================================================================================
+// Returns all recycled descriptor sets to the set and GPU memory heaps.
+template <uint32_t numPalDevices>
+void DescriptorPool::ReleaseRecycledSets()
+{
+    for (uint32_t listIdx = 0; listIdx < RecycledSetListCount; ++listIdx)
+    {
+        RecycledSetList* pList = &m_recycledSets[listIdx];
+
+        while (pList->count > 0)
+        {
+            const VkDescriptorSet set = pList->sets[--pList->count];
+
+            m_gpuMemHeap.FreeSetGpuMem(DescriptorSet<numPalDevices>::StateFromHandle(set)->AllocHandle());
+            m_setHeap.FreeSetState<numPalDevices>(set);
+        }
+    }
+
+    m_recycledSetCount = 0;
+}
+
 // =====================================================================================================================
 DescriptorGpuMemHeap::DescriptorGpuMemHeap() :
 m_usage(0),
 m_oneShotAllocForward(0),
+m_dynamicAllocFreeListMask(0),
 m_pDynamicAllocBlocks(nullptr),
 m_dynamicAllocBlockCount(0),
 m_pDynamicAllocBlockIndexStack(nullptr),
@@ -398,6 +518,8 @@ m_numPalDevices(0)
     m_gpuMemOffsetRangeStart = 0;
     m_gpuMemOffsetRangeEnd   = 0;
 
+    memset(&m_dynamicAllocFreeListSentinel, 0, sizeof(m_dynamicAllocFreeListSentinel));
+    memset(m_pDynamicAllocFreeLists, 0, sizeof(m_pDynamicAllocFreeLists));
     memset(m_pCpuAddr, 0, sizeof(m_pCpuAddr));
     memset(m_pCpuShadowAddr, 0, sizeof(m_pCpuShadowAddr));
 }
@@ -445,10 +567,13 @@ VkResult DescriptorGpuMemHeap::Init(
         }
 
         // Initialize the management structures
-        m_dynamicAllocBlockFreeListHeader.pPrevFree = nullptr;
-        m_dynamicAllocBlockFreeListHeader.pNextFree = nullptr;
-        m_dynamicAllocBlockFreeListHeader.pPrev     = nullptr;
-        m_dynamicAllocBlockFreeListHeader.pNext     = nullptr;
+        m_dynamicAllocFreeListSentinel.pPrevFree = nullptr;
+        m_dynamicAllocFreeListSentinel.pNextFree = nullptr;
+        m_dynamicAllocFreeListSentinel.pPrev     = nullptr;
+        m_dynamicAllocFreeListSentinel.pNext     = nullptr;
+
+        memset(m_pDynamicAllocFreeLists, 0, sizeof(m_pDynamicAllocFreeLists));
+        m_dynamicAllocFreeListMask = 0;
 
         m_pDynamicAllocBlocks               = reinterpret_cast<DynamicAllocBlock*>(pMemory);
         m_pDynamicAllocBlockIndexStack      = reinterpret_cast<uint32_t*>(Util::VoidPtrInc(pMemory, blockStorageSize));
@@ -491,23 +616,32 @@ void DescriptorGpuMemHeap::SanityCheckDynamicAllocBlockList()
     DynamicAllocBlock*  pBlock      = nullptr;
     DynamicAllocBlock*  pPrevBlock  = nullptr;
 
-    // Sanity check the free block list.
-    pPrevBlock = &m_dynamicAllocBlockFreeListHeader;
-    pBlock = m_dynamicAllocBlockFreeListHeader.pNextFree;
+    // Sanity check the free block lists.
     blockCount = 0;
-    while (pBlock != nullptr)
+    for (uint32_t bin = 0; bin < DynamicAllocBinCount; ++bin)
     {
-        blockCount++;
+        // The mask should tell exactly which free lists are non-empty.
+        VK_ASSERT(((m_dynamicAllocFreeListMask & (1u << bin)) != 0) == (m_pDynamicAllocFreeLists[bin] != nullptr));
+
+        pPrevBlock = &m_dynamicAllocFreeListSentinel;
+        pBlock = m_pDynamicAllocFreeLists[bin];
+        while (pBlock != nullptr)
+        {
+            blockCount++;
 
-        // The number of blocks in the free list should not exceed half of the blocks, otherwise that's an indication
-        // of a loop in the list of free blocks.
-        VK_ASSERT(blockCount <= (m_dynamicAllocBlockCount / 2 + 1));
+            // The number of blocks in the free lists should not exceed half of the blocks, otherwise that's an
+            // indication of a loop in a list of free blocks.
+            VK_ASSERT(blockCount <= (m_dynamicAllocBlockCount / 2 + 1));
 
-        // The pPrevFree field should point to the previous block in the free list.
-        VK_ASSERT(pBlock->pPrevFree == pPrevBlock);
+            // The pPrevFree field should point to the previous block in the free list.
+            VK_ASSERT(pBlock->pPrevFree == pPrevBlock);
 
-        pPrevBlock = pBlock;
-        pBlock = pBlock->pNextFree;
+            // The block should be on the free list of its size class.
+            VK_ASSERT(DynamicAllocBin(pBlock->gpuMemOffsetRangeEnd - pBlock->gpuMemOffsetRangeStart) == bin);
+
+            pPrevBlock = pBlock;
+            pBlock = pBlock->pNextFree;
+        }
     }
 
     // Find the first node in the complete block list.
@@ -570,15 +704,110 @@ void DescriptorGpuMemHeap::SanityCheckDynamicAllocBlockList()
 #endif
 
 // =====================================================================================================================
-// Allocates enough GPU memory to contain the given descriptor set layout.  Returns back a GPU VA offset and an opaque
-// handle that can be used to free that memory for non-one-shot allocations.
-bool DescriptorGpuMemHeap::AllocSetGpuMem(
+// Links a free block to the free list of its size class.
+void DescriptorGpuMemHeap::LinkFreeBlock(
+    DynamicAllocBlock* pBlock)
+{
+    VK_ASSERT((pBlock->pPrevFree == nullptr) && (pBlock->pNextFree == nullptr));
+
+    const uint32_t bin = DynamicAllocBin(pBlock->gpuMemOffsetRangeEnd - pBlock->gpuMemOffsetRangeStart);
+
+    pBlock->pPrevFree = &m_dynamicAllocFreeListSentinel;
+    pBlock->pNextFree = m_pDynamicAllocFreeLists[bin];
+
+    if (pBlock->pNextFree != nullptr)
+    {
+        pBlock->pNextFree->pPrevFree = pBlock;
+    }
+
+    m_pDynamicAllocFreeLists[bin] = pBlock;
+    m_dynamicAllocFreeListMask   |= (1u << bin);
+}
+
+// =====================================================================================================================
+// Unlinks a free block from its free list.  Must be called before the range of the block changes.
+void DescriptorGpuMemHeap::UnlinkFreeBlock(
+    DynamicAllocBlock* pBlock)
+{
+    VK_ASSERT(IsDynamicAllocBlockFree(pBlock));
+
+    if (pBlock->pPrevFree == &m_dynamicAllocFreeListSentinel)
+    {
+        const uint32_t bin = DynamicAllocBin(pBlock->gpuMemOffsetRangeEnd - pBlock->gpuMemOffsetRangeStart);
+
+        VK_ASSERT(m_pDynamicAllocFreeLists[bin] == pBlock);
+
+        m_pDynamicAllocFreeLists[bin] = pBlock->pNextFree;
+
+        if (pBlock->pNextFree == nullptr)
+        {
+            m_dynamicAllocFreeListMask &= ~(1u << bin);
+        }
+    }
+    else
+    {
+        pBlock->pPrevFree->pNextFree = pBlock->pNextFree;
+    }
+
+    if (pBlock->pNextFree != nullptr)
+    {
+        pBlock->pNextFree->pPrevFree = pBlock->pPrevFree;
+    }
+
+    pBlock->pPrevFree = nullptr;
+    pBlock->pNextFree = nullptr;
+}
+
+// =====================================================================================================================
+// Returns the first block of the given free list that is at least "size" bytes large, or null if there is none.
+DescriptorGpuMemHeap::DynamicAllocBlock* DescriptorGpuMemHeap::FindFreeBlockInBin(
+    uint32_t     bin,
+    Pal::gpusize size) const
+{
+    DynamicAllocBlock* pBlock = m_pDynamicAllocFreeLists[bin];
+
+    while ((pBlock != nullptr) && ((pBlock->gpuMemOffsetRangeEnd - pBlock->gpuMemOffsetRangeStart) < size))
+    {
+        pBlock = pBlock->pNextFree;
+    }
+
+    return pBlock;
+}
+
+// =====================================================================================================================
+// Returns a free block of at least "size" bytes, or null if there is none.  Every block of a size class whose lower
+// bound is at least "size" is large enough, so the smallest such non-empty class is found with a single bit scan.
+// Only the class containing "size" itself and the unbounded last class have to be searched.
+DescriptorGpuMemHeap::DynamicAllocBlock* DescriptorGpuMemHeap::FindFreeBlock(
+    Pal::gpusize size) const
+{
+    constexpr uint32_t LastBin = DynamicAllocBinCount - 1;
+
+    const uint32_t floorBin = DynamicAllocBin(size);
+    const uint32_t ceilBin  = (Util::IsPowerOfTwo(size) || (floorBin == LastBin)) ? floorBin : (floorBin + 1);
+
+    DynamicAllocBlock* pBlock = nullptr;
+    uint32_t           bin    = 0;
+
+    if (Util::BitMaskScanForward(&bin, m_dynamicAllocFreeListMask & ~((1u << ceilBin) - 1)))
+    {
+        pBlock = (bin < LastBin) ? m_pDynamicAllocFreeLists[bin] : FindFreeBlockInBin(bin, size);
+    }
+
+    if ((pBlock == nullptr) && (floorBin != ceilBin))
+    {
+        pBlock = FindFreeBlockInBin(floorBin, size);
+    }
+
+    return pBlock;
+}
+
+// =====================================================================================================================
+// Returns the number of bytes of GPU memory needed by a descriptor set of the given layout.
+uint32_t DescriptorGpuMemHeap::SetGpuMemSize(
     const DescriptorSetLayout*  pLayout,
-    uint32_t                    variableDescriptorCounts,
-    Pal::gpusize*               pSetGpuMemOffset,
-    void**                      pSetAllocHandle)
+    uint32_t                    variableDescriptorCounts)
 {
-    // Figure out the byte size and alignment
     uint32_t byteSize = 0;
     if (variableDescriptorCounts > 0)
     {
@@ -594,6 +823,42 @@ bool DescriptorGpuMemHeap::AllocSetGpuMem(
         byteSize = pLayout->Info().sta.dwSize * sizeof(uint32_t);
     }
 
+    return byteSize;
+}
+
+// =====================================================================================================================
+// Returns whether the GPU memory previously allocated for a descriptor set is large enough for a descriptor set of the
+// given layout.
+bool DescriptorGpuMemHeap::SetGpuMemFits(
+    const void*                 pSetAllocHandle,
+    const DescriptorSetLayout*  pLayout,
+    uint32_t                    variableDescriptorCounts) const
+{
+    const uint32_t byteSize = SetGpuMemSize(pLayout, variableDescriptorCounts);
+
+    bool fits = (byteSize == 0);
+
+    if ((fits == false) && (pSetAllocHandle != nullptr))
+    {
+        const DynamicAllocBlock* pBlock = static_cast<const DynamicAllocBlock*>(pSetAllocHandle);
+
+        fits = ((pBlock->gpuMemOffsetRangeEnd - pBlock->gpuMemOffsetRangeStart) >= byteSize);
+    }
+
+    return fits;
+}
+
+// =====================================================================================================================
+// Allocates enough GPU memory to contain the given descriptor set layout.  Returns back a GPU VA offset and an opaque
+// handle that can be used to free that memory for non-one-shot allocations.
+bool DescriptorGpuMemHeap::AllocSetGpuMem(
+    const DescriptorSetLayout*  pLayout,
+    uint32_t                    variableDescriptorCounts,
+    Pal::gpusize*               pSetGpuMemOffset,
+    void**                      pSetAllocHandle)
+{
+    // Figure out the byte size and alignment
+    const uint32_t byteSize  = SetGpuMemSize(pLayout, variableDescriptorCounts);
     const uint32_t alignment = m_gpuMemAddrAlignment;
 
     if (byteSize == 0)
@@ -620,84 +885,75 @@ bool DescriptorGpuMemHeap::AllocSetGpuMem(
             return true;
         }
     }
-    // For dynamic allocations, do something more complicated
+    // For dynamic allocations, take the block from the segregated free lists
     else
     {
-        DynamicAllocBlock* pBlock = m_dynamicAllocBlockFreeListHeader.pNextFree;
+        // Round the size up so that every block of the heap starts at an aligned offset.
+        const Pal::gpusize allocSize = Util::Pow2Align(static_cast<Pal::gpusize>(byteSize), alignment);
 
-        while (pBlock != nullptr)
+        DynamicAllocBlock* pBlock = FindFreeBlock(allocSize);
+
+        if (pBlock != nullptr)
         {
-            Pal::gpusize gpuBaseOffset  = Util::Pow2Align(pBlock->gpuMemOffsetRangeStart, alignment);
-            Pal::gpusize newBlockStart  = gpuBaseOffset + byteSize;
+            VK_ASSERT(Util::IsPow2Aligned(pBlock->gpuMemOffsetRangeStart, alignment));
 
-            if (newBlockStart <= pBlock->gpuMemOffsetRangeEnd)
-            {
-                *pSetAllocHandle  = pBlock;
-                *pSetGpuMemOffset = gpuBaseOffset;
+            const Pal::gpusize newBlockStart = pBlock->gpuMemOffsetRangeStart + allocSize;
+
+            // Unlink this block from the list of free blocks.
+            UnlinkFreeBlock(pBlock);
 
-                // If there's space left in this block then let's remember it.
-                if (newBlockStart < pBlock->gpuMemOffsetRangeEnd)
+            *pSetAllocHandle  = pBlock;
+            *pSetGpuMemOffset = pBlock->gpuMemOffsetRangeStart;
+
+            // If there's space left in this block then let's remember it.
+            if (newBlockStart < pBlock->gpuMemOffsetRangeEnd)
+            {
+                // If the next block is a free one then attach the remaining range to it.
+                if (IsDynamicAllocBlockFree(pBlock->pNext))
                 {
-                    // If the next block is a free one then attach the remaining range to it.
-                    if (IsDynamicAllocBlockFree(pBlock->pNext))
-                    {
-                        VK_ASSERT(pBlock->gpuMemOffsetRangeEnd == pBlock->pNext->gpuMemOffsetRangeStart);
+                    VK_ASSERT(pBlock->gpuMemOffsetRangeEnd == pBlock->pNext->gpuMemOffsetRangeStart);
 
-                        pBlock->pNext->gpuMemOffsetRangeStart = newBlockStart;
-                    }
-                    else
-                    // Otherwise create a new free block for the remaining range.
-                    {
-                        VK_ASSERT(m_dynamicAllocBlockIndexStackCount > 0);
-                        uint32_t newBlockIndex = m_pDynamicAllocBlockIndexStack[--m_dynamicAllocBlockIndexStackCount];
-
-                        DynamicAllocBlock* pNewBlock      = &m_pDynamicAllocBlocks[newBlockIndex];
-                        pNewBlock->pPrevFree              = pBlock;
-                        pNewBlock->pNextFree              = pBlock->pNextFree;
-                        pNewBlock->pPrev                  = pBlock;
-                        pNewBlock->pNext                  = pBlock->pNext;
-                        pNewBlock->gpuMemOffsetRangeStart = newBlockStart;
-                        pNewBlock->gpuMemOffsetRangeEnd   = pBlock->gpuMemOffsetRangeEnd;
-
-                        if (pNewBlock->pNextFree != nullptr)
-                        {
-                            pNewBlock->pNextFree->pPrevFree = pNewBlock;
-                        }
-
-                        if (pNewBlock->pNext != nullptr)
-                        {
-                            pNewBlock->pNext->pPrev = pNewBlock;
-                        }
-
-                        pBlock->pNextFree               = pNewBlock;
-                        pBlock->pNext                   = pNewBlock;
-                    }
+                    DynamicAllocBlock* pNextBlock = pBlock->pNext;
 
-                    // Truncate the block to the allocated size.
-                    pBlock->gpuMemOffsetRangeEnd = newBlockStart;
+                    // Its size class changes, so move it to the right free list.
+                    UnlinkFreeBlock(pNextBlock);
+                    pNextBlock->gpuMemOffsetRangeStart = newBlockStart;
+                    LinkFreeBlock(pNextBlock);
                 }
+                else
+                // Otherwise create a new free block for the remaining range.
+                {
+                    VK_ASSERT(m_dynamicAllocBlockIndexStackCount > 0);
+                    uint32_t newBlockIndex = m_pDynamicAllocBlockIndexStack[--m_dynamicAllocBlockIndexStackCount];
+
+                    DynamicAllocBlock* pNewBlock      = &m_pDynamicAllocBlocks[newBlockIndex];
+                    pNewBlock->pPrevFree              = nullptr;
+                    pNewBlock->pNextFree              = nullptr;
+                    pNewBlock->pPrev                  = pBlock;
+                    pNewBlock->pNext                  = pBlock->pNext;
+                    pNewBlock->gpuMemOffsetRangeStart = newBlockStart;
+                    pNewBlock->gpuMemOffsetRangeEnd   = pBlock->gpuMemOffsetRangeEnd;
+
+                    if (pNewBlock->pNext != nullptr)
+                    {
+                        pNewBlock->pNext->pPrev = pNewBlock;
+                    }
 
-                // Unlink this block from the list of free blocks.
+                    pBlock->pNext = pNewBlock;
 
-                pBlock->pPrevFree->pNextFree = pBlock->pNextFree;
-                if (pBlock->pNextFree != nullptr)
-                {
-                    pBlock->pNextFree->pPrevFree = pBlock->pPrevFree;
+                    LinkFreeBlock(pNewBlock);
                 }
 
-                pBlock->pNextFree   = nullptr;
-                pBlock->pPrevFree   = nullptr;
+                // Truncate the block to the allocated size.
+                pBlock->gpuMemOffsetRangeEnd = newBlockStart;
+            }
 
 #if DEBUG
-                // Sanity check the lists after a successful allocation.
-                SanityCheckDynamicAllocBlockList();
+            // Sanity check the lists after a successful allocation.
+            SanityCheckDynamicAllocBlockList();
 #endif
 
-                return true;
-            }
-
-            // Advance to the next free block.
-            pBlock      = pBlock->pNextFree;
+            return true;
         }
     }
 
@@ -777,18 +1033,14 @@ void DescriptorGpuMemHeap::FreeSetGpuMem(
 
         // The deallocation process is as follows:
         //   1. If the next block is free then:
-        //      a. Merge the range of the block into the next block
+        //      a. Unlink it from its free list and merge the range of the block into it
         //      b. Unlink the block from the list and release it
         //      c. Continue as if the next block was the original block
         //   2. If the previous block is free then:
-        //      a. If this block is on the free list then unlink the block from the it
-        //      b. Merge the range of the block into the previous block
-        //      c. Unlink the block from the list and release it
-        //   3. If we didn't release the block earlier then it means neither the previous or the next block was
-        //      free, thus we should simply link this block to the list of free blocks (it doesn't matter where
-        //      we link the block in the free list as that doesn't have to be necessarily ordered)
-
-        bool blockReleased = false;
+        //      a. Unlink it from its free list and merge the range of the block into it
+        //      b. Unlink the block from the list and release it
+        //      c. Continue as if the previous block was the original block
+        //   3. Link the resulting block to the free list of its size class
 
         // If the next block is a free one then attach the range of this block to it.
         if (IsDynamicAllocBlockFree(pBlock->pNext))
@@ -798,18 +1050,18 @@ void DescriptorGpuMemHeap::FreeSetGpuMem(
             DynamicAllocBlock* pNextBlock = pBlock->pNext;
 
             // Merge the range of the block into the next block.
-            pBlock->pNext->gpuMemOffsetRangeStart = pBlock->gpuMemOffsetRangeStart;
+            UnlinkFreeBlock(pNextBlock);
+            pNextBlock->gpuMemOffsetRangeStart = pBlock->gpuMemOffsetRangeStart;
 
             // Unlink the block from the list.
-            pBlock->pNext->pPrev = pBlock->pPrev;
+            pNextBlock->pPrev = pBlock->pPrev;
             if (pBlock->pPrev != nullptr)
             {
-                pBlock->pPrev->pNext = pBlock->pNext;
+                pBlock->pPrev->pNext = pNextBlock;
             }
 
             // Then release the block.
             m_pDynamicAllocBlockIndexStack[m_dynamicAllocBlockIndexStackCount++] = DynamicAllocBlockIndex(pBlock);
-            blockReleased = true;
 
             // Set the next block as the block.
             pBlock = pNextBlock;
@@ -820,46 +1072,28 @@ void DescriptorGpuMemHeap::FreeSetGpuMem(
         {
             VK_ASSERT(pBlock->gpuMemOffsetRangeStart == pBlock->pPrev->gpuMemOffsetRangeEnd);
 
-            // If this block is on the free list then unlink the block from it.
-            if (pBlock->pPrevFree != nullptr)
-            {
-                pBlock->pPrevFree->pNextFree = pBlock->pNextFree;
-            }
-            if (pBlock->pNextFree != nullptr)
-            {
-                pBlock->pNextFree->pPrevFree = pBlock->pPrevFree;
-            }
+            DynamicAllocBlock* pPrevBlock = pBlock->pPrev;
 
             // Merge the range of the block into the previous block.
-            pBlock->pPrev->gpuMemOffsetRangeEnd = pBlock->gpuMemOffsetRangeEnd;
+            UnlinkFreeBlock(pPrevBlock);
+            pPrevBlock->gpuMemOffsetRangeEnd = pBlock->gpuMemOffsetRangeEnd;
 
             // Unlink the block from the list.
-            pBlock->pPrev->pNext = pBlock->pNext;
+            pPrevBlock->pNext = pBlock->pNext;
             if (pBlock->pNext != nullptr)
             {
-                pBlock->pNext->pPrev = pBlock->pPrev;
+                pBlock->pNext->pPrev = pPrevBlock;
             }
 
             // Then release the block.
             m_pDynamicAllocBlockIndexStack[m_dynamicAllocBlockIndexStackCount++] = DynamicAllocBlockIndex(pBlock);
-            blockReleased = true;
-        }
 
-        // If we didn't release the block so far then let's just link it to the list of free blocks
-        if (!blockReleased)
-        {
-            pBlock->pNextFree = m_dynamicAllocBlockFreeListHeader.pNextFree;
-
-            if (pBlock->pNextFree != nullptr)
-            {
-                pBlock->pNextFree->pPrevFree = pBlock;
-            }
-
-            pBlock->pPrevFree = &m_dynamicAllocBlockFreeListHeader;
-
-            m_dynamicAllocBlockFreeListHeader.pNextFree = pBlock;
+            // Set the previous block as the block.
+            pBlock = pPrevBlock;
         }
 
+        LinkFreeBlock(pBlock);
+
 #if DEBUG
         // Sanity check the lists after a successful destroy.
         SanityCheckDynamicAllocBlockList();
@@ -895,15 +1129,18 @@ void DescriptorGpuMemHeap::Reset()
 
         uint32_t blockIndex = m_pDynamicAllocBlockIndexStack[--m_dynamicAllocBlockIndexStackCount];
 
+        memset(m_pDynamicAllocFreeLists, 0, sizeof(m_pDynamicAllocFreeLists));
+        m_dynamicAllocFreeListMask = 0;
+
         DynamicAllocBlock* pBlock      = &m_pDynamicAllocBlocks[blockIndex];
-        pBlock->pPrevFree              = &m_dynamicAllocBlockFreeListHeader;
+        pBlock->pPrevFree              = nullptr;
         pBlock->pNextFree              = nullptr;
         pBlock->pPrev                  = nullptr;
         pBlock->pNext                  = nullptr;
         pBlock->gpuMemOffsetRangeStart = m_gpuMemOffsetRangeStart;
         pBlock->gpuMemOffsetRangeEnd   = m_gpuMemOffsetRangeEnd;
 
-        m_dynamicAllocBlockFreeListHeader.pNextFree = pBlock;
+        LinkFreeBlock(pBlock);
     }
 }
 
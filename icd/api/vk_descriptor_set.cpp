@@ -118,7 +118,7 @@ void DescriptorUpdate::WriteSamplerDescriptors(
     {
         const void* pSamplerDesc = Sampler::ObjectFromHandle(pImageInfo->sampler)->Descriptor();
 
-        memcpy(pDestAddr, pSamplerDesc, samplerDescSize);
+        StoreDescriptor<samplerDescSize>(pDestAddr, pSamplerDesc);
 
         pImageInfo = static_cast<const VkDescriptorImageInfo*>(Util::VoidPtrInc(pImageInfo, imageInfoStride));
     }
@@ -145,8 +145,8 @@ void DescriptorUpdate::WriteImageSamplerDescriptors(
                                           Descriptor(pImageInfo->imageLayout, deviceIdx, imageDescSize);
         const void* pSamplerDesc    = Sampler::ObjectFromHandle(pImageInfo->sampler)->Descriptor();
 
-        memcpy(pDestAddr, pImageDesc, imageDescSize);
-        memcpy(pDestAddr + (imageDescSize / sizeof(uint32_t)), pSamplerDesc, samplerDescSize);
+        StoreDescriptor<imageDescSize>(pDestAddr, pImageDesc);
+        StoreDescriptor<samplerDescSize>(pDestAddr + (imageDescSize / sizeof(uint32_t)), pSamplerDesc);
 
         pImageInfo = static_cast<const VkDescriptorImageInfo*>(Util::VoidPtrInc(pImageInfo, imageInfoStride));
     }
@@ -172,7 +172,7 @@ void DescriptorUpdate::WriteImageDescriptors(
         const void* pImageDesc = ImageView::ObjectFromHandle(pImageInfo->imageView)->
                                         Descriptor(pImageInfo->imageLayout, deviceIdx, imageDescSize);
 
-        memcpy(pDestAddr, pImageDesc, imageDescSize);
+        StoreDescriptor<imageDescSize>(pDestAddr, pImageDesc);
 
         pImageInfo = static_cast<const VkDescriptorImageInfo*>(Util::VoidPtrInc(pImageInfo, imageInfoStride));
     }
@@ -236,7 +236,7 @@ void DescriptorUpdate::WriteBufferDescriptors(
     {
         const void* pBufferDesc = BufferView::ObjectFromHandle(*pBufferView)->Descriptor(type, deviceIdx);
 
-        memcpy(pDestAddr, pBufferDesc, bufferDescSize);
+        StoreDescriptor<bufferDescSize>(pDestAddr, pBufferDesc);
 
         pBufferView = static_cast<const VkBufferView*>(Util::VoidPtrInc(pBufferView, bufferViewStride));
     }
@@ -271,20 +271,59 @@ void DescriptorUpdate::WriteBufferInfoDescriptors(
 
     Pal::IDevice* pPalDevice = pDevice->PalDevice(deviceIdx);
 
-    // Build the SRD
-    for (uint32_t arrayElem = 0; arrayElem < count; ++arrayElem, pDestAddr += dwStride)
-    {
-        info.gpuAddr = Buffer::ObjectFromHandle(pBufferInfo->buffer)->GpuVirtAddr(deviceIdx) + pBufferInfo->offset;
+    const bool dynamicAddrOnly = (pDevice->GetEnabledFeatures().robustBufferAccess == false) &&
+                                 ((type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC) ||
+                                  (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC));
 
-        if ((pDevice->GetEnabledFeatures().robustBufferAccess == false) &&
-            ((type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC)        ||
-             (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)))
+    if (dynamicAddrOnly)
+    {
+        for (uint32_t arrayElem = 0; arrayElem < count; ++arrayElem, pDestAddr += dwStride)
         {
+            info.gpuAddr = Buffer::ObjectFromHandle(pBufferInfo->buffer)->GpuVirtAddr(deviceIdx) + pBufferInfo->offset;
+
             pDestAddr[0] = Util::LowPart(info.gpuAddr);
             pDestAddr[1] = Util::HighPart(info.gpuAddr);
+
+            pBufferInfo = static_cast<const VkDescriptorBufferInfo*>(Util::VoidPtrInc(pBufferInfo, bufferInfoStride));
         }
-        else
+    }
+    else if ((count > 1) && ((dwStride * sizeof(uint32_t)) == pDevice->GetProperties().descriptorSizes.bufferView))
+    {
+        // The SRDs of the array elements are tightly packed so PAL can build a batch of them with a single call
+        constexpr uint32_t MaxBatchSize = 16;
+
+        Pal::BufferViewInfo infos[MaxBatchSize];
+
+        for (uint32_t arrayElem = 0; arrayElem < count; )
+        {
+            const uint32_t batchSize = Util::Min(count - arrayElem, MaxBatchSize);
+
+            for (uint32_t i = 0; i < batchSize; ++i)
+            {
+                const Buffer* pBuffer = Buffer::ObjectFromHandle(pBufferInfo->buffer);
+
+                infos[i]         = info;
+                infos[i].gpuAddr = pBuffer->GpuVirtAddr(deviceIdx) + pBufferInfo->offset;
+                infos[i].range   = (pBufferInfo->range == VK_WHOLE_SIZE) ? (pBuffer->GetSize() - pBufferInfo->offset)
+                                                                         : pBufferInfo->range;
+
+                pBufferInfo = static_cast<const VkDescriptorBufferInfo*>(
+                    Util::VoidPtrInc(pBufferInfo, bufferInfoStride));
+            }
+
+            pPalDevice->CreateUntypedBufferViewSrds(batchSize, infos, pDestAddr);
+
+            arrayElem += batchSize;
+            pDestAddr += batchSize * dwStride;
+        }
+    }
+    else
+    {
+        // Build the SRD
+        for (uint32_t arrayElem = 0; arrayElem < count; ++arrayElem, pDestAddr += dwStride)
         {
+            info.gpuAddr = Buffer::ObjectFromHandle(pBufferInfo->buffer)->GpuVirtAddr(deviceIdx) + pBufferInfo->offset;
+
             if (pBufferInfo->range == VK_WHOLE_SIZE)
             {
                 info.range = reinterpret_cast<Buffer*>(pBufferInfo->buffer)->GetSize() - pBufferInfo->offset;
@@ -295,9 +334,9 @@ void DescriptorUpdate::WriteBufferInfoDescriptors(
             }
 
             pPalDevice->CreateUntypedBufferViewSrds(1, &info, pDestAddr);
-        }
 
-        pBufferInfo = static_cast<const VkDescriptorBufferInfo*>(Util::VoidPtrInc(pBufferInfo, bufferInfoStride));
+            pBufferInfo = static_cast<const VkDescriptorBufferInfo*>(Util::VoidPtrInc(pBufferInfo, bufferInfoStride));
+        }
     }
 }
 
@@ -313,6 +352,72 @@ void DescriptorUpdate::WriteInlineUniformBlock(
     memcpy(pDestAddr + dwStride, pData, count);
 }
 
+// =====================================================================================================================
+// Extends a descriptor write with the following writes as long as they continue it, i.e. they update the next array
+// elements of the same binding from the next elements of the same source array.  Returns the number of merged writes.
+uint32_t DescriptorUpdate::MergeAdjacentWrites(
+    VkWriteDescriptorSet*        pWrite,
+    const VkWriteDescriptorSet*  pNextWrites,
+    uint32_t                     nextWriteCount)
+{
+    uint32_t mergeCount = 0;
+
+    // Inline uniform blocks and other extended writes are never merged
+    if (pWrite->pNext == nullptr)
+    {
+        while (mergeCount < nextWriteCount)
+        {
+            const VkWriteDescriptorSet& next = pNextWrites[mergeCount];
+
+            bool contiguous = (next.pNext           == nullptr)              &&
+                              (next.dstSet          == pWrite->dstSet)       &&
+                              (next.dstBinding      == pWrite->dstBinding)   &&
+                              (next.descriptorType  == pWrite->descriptorType) &&
+                              (next.dstArrayElement == (pWrite->dstArrayElement + pWrite->descriptorCount));
+
+            if (contiguous)
+            {
+                switch (static_cast<uint32_t>(pWrite->descriptorType))
+                {
+                case VK_DESCRIPTOR_TYPE_SAMPLER:
+                case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+                case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+                case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                    contiguous = (next.pImageInfo == (pWrite->pImageInfo + pWrite->descriptorCount));
+                    break;
+
+                case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+                case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                    contiguous = (next.pTexelBufferView == (pWrite->pTexelBufferView + pWrite->descriptorCount));
+                    break;
+
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                    contiguous = (next.pBufferInfo == (pWrite->pBufferInfo + pWrite->descriptorCount));
+                    break;
+
+                default:
+                    contiguous = false;
+                    break;
+                }
+            }
+
+            if (contiguous == false)
+            {
+                break;
+            }
+
+            pWrite->descriptorCount += next.descriptorCount;
+            mergeCount++;
+        }
+    }
+
+    return mergeCount;
+}
+
 // =====================================================================================================================
 // Write to descriptor sets using the provided descriptors for resources
 template <size_t imageDescSize,
@@ -327,9 +432,12 @@ void DescriptorUpdate::WriteDescriptorSets(
     uint32_t                     descriptorWriteCount,
     const VkWriteDescriptorSet*  pDescriptorWrites)
 {
-    for (uint32_t i = 0; i < descriptorWriteCount; ++i)
+    for (uint32_t i = 0; i < descriptorWriteCount; )
     {
-        const VkWriteDescriptorSet& params = pDescriptorWrites[i];
+        // Write runs of adjacent writes to consecutive array elements of the same binding as a single write
+        VkWriteDescriptorSet params = pDescriptorWrites[i];
+
+        i += MergeAdjacentWrites(&params, &pDescriptorWrites[i + 1], descriptorWriteCount - i - 1) + 1;
 
         VK_ASSERT(params.sType == VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET);
 
@@ -521,6 +629,8 @@ void DescriptorUpdate::WriteDescriptorSets(
             break;
         }
     }
+
+    FlushDescriptorStores();
 }
 
 // =====================================================================================================================
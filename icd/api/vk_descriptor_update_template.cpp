@@ -67,7 +67,9 @@ VkResult DescriptorUpdateTemplate::Create(
         // we don't support VK_KHR_push_descriptors.
         VK_ASSERT(pCreateInfo->templateType == VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET);
 
-        TemplateUpdateInfo* pEntries = static_cast<TemplateUpdateInfo*>(Util::VoidPtrInc(pSysMem, apiSize));
+        TemplateUpdateInfo* pEntries   = static_cast<TemplateUpdateInfo*>(Util::VoidPtrInc(pSysMem, apiSize));
+        uint32_t            entryCount = 0;
+        bool                canFuse    = false;
 
         for (uint32_t ii = 0; ii < numEntries; ii++)
         {
@@ -86,23 +88,35 @@ VkResult DescriptorUpdateTemplate::Create(
                 dstArrayElement = srcEntry.dstArrayElement;
             }
 
-            pEntries[ii].descriptorCount                = srcEntry.descriptorCount;
-            pEntries[ii].srcOffset                      = srcEntry.offset;
-            pEntries[ii].srcStride                      = srcEntry.stride;
-            pEntries[ii].dstBindStaDwArrayStride        = dstBinding.sta.dwArrayStride;
-            pEntries[ii].dstBindDynDataDwArrayStride    = dstBinding.dyn.dwArrayStride;
+            TemplateUpdateInfo entry;
 
-            pEntries[ii].dstStaOffset                   =
+            entry.descriptorCount                = srcEntry.descriptorCount;
+            entry.srcOffset                      = srcEntry.offset;
+            entry.srcStride                      = srcEntry.stride;
+            entry.dstBindStaDwArrayStride        = dstBinding.sta.dwArrayStride;
+            entry.dstBindDynDataDwArrayStride    = dstBinding.dyn.dwArrayStride;
+
+            entry.dstStaOffset                   =
                 pLayout->GetDstStaOffset(dstBinding, dstArrayElement);
 
-            pEntries[ii].dstDynOffset                   =
+            entry.dstDynOffset                   =
                 pLayout->GetDstDynOffset(dstBinding, dstArrayElement);
 
-            pEntries[ii].pFunc                          =
+            entry.pFunc                          =
                 GetUpdateEntryFunc(pDevice, srcEntry.descriptorType, dstBinding);
+
+            // The descriptor count of inline uniform blocks is a byte size so those entries are never fused.
+            const bool isFusable = (srcEntry.descriptorType != VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT);
+
+            if ((canFuse && isFusable && FuseEntries(&pEntries[entryCount - 1], entry)) == false)
+            {
+                pEntries[entryCount++] = entry;
+            }
+
+            canFuse = isFusable;
         }
 
-        VK_PLACEMENT_NEW(pSysMem) DescriptorUpdateTemplate(pCreateInfo->descriptorUpdateEntryCount);
+        VK_PLACEMENT_NEW(pSysMem) DescriptorUpdateTemplate(entryCount);
 
         *pDescriptorUpdateTemplate = DescriptorUpdateTemplate::HandleFromVoidPointer(pSysMem);
     }
@@ -110,6 +124,39 @@ VkResult DescriptorUpdateTemplate::Create(
     return result;
 }
 
+// =====================================================================================================================
+// Appends an update entry to the previous one if the two form a single contiguous run, i.e. they are written by the same
+// function with the same strides and the second one continues both the source data and the destination ranges of the
+// first one.  This way runs of entries, typically the consecutive bindings of a material, are written by a single
+// call.  Returns whether the entry was fused.
+bool DescriptorUpdateTemplate::FuseEntries(
+    TemplateUpdateInfo*         pPrevEntry,
+    const TemplateUpdateInfo&   entry)
+{
+    // The source stride of a single descriptor doesn't matter, so such an entry takes the stride of the next one.
+    const size_t srcStride = (pPrevEntry->descriptorCount == 1) ? entry.srcStride : pPrevEntry->srcStride;
+    const size_t count     = pPrevEntry->descriptorCount;
+
+    const bool fusable = (entry.pFunc                       == pPrevEntry->pFunc)                       &&
+                         (entry.dstBindStaDwArrayStride     == pPrevEntry->dstBindStaDwArrayStride)     &&
+                         (entry.dstBindDynDataDwArrayStride == pPrevEntry->dstBindDynDataDwArrayStride) &&
+                         ((entry.srcStride == srcStride) || (entry.descriptorCount == 1))               &&
+                         (srcStride != 0)                                                               &&
+                         (entry.srcOffset    == (pPrevEntry->srcOffset + (count * srcStride)))          &&
+                         (entry.dstStaOffset == (pPrevEntry->dstStaOffset +
+                                                 (count * pPrevEntry->dstBindStaDwArrayStride)))        &&
+                         (entry.dstDynOffset == (pPrevEntry->dstDynOffset +
+                                                 (count * pPrevEntry->dstBindDynDataDwArrayStride)));
+
+    if (fusable)
+    {
+        pPrevEntry->srcStride        = srcStride;
+        pPrevEntry->descriptorCount += entry.descriptorCount;
+    }
+
+    return fusable;
+}
+
 // =====================================================================================================================
 template <size_t imageDescSize,
           size_t fmaskDescSize,
@@ -299,6 +346,8 @@ void DescriptorUpdateTemplate::Update(
 
         pEntries[i].pFunc(pDevice, descriptorSet, pDescriptorInfo, pEntries[i]);
     }
+
+    DescriptorUpdate::FlushDescriptorStores();
 }
 
 // =====================================================================================================================
@@ -68,6 +68,7 @@
 #include "include/vk_swapchain.h"
 #include "include/vk_utils.h"
 #include "include/vk_conv.h"
+#include "include/compile_thread_pool.h"
 #include "include/internal_layer_hooks.h"
 
 #include "sqtt/sqtt_layer.h"
@@ -224,8 +225,10 @@ Device::Device(
     m_dispatchTable(DispatchTable::Type::DEVICE, m_pInstance, this),
     m_pSqttMgr(nullptr),
     m_pAsyncLayer(nullptr),
+    m_pCompileThreadPool(nullptr),
     m_pAppOptLayer(nullptr),
     m_pBarrierFilterLayer(nullptr),
+    m_sharedShaderModules(64, pPhysicalDevices[DefaultDeviceIndex]->VkInstance()->Allocator()),
     m_allocationSizeTracking(m_settings.memoryDeviceOverallocationAllowed ? false : true),
     m_useComputeAsTransferQueue(useComputeAsTransferQueue)
     , m_scalarBlockLayoutEnabled(false)
@@ -1153,6 +1156,9 @@ VkResult Device::Initialize(
 
     memcpy(&m_pQueues, pQueues, sizeof(m_pQueues));
 
+    memset(m_pSubmitThreadQueues, 0, sizeof(m_pSubmitThreadQueues));
+    m_submitThreadCount = 0;
+
     Pal::DeviceProperties deviceProps = {};
     result = PalToVkResult(PalDevice(DefaultDeviceIndex)->GetProperties(&deviceProps));
 
@@ -1201,6 +1207,39 @@ VkResult Device::Initialize(
         result = PalToVkResult(PalDevice(DefaultDeviceIndex)->SetSamplePatternPalette(palette));
     }
 
+    // The submission threads are not used with tracing, which expects submits to happen on the application's thread.
+    // They are an optimization: queues beyond Queue::MaxSubmitThreads, and queues whose thread fails to start, submit on
+    // the calling thread.
+    if ((result == VK_SUCCESS) &&
+        (GetRuntimeSettings().queueSubmitThreadRingSize > 0) &&
+        (VkInstance()->IsTracingSupportEnabled() == false))
+    {
+        for (uint32_t i = 0; i < Queue::MaxQueueFamilies; ++i)
+        {
+            for (uint32_t j = 0;
+                (j < Queue::MaxQueuesPerFamily) && (m_pQueues[i][j] != nullptr) &&
+                (m_submitThreadCount < Queue::MaxSubmitThreads);
+                ++j)
+            {
+                Queue* pQueue = static_cast<Queue*>(*m_pQueues[i][j]);
+
+                const VkResult threadResult = pQueue->InitSubmitThread(
+                    GetRuntimeSettings().queueSubmitThreadRingSize,
+                    m_submitThreadCount);
+
+                if (threadResult == VK_SUCCESS)
+                {
+                    m_pSubmitThreadQueues[m_submitThreadCount++] = pQueue;
+                }
+                else
+                {
+                    VK_ALERT_ALWAYS_MSG("Queue submission thread for family %u index %u failed to start (%d); "
+                                        "submitting on the calling thread.", i, j, threadResult);
+                }
+            }
+        }
+    }
+
     if ((result == VK_SUCCESS) && VkInstance()->IsTracingSupportEnabled())
     {
         uint32_t queueFamilyIndex;
@@ -1311,11 +1350,42 @@ VkResult Device::Initialize(
             result = VK_ERROR_OUT_OF_HOST_MEMORY;
         }
     }
+
+    if ((result == VK_SUCCESS) && (m_settings.pipelineCompileThreadCount != 0))
+    {
+        uint32_t threadCount = m_settings.pipelineCompileThreadCount;
+
+        if (threadCount == UINT32_MAX)
+        {
+            // The thread calling vkCreate*Pipelines also compiles, so leave one logical core for it.
+            Util::SystemInfo sysInfo = {};
+            Util::QuerySystemInfo(&sysInfo);
+
+            threadCount = (sysInfo.cpuLogicalCoreCount > 1) ? (sysInfo.cpuLogicalCoreCount - 1) : 0;
+        }
+
+        // Parallel pipeline creation is only an optimization, so fall back to serial creation on failure.
+        if ((threadCount > 0) &&
+            (CompileThreadPool::Create(this, threadCount, &m_pCompileThreadPool) != VK_SUCCESS))
+        {
+            m_pCompileThreadPool = nullptr;
+        }
+    }
     if (result == VK_SUCCESS)
     {
         result = PalToVkResult(m_memoryMutex.Init());
     }
 
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(m_sharedShaderModuleLock.Init());
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(m_sharedShaderModules.Init());
+    }
+
     if (result == VK_SUCCESS)
     {
         // For apps running on APU, disable allocation size tracking, allocate remote heap instead when local heap is used up.
@@ -1625,6 +1695,8 @@ uint32_t Device::GetDefaultSamplePatternIndex(
 // Destroy Vulkan device. Destroy underlying PAL device, call destructor and free memory.
 VkResult Device::Destroy(const VkAllocationCallbacks* pAllocator)
 {
+    FlushQueueSubmitThreads(GetSubmitThreadQueueMask());
+
 #if ICD_GPUOPEN_DEVMODE_BUILD
     if (VkInstance()->GetDevModeMgr() != nullptr)
     {
@@ -1668,6 +1740,17 @@ VkResult Device::Destroy(const VkAllocationCallbacks* pAllocator)
         VkInstance()->FreeMem(m_pAsyncLayer);
     }
 
+    if (m_pCompileThreadPool != nullptr)
+    {
+        m_pCompileThreadPool->Destroy();
+    }
+
+    // Write out pipeline binaries the internal caches still hold in their background write queues.
+    for (uint32_t deviceIdx = 0; deviceIdx < NumPalDevices(); deviceIdx++)
+    {
+        GetCompiler(deviceIdx)->FlushBinaryCache();
+    }
+
     for (uint32_t i = 0; i < Queue::MaxQueueFamilies; ++i)
     {
         for (uint32_t j = 0; (j < Queue::MaxQueuesPerFamily) && (m_pQueues[i][j] != nullptr); ++j)
@@ -1683,6 +1766,8 @@ VkResult Device::Destroy(const VkAllocationCallbacks* pAllocator)
 
     DestroyInternalPipelines();
 
+    ShaderModule::DestroySharedModules(this);
+
     for (uint32_t deviceIdx = 0; deviceIdx < NumPalDevices(); deviceIdx++)
     {
         if (m_perGpu[deviceIdx].pSharedPalCmdAllocator != nullptr)
@@ -1973,6 +2058,21 @@ VkResult Device::WaitIdle(void)
     return result;
 }
 
+// =====================================================================================================================
+// Wait until the submission threads of the queues in submitQueueMask have passed all queued vkQueueSubmit calls to PAL.
+// Called before waiting on or querying objects a queued submit may signal; the fences and semaphores record the masks
+// of the queues they were submitted to.
+void Device::FlushQueueSubmitThreads(
+    uint32_t submitQueueMask)
+{
+    utils::IterateMask queues(submitQueueMask & GetSubmitThreadQueueMask());
+
+    while (queues.Iterate())
+    {
+        m_pSubmitThreadQueues[queues.Index()]->FlushSubmitThread();
+    }
+}
+
 // =====================================================================================================================
 // Creates a new GPU memory object
 VkResult Device::AllocMemory(
@@ -2037,48 +2137,88 @@ VkResult Device::WaitForFences(
     Pal::Result palResult = Pal::Result::Success;
 
     Pal::IFence** ppPalFences = static_cast<Pal::IFence**>(VK_ALLOC_A(sizeof(Pal::IFence*) * fenceCount));
+    Fence**       ppFences    = static_cast<Fence**>(VK_ALLOC_A(sizeof(Fence*) * fenceCount));
+
+    // Fences already known to be signaled are not passed on to PAL.  If that leaves nothing to wait for, or any one
+    // fence is enough and one is already signaled, the wait is over without a kernel call.
+    uint32_t pendingCount    = 0;
+    uint32_t submitQueueMask = 0;
+    bool     anySignaled     = false;
 
-    if (IsMultiGpu() == false)
+    for (uint32_t i = 0; i < fenceCount; ++i)
     {
-        for (uint32_t i = 0; i < fenceCount; ++i)
+        Fence* pFence = Fence::ObjectFromHandle(pFences[i]);
+
+        if (pFence->IsKnownSignaled())
         {
-            ppPalFences[i] = Fence::ObjectFromHandle(pFences[i])->PalFence(DefaultDeviceIndex);
+            anySignaled = true;
+        }
+        else
+        {
+            ppFences[pendingCount++] = pFence;
+            submitQueueMask         |= pFence->GetSubmitQueueMask();
         }
-
-        palResult = PalDevice(DefaultDeviceIndex)->WaitForFences(fenceCount, ppPalFences, waitAll != VK_FALSE, timeout);
     }
-    else
+
+    if ((pendingCount > 0) && (((waitAll == VK_FALSE) && anySignaled) == false))
     {
-        for (uint32_t deviceIdx = 0;
-             (deviceIdx < NumPalDevices()) && (palResult == Pal::Result::Success);
-             deviceIdx++)
+        FlushQueueSubmitThreads(submitQueueMask);
+
+        if (IsMultiGpu() == false)
         {
-            const uint32_t currentDeviceMask = 1 << deviceIdx;
+            for (uint32_t i = 0; i < pendingCount; ++i)
+            {
+                ppPalFences[i] = ppFences[i]->PalFence(DefaultDeviceIndex);
+            }
 
-            uint32_t perDeviceFenceCount = 0;
-            for (uint32_t i = 0; i < fenceCount; ++i)
+            palResult = PalDevice(DefaultDeviceIndex)->WaitForFences(pendingCount,
+                                                                     ppPalFences,
+                                                                     waitAll != VK_FALSE,
+                                                                     timeout);
+        }
+        else
+        {
+            for (uint32_t deviceIdx = 0;
+                 (deviceIdx < NumPalDevices()) && (palResult == Pal::Result::Success);
+                 deviceIdx++)
             {
-                Fence* pFence = Fence::ObjectFromHandle(pFences[i]);
+                const uint32_t currentDeviceMask = 1 << deviceIdx;
+
+                uint32_t perDeviceFenceCount = 0;
+                for (uint32_t i = 0; i < pendingCount; ++i)
+                {
+                    Fence* pFence = ppFences[i];
 
-                // Some conformance tests will wait on fences that were never submitted, so use only the first device
-                // for these cases.
-                const bool forceWait = (pFence->GetActiveDeviceMask() == 0) && (deviceIdx == DefaultDeviceIndex);
+                    // Some conformance tests will wait on fences that were never submitted, so use only the first
+                    // device for these cases.
+                    const bool forceWait = (pFence->GetActiveDeviceMask() == 0) && (deviceIdx == DefaultDeviceIndex);
 
-                if (forceWait || ((currentDeviceMask & pFence->GetActiveDeviceMask()) != 0))
+                    if (forceWait || ((currentDeviceMask & pFence->GetActiveDeviceMask()) != 0))
+                    {
+                        ppPalFences[perDeviceFenceCount++] = pFence->PalFence(deviceIdx);
+                    }
+                }
+
+                if (perDeviceFenceCount > 0)
                 {
-                    ppPalFences[perDeviceFenceCount++] = pFence->PalFence(deviceIdx);
+                    palResult = PalDevice(deviceIdx)->WaitForFences(perDeviceFenceCount,
+                                                                    ppPalFences,
+                                                                    waitAll != VK_FALSE,
+                                                                    timeout);
                 }
             }
+        }
 
-            if (perDeviceFenceCount > 0)
+        // Only a successful wait for all fences says which ones are signaled.
+        if ((palResult == Pal::Result::Success) && (waitAll != VK_FALSE))
+        {
+            for (uint32_t i = 0; i < pendingCount; ++i)
             {
-                palResult = PalDevice(deviceIdx)->WaitForFences(perDeviceFenceCount,
-                                                                ppPalFences,
-                                                                waitAll != VK_FALSE,
-                                                                timeout);
+                ppFences[i]->SetKnownSignaled();
             }
         }
     }
+
     return PalToVkResult(palResult);
 }
 
@@ -2089,27 +2229,45 @@ VkResult Device::ResetFences(
     const VkFence* pFences)
 {
     Pal::IFence** ppPalFences = static_cast<Pal::IFence**>(VK_ALLOC_A(sizeof(Pal::IFence*) * fenceCount));
+    Fence**       ppFences    = static_cast<Fence**>(VK_ALLOC_A(sizeof(Fence*) * fenceCount));
 
     Pal::Result palResult = Pal::Result::Success;
 
-    // Clear the wait masks for each fence
+    // Clear the wait masks for each fence, and collect the fences whose PAL fences may not be reset already.  Fences
+    // that were never submitted since they were created or last reset don't need a kernel call.
+    uint32_t resetCount = 0;
+
     for (uint32_t i = 0; i < fenceCount; ++i)
     {
-        Fence::ObjectFromHandle(pFences[i])->ClearActiveDeviceMask();
-        Fence::ObjectFromHandle(pFences[i])->RestoreFence(this);
+        Fence* pFence = Fence::ObjectFromHandle(pFences[i]);
+
+        if (pFence->NeedsPalReset())
+        {
+            ppFences[resetCount++] = pFence;
+        }
+
+        pFence->ClearActiveDeviceMask();
+        pFence->RestoreFence(this);
     }
 
     for (uint32_t deviceIdx = 0;
-        (deviceIdx < NumPalDevices()) && (palResult == Pal::Result::Success);
+        (deviceIdx < NumPalDevices()) && (palResult == Pal::Result::Success) && (resetCount > 0);
         deviceIdx++)
     {
-        for (uint32_t i = 0; i < fenceCount; ++i)
+        for (uint32_t i = 0; i < resetCount; ++i)
         {
-            Fence* pFence = Fence::ObjectFromHandle(pFences[i]);
-            ppPalFences[i] = pFence->PalFence(deviceIdx);
+            ppPalFences[i] = ppFences[i]->PalFence(deviceIdx);
         }
 
-        palResult = PalDevice(deviceIdx)->ResetFences(fenceCount, ppPalFences);
+        palResult = PalDevice(deviceIdx)->ResetFences(resetCount, ppPalFences);
+    }
+
+    if (palResult == Pal::Result::Success)
+    {
+        for (uint32_t i = 0; i < fenceCount; ++i)
+        {
+            Fence::ObjectFromHandle(pFences[i])->ClearSignaledState();
+        }
     }
 
     return PalToVkResult(palResult);
@@ -2244,6 +2402,99 @@ VkResult Device::CreateImageView(
     return ImageView::Create(this, pCreateInfo, pAllocator, 0, pView);
 }
 
+// =====================================================================================================================
+// Arguments of a multi-pipeline creation call shared by the CompileThreadPool jobs.
+template<typename CreateInfo>
+struct PipelineCreateBatch
+{
+    Device*                         pDevice;
+    PipelineCache*                  pPipelineCache;
+    const CreateInfo*               pCreateInfos;
+    const VkAllocationCallbacks*    pAllocator;
+    VkPipeline*                     pPipelines;
+    VkResult*                       pResults;       // Per create info result
+    const uint32_t*                 pIndices;       // Create info indices of the jobs of the wave currently executed
+};
+
+// =====================================================================================================================
+// CompileThreadPool job creating a single pipeline of a PipelineCreateBatch.
+template<typename PipelineType, typename CreateInfo>
+static void CreatePipelineJob(
+    void*    pJobData,
+    uint32_t index)
+{
+    PipelineCreateBatch<CreateInfo>* pBatch = static_cast<PipelineCreateBatch<CreateInfo>*>(pJobData);
+
+    index = pBatch->pIndices[index];
+
+    pBatch->pResults[index] = PipelineType::Create(
+        pBatch->pDevice,
+        pBatch->pPipelineCache,
+        &pBatch->pCreateInfos[index],
+        pBatch->pAllocator,
+        &pBatch->pPipelines[index]);
+
+    // In case of failure, VK_NULL_HANDLE must be set
+    VK_ASSERT((pBatch->pResults[index] == VK_SUCCESS) || (pBatch->pPipelines[index] == VK_NULL_HANDLE));
+}
+
+// =====================================================================================================================
+// Creates the pipelines of a multi-pipeline creation call on the compile thread pool.  The create infos are split into
+// waves by their derivative depth: a pipeline naming a base pipeline of the same batch through basePipelineIndex is
+// only created in a wave after the one of its base pipeline, keeping the order of the serial path for such pairs.
+//
+// pScratch must have room for 2 * count indices.
+template<typename PipelineType, typename CreateInfo>
+static void ExecutePipelineBatch(
+    CompileThreadPool*               pThreadPool,
+    uint32_t                         count,
+    uint32_t*                        pScratch,
+    PipelineCreateBatch<CreateInfo>* pBatch)
+{
+    uint32_t* pDepths  = pScratch;
+    uint32_t* pOrder   = pScratch + count;
+    uint32_t  maxDepth = 0;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const CreateInfo& createInfo = pBatch->pCreateInfos[i];
+
+        pDepths[i] = 0;
+
+        // Valid usage requires basePipelineIndex to be less than the index of the derivative pipeline.
+        if (((createInfo.flags & VK_PIPELINE_CREATE_DERIVATIVE_BIT) != 0) &&
+            (createInfo.basePipelineHandle == VK_NULL_HANDLE)            &&
+            (createInfo.basePipelineIndex >= 0)                           &&
+            (static_cast<uint32_t>(createInfo.basePipelineIndex) < i))
+        {
+            pDepths[i] = pDepths[createInfo.basePipelineIndex] + 1;
+            maxDepth   = Util::Max(maxDepth, pDepths[i]);
+        }
+    }
+
+    uint32_t waveStart = 0;
+
+    for (uint32_t depth = 0; depth <= maxDepth; ++depth)
+    {
+        uint32_t waveSize = 0;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (pDepths[i] == depth)
+            {
+                pOrder[waveStart + waveSize] = i;
+                waveSize++;
+            }
+        }
+
+        pBatch->pIndices = &pOrder[waveStart];
+
+        pThreadPool->Execute(waveSize, CreatePipelineJob<PipelineType, CreateInfo>, pBatch);
+
+        waveStart += waveSize;
+    }
+}
+
 // =====================================================================================================================
 VkResult Device::CreateGraphicsPipelines(
     VkPipelineCache                             pipelineCache,
@@ -2264,25 +2515,62 @@ VkResult Device::CreateGraphicsPipelines(
         pPipelines[i] = VK_NULL_HANDLE;
     }
 
-    for (uint32_t i = 0; i < count; ++i)
+    PipelineCreateBatch<VkGraphicsPipelineCreateInfo> batch = {};
+    batch.pDevice        = this;
+    batch.pPipelineCache = pPipelineCache;
+    batch.pCreateInfos   = pCreateInfos;
+    batch.pAllocator     = pAllocator;
+    batch.pPipelines     = pPipelines;
+
+    if ((m_pCompileThreadPool != nullptr) && (count > 1))
+    {
+        // The results are followed by the scratch indices of ExecutePipelineBatch().
+        batch.pResults = static_cast<VkResult*>(VkInstance()->AllocMem(
+            count * (sizeof(VkResult) + (2 * sizeof(uint32_t))),
+            VK_SYSTEM_ALLOCATION_SCOPE_COMMAND));
+    }
+
+    if (batch.pResults != nullptr)
     {
-        const VkGraphicsPipelineCreateInfo* pCreateInfo = &pCreateInfos[i];
+        ExecutePipelineBatch<GraphicsPipeline>(m_pCompileThreadPool,
+                                               count,
+                                               reinterpret_cast<uint32_t*>(&batch.pResults[count]),
+                                               &batch);
 
-        VkResult result = GraphicsPipeline::Create(
-            this,
-            pPipelineCache,
-            pCreateInfo,
-            pAllocator,
-            &pPipelines[i]);
+        // Report the failure of the lowest index, matching the serial path below.
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (batch.pResults[i] != VK_SUCCESS)
+            {
+                finalResult = batch.pResults[i];
+                break;
+            }
+        }
 
-        if (result != VK_SUCCESS)
+        VkInstance()->FreeMem(batch.pResults);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < count; ++i)
         {
-            // In case of failure, VK_NULL_HANDLE must be set
-            VK_ASSERT(pPipelines[i] == VK_NULL_HANDLE);
+            const VkGraphicsPipelineCreateInfo* pCreateInfo = &pCreateInfos[i];
+
+            VkResult result = GraphicsPipeline::Create(
+                this,
+                pPipelineCache,
+                pCreateInfo,
+                pAllocator,
+                &pPipelines[i]);
+
+            if (result != VK_SUCCESS)
+            {
+                // In case of failure, VK_NULL_HANDLE must be set
+                VK_ASSERT(pPipelines[i] == VK_NULL_HANDLE);
 
-            // Capture the first failure result and save it to be returned
-            finalResult = (finalResult != VK_SUCCESS) ? finalResult : result;
+                // Capture the first failure result and save it to be returned
+                finalResult = (finalResult != VK_SUCCESS) ? finalResult : result;
 
+            }
         }
     }
 
@@ -2309,25 +2597,62 @@ VkResult Device::CreateComputePipelines(
         pPipelines[i] = VK_NULL_HANDLE;
     }
 
-    for (uint32_t i = 0; i < count; ++i)
+    PipelineCreateBatch<VkComputePipelineCreateInfo> batch = {};
+    batch.pDevice        = this;
+    batch.pPipelineCache = pPipelineCache;
+    batch.pCreateInfos   = pCreateInfos;
+    batch.pAllocator     = pAllocator;
+    batch.pPipelines     = pPipelines;
+
+    if ((m_pCompileThreadPool != nullptr) && (count > 1))
     {
-        const VkComputePipelineCreateInfo* pCreateInfo = &pCreateInfos[i];
+        // The results are followed by the scratch indices of ExecutePipelineBatch().
+        batch.pResults = static_cast<VkResult*>(VkInstance()->AllocMem(
+            count * (sizeof(VkResult) + (2 * sizeof(uint32_t))),
+            VK_SYSTEM_ALLOCATION_SCOPE_COMMAND));
+    }
 
-        VkResult result = ComputePipeline::Create(
-            this,
-            pPipelineCache,
-            pCreateInfo,
-            pAllocator,
-            &pPipelines[i]);
+    if (batch.pResults != nullptr)
+    {
+        ExecutePipelineBatch<ComputePipeline>(m_pCompileThreadPool,
+                                              count,
+                                              reinterpret_cast<uint32_t*>(&batch.pResults[count]),
+                                              &batch);
 
-        if (result != VK_SUCCESS)
+        // Report the failure of the lowest index, matching the serial path below.
+        for (uint32_t i = 0; i < count; ++i)
         {
-            // In case of failure, VK_NULL_HANDLE must be set
-            VK_ASSERT(pPipelines[i] == VK_NULL_HANDLE);
+            if (batch.pResults[i] != VK_SUCCESS)
+            {
+                finalResult = batch.pResults[i];
+                break;
+            }
+        }
 
-            // Capture the first failure result and save it to be returned
-            finalResult = (finalResult != VK_SUCCESS) ? finalResult : result;
+        VkInstance()->FreeMem(batch.pResults);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const VkComputePipelineCreateInfo* pCreateInfo = &pCreateInfos[i];
+
+            VkResult result = ComputePipeline::Create(
+                this,
+                pPipelineCache,
+                pCreateInfo,
+                pAllocator,
+                &pPipelines[i]);
 
+            if (result != VK_SUCCESS)
+            {
+                // In case of failure, VK_NULL_HANDLE must be set
+                VK_ASSERT(pPipelines[i] == VK_NULL_HANDLE);
+
+                // Capture the first failure result and save it to be returned
+                finalResult = (finalResult != VK_SUCCESS) ? finalResult : result;
+
+            }
         }
     }
 
@@ -2641,6 +2966,8 @@ VkResult Device::GetSemaphoreCounterValueKHR(
 {
     Semaphore* pSemaphore = Semaphore::ObjectFromHandle(semaphore);
 
+    FlushQueueSubmitThreads(pSemaphore->GetSubmitQueueMask());
+
     return pSemaphore->GetSemaphoreCounterValue(this, pSemaphore, pValue);
 }
 
@@ -2652,24 +2979,64 @@ VkResult Device::WaitSemaphoresKHR(
     Pal::Result palResult = Pal::Result::Success;
     uint32_t flags = 0;
 
+    const bool waitAny = (pWaitInfo->flags == VK_SEMAPHORE_WAIT_ANY_BIT_KHR);
+
     Pal::IQueueSemaphore** ppPalSemaphores = static_cast<Pal::IQueueSemaphore**>(VK_ALLOC_A(
                 sizeof(Pal::IQueueSemaphore*) * pWaitInfo->semaphoreCount));
+    Semaphore** ppSemaphores = static_cast<Semaphore**>(VK_ALLOC_A(
+                sizeof(Semaphore*) * pWaitInfo->semaphoreCount));
+    uint64_t* pValues = static_cast<uint64_t*>(VK_ALLOC_A(sizeof(uint64_t) * pWaitInfo->semaphoreCount));
+
+    // Only the semaphores that are not already known to have reached their values are passed on to PAL, all of them
+    // in a single wait.  Nothing has to be waited for if that leaves no semaphore, or if any one is enough and it
+    // has already been reached.
+    uint32_t pendingCount    = 0;
+    uint32_t submitQueueMask = 0;
+    bool     anyReached      = false;
 
     for (uint32_t i = 0; i < pWaitInfo->semaphoreCount; ++i)
     {
         Semaphore* currentSemaphore = Semaphore::ObjectFromHandle(pWaitInfo->pSemaphores[i]);
-        ppPalSemaphores[i] = currentSemaphore->PalSemaphore(DefaultDeviceIndex);
+
+        if (currentSemaphore->IsValueReached(pWaitInfo->pValues[i]))
+        {
+            anyReached = true;
+        }
+        else
+        {
+            ppPalSemaphores[pendingCount] = currentSemaphore->PalSemaphore(DefaultDeviceIndex);
+            ppSemaphores[pendingCount]    = currentSemaphore;
+            pValues[pendingCount]         = pWaitInfo->pValues[i];
+            submitQueueMask              |= currentSemaphore->GetSubmitQueueMask();
+            pendingCount++;
+        }
+
         currentSemaphore->RestoreSemaphore();
     }
 
-#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 508
-    if (pWaitInfo->flags == VK_SEMAPHORE_WAIT_ANY_BIT_KHR)
+    if ((pendingCount > 0) && ((waitAny && anyReached) == false))
     {
-        flags |= Pal::HostWaitFlags::HostWaitAny;
-    }
-    palResult = PalDevice(DefaultDeviceIndex)->WaitForSemaphores(pWaitInfo->semaphoreCount, ppPalSemaphores,
-            pWaitInfo->pValues, flags, timeout);
+        FlushQueueSubmitThreads(submitQueueMask);
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 508
+        if (waitAny)
+        {
+            flags |= Pal::HostWaitFlags::HostWaitAny;
+        }
+        palResult = PalDevice(DefaultDeviceIndex)->WaitForSemaphores(pendingCount, ppPalSemaphores,
+                pValues, flags, timeout);
+
+        // Only a successful wait for all of the semaphores proves that each one reached its value.
+        if ((palResult == Pal::Result::Success) && (waitAny == false))
+        {
+            for (uint32_t i = 0; i < pendingCount; ++i)
+            {
+                ppSemaphores[i]->UpdateCompletedValue(ppPalSemaphores[i], pValues[i]);
+            }
+        }
 #endif
+    }
+
     return PalToVkResult(palResult);
 }
 
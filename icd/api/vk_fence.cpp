@@ -115,7 +115,10 @@ VkResult Fence::Create(
     if (palResult == Pal::Result::Success)
     {
         // On success, wrap it in an API object and return to application
-        VK_PLACEMENT_NEW (pMemory) Fence(numGroupedFences, pPalFences, palFenceCreateInfo.flags.eventCanBeInherited);
+        VK_PLACEMENT_NEW (pMemory) Fence(numGroupedFences,
+                                         pPalFences,
+                                         palFenceCreateInfo.flags.eventCanBeInherited,
+                                         palFenceCreateInfo.flags.signaled);
 
         *pFence = Fence::HandleFromVoidPointer(pMemory);
 
@@ -156,35 +159,42 @@ VkResult Fence::Destroy(
 // Retrieve the status of a fence object
 VkResult Fence::GetStatus(void)
 {
-    Pal::Result palResult = Pal::Result::Success;
+    VkResult result = VK_SUCCESS;
 
-    for (uint32_t deviceIdx = 0; (deviceIdx < m_groupedFenceCount) && (palResult == Pal::Result::Success); deviceIdx++)
+    if (m_knownSignaled == false)
     {
-        // Some conformance tests will wait on fences that were never submitted, so use only the first device
-        // for these cases.
-        const bool forceWait = (m_activeDeviceMask == 0) && (deviceIdx == DefaultDeviceIndex);
+        Pal::Result palResult = Pal::Result::Success;
 
-        if (forceWait || ((m_activeDeviceMask & (1 << deviceIdx)) != 0))
+        for (uint32_t deviceIdx = 0;
+             (deviceIdx < m_groupedFenceCount) && (palResult == Pal::Result::Success);
+             deviceIdx++)
         {
-            palResult = PalFence(deviceIdx)->GetStatus();
+            // Some conformance tests will wait on fences that were never submitted, so use only the first device
+            // for these cases.
+            const bool forceWait = (m_activeDeviceMask == 0) && (deviceIdx == DefaultDeviceIndex);
+
+            if (forceWait || ((m_activeDeviceMask & (1 << deviceIdx)) != 0))
+            {
+                palResult = PalFence(deviceIdx)->GetStatus();
+            }
         }
-    }
 
-    VkResult result = VK_SUCCESS;
+        if (palResult == Pal::Result::Success)
+        {
+            result = VK_SUCCESS;
 
-    if (palResult == Pal::Result::Success)
-    {
-        result = VK_SUCCESS;
-    }
-    else if ((palResult == Pal::Result::ErrorUnavailable) ||
-             (palResult == Pal::Result::NotReady)         ||
-             (palResult == Pal::Result::ErrorFenceNeverSubmitted))
-    {
-        result = VK_NOT_READY;
-    }
-    else
-    {
-        result = PalToVkResult(palResult);
+            m_knownSignaled = true;
+        }
+        else if ((palResult == Pal::Result::ErrorUnavailable) ||
+                 (palResult == Pal::Result::NotReady)         ||
+                 (palResult == Pal::Result::ErrorFenceNeverSubmitted))
+        {
+            result = VK_NOT_READY;
+        }
+        else
+        {
+            result = PalToVkResult(palResult);
+        }
     }
 
     return result;
@@ -209,6 +219,8 @@ VkResult Fence::ImportFenceFd(
     m_flags.isOpened       = 1;
     m_flags.isPermanence   = isPermanence;
     m_flags.isReference    = openInfo.flags.isReference;
+    m_flags.mayBeSignaled  = 1;
+    m_knownSignaled        = false;
     Pal::IFence* pPalFence = PalFence(DefaultDeviceIndex);
 
     if (isPermanence)
@@ -261,6 +273,12 @@ VkResult Fence::GetFenceFd(
 #endif
     *pFd  = PalFence(DefaultDeviceIndex)->ExportExternalHandle(exportInfo);
 
+    // Exporting a sync fd resets the fence.
+    if (pGetFdInfo->handleType == VK_EXTERNAL_FENCE_HANDLE_TYPE_SYNC_FD_BIT)
+    {
+        m_knownSignaled = false;
+    }
+
     return VkResult::VK_SUCCESS;
 }
 #endif
@@ -279,6 +297,7 @@ VkResult Fence::RestoreFence(
         m_pPalTemporaryFences = nullptr;
         m_flags.isPermanence  = 1;
         m_flags.isOpened      = 0;
+        m_knownSignaled       = false;
 
         VkAllocationCallbacks* pAllocator = pDevice->VkInstance()->GetAllocCallbacks();
         pAllocator->pfnFree(pAllocator->pUserData, m_pPalTemporaryFences);
@@ -294,7 +313,14 @@ VKAPI_ATTR VkResult VKAPI_CALL vkGetFenceStatus(
     VkDevice                                    device,
     VkFence                                     fence)
 {
-    return Fence::ObjectFromHandle(fence)->GetStatus();
+    Fence* pFence = Fence::ObjectFromHandle(fence);
+
+    if (pFence->IsKnownSignaled() == false)
+    {
+        ApiDevice::ObjectFromHandle(device)->FlushQueueSubmitThreads(pFence->GetSubmitQueueMask());
+    }
+
+    return pFence->GetStatus();
 }
 
 VKAPI_ATTR void VKAPI_CALL vkDestroyFence(
@@ -327,8 +353,11 @@ VKAPI_ATTR VkResult VKAPI_CALL vkGetFenceFdKHR(
     int*                                        pFd)
 {
     Device*    pDevice  = ApiDevice::ObjectFromHandle(device);
+    Fence*     pFence   = Fence::ObjectFromHandle(pGetFdInfo->fence);
+
+    pDevice->FlushQueueSubmitThreads(pFence->GetSubmitQueueMask());
 
-    return Fence::ObjectFromHandle(pGetFdInfo->fence)->GetFenceFd(pDevice, pGetFdInfo, pFd);
+    return pFence->GetFenceFd(pDevice, pGetFdInfo, pFd);
 }
 #endif
 
@@ -1246,12 +1246,33 @@ VkResult GraphicsPipeline::Create(
 
     const VkPipelineCreationFeedbackCreateInfoEXT* pPipelineCreationFeadbackCreateInfo = nullptr;
 
-    VkResult result = pDefaultCompiler->ConvertGraphicsPipelineInfo(
-        pDevice, pCreateInfo, &binaryCreateInfo, &vbInfo, &pPipelineCreationFeadbackCreateInfo);
+    const uint32_t numPalDevices = pDevice->NumPalDevices();
+    VkResult       result        = VK_SUCCESS;
+
+    // A pipeline created before is looked up by its API hash, which skips converting the create info and hashing
+    // the LLPC build info just to compute its cache ID.
+    const bool isCacheIdHit = (numPalDevices == 1) &&
+                              pDefaultCompiler->LoadCachedGraphicsPipelineBinary(
+                                  pDevice,
+                                  DefaultDeviceIndex,
+                                  pPipelineCache,
+                                  pCreateInfo,
+                                  &binaryCreateInfo,
+                                  &vbInfo,
+                                  &pipelineBinarySizes[DefaultDeviceIndex],
+                                  &pPipelineBinaries[DefaultDeviceIndex],
+                                  &cacheId[DefaultDeviceIndex],
+                                  &pPipelineCreationFeadbackCreateInfo);
+
+    if (isCacheIdHit == false)
+    {
+        result = pDefaultCompiler->ConvertGraphicsPipelineInfo(
+            pDevice, pCreateInfo, &binaryCreateInfo, &vbInfo, &pPipelineCreationFeadbackCreateInfo);
+    }
+
     ConvertGraphicsPipelineInfo(pDevice, pCreateInfo, &vbInfo, &localPipelineInfo);
 
-    const uint32_t numPalDevices = pDevice->NumPalDevices();
-    for (uint32_t i = 0; (result == VK_SUCCESS) && (i < numPalDevices); ++i)
+    for (uint32_t i = 0; (result == VK_SUCCESS) && (isCacheIdHit == false) && (i < numPalDevices); ++i)
     {
         if (i == DefaultDeviceIndex)
         {
@@ -1293,6 +1314,17 @@ VkResult GraphicsPipeline::Create(
         }
     }
 
+    if ((result == VK_SUCCESS) && (isCacheIdHit == false) && (numPalDevices == 1))
+    {
+        pDefaultCompiler->RegisterGraphicsPipelineCacheId(
+            pDevice,
+            DefaultDeviceIndex,
+            pPipelineCache,
+            binaryCreateInfo,
+            vbInfo,
+            cacheId[DefaultDeviceIndex]);
+    }
+
     if (result == VK_SUCCESS)
     {
         pDevice->GetShaderOptimizer()->OverrideGraphicsPipelineCreateInfo(
@@ -43,6 +43,7 @@
 #include "include/vk_utils.h"
 #include "include/vk_conv.h"
 #include "include/vk_surface.h"
+#include "include/pipeline_binary_cache.h"
 
 #include "include/vert_buf_binding_mgr.h"
 #include "include/khronos/vk_icd.h"
@@ -526,6 +527,7 @@ void PhysicalDevice::InitializePlatformKey(
     struct
     {
         VkPhysicalDeviceProperties properties;
+        uint32_t                   cacheFormatVersion;
         char*                      timestamp[sizeof(__TIMESTAMP__)];
     } initialData;
 
@@ -533,6 +535,8 @@ void PhysicalDevice::InitializePlatformKey(
 
     VkResult result = GetDeviceProperties(&initialData.properties);
 
+    initialData.cacheFormatVersion = PipelineBinaryCacheFormatVersion;
+
     if (result == VK_SUCCESS)
     {
         size_t memSize = Util::GetPlatformKeySize(KeyAlgorithm);
@@ -863,6 +867,7 @@ VkResult PhysicalDevice::Initialize()
             hash.Update(palProps.deviceId);
             hash.Update(PalMajorVersion);
             hash.Update(PalMinorVersion);
+            hash.Update(PipelineBinaryCacheFormatVersion);
             hash.Update(systemInfo.cpuType);
             hash.Update(systemInfo.cpuVendorString[0]);
             hash.Update(systemInfo.cpuBrandString[0]);
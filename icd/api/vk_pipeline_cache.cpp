@@ -250,7 +250,7 @@ VkResult PipelineCache::GetData(
 #if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 534
     if (m_pBinaryCache != nullptr)
     {
-        result = m_pBinaryCache->Serialize(pData, pSize);
+        result = m_pBinaryCache->Serialize(pData, pSize, m_pDevice->GetCompileThreadPool());
     }
     else
 #endif
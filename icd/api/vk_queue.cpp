@@ -70,7 +70,19 @@ Queue::Queue(
     m_queueIndex(queueIndex),
     m_queueFlags(queueFlags),
     m_pDevModeMgr(pDevice->VkInstance()->GetDevModeMgr()),
-    m_pStackAllocator(pStackAllocator)
+    m_pStackAllocator(pStackAllocator),
+    m_pSubmitRing(nullptr),
+    m_submitRingCapacity(0),
+    m_submitRingHead(0),
+    m_submitRingTail(0),
+    m_submitThreadSleeping(false),
+    m_submitSpaceWaiting(false),
+    m_asyncSubmitResult(VK_SUCCESS),
+    m_stopSubmitThread(false),
+    m_submitThreadMask(0)
+#if ICD_CMDBUF_STATS
+    , m_cmdBufferStatsSubmits(0)
+#endif
 {
     memcpy(m_pPalQueues, pPalQueues, sizeof(pPalQueues[0]) * pDevice->NumPalDevices());
     memset(&m_palFrameMetadataControl, 0, sizeof(Pal::PerSourceFrameMetadataControl));
@@ -86,6 +98,8 @@ Queue::Queue(
 // =====================================================================================================================
 Queue::~Queue()
 {
+    DestroySubmitThread();
+
     for (uint32_t deviceIdx = 0; deviceIdx < m_pDevice->NumPalDevices(); ++deviceIdx)
     {
         if (m_pDummyCmdBuffer[deviceIdx] != nullptr)
@@ -108,6 +122,9 @@ Queue::~Queue()
         PalQueue(i)->Destroy();
     }
 
+#if ICD_CMDBUF_STATS
+    m_cmdBufferStatsFile.Close();
+#endif
 }
 
 // =====================================================================================================================
@@ -251,12 +268,79 @@ VkResult Queue::NotifyFlipMetadataAfterPresent(
     return result;
 }
 
+// =====================================================================================================================
+// Peek the device group and timeline semaphore structures chained to a VkSubmitInfo.  Either output may be null.
+static void PeekSubmitInfoExtensions(
+    const VkSubmitInfo&                      submitInfo,
+    const VkDeviceGroupSubmitInfo**          ppDeviceGroupInfo,
+    const VkTimelineSemaphoreSubmitInfoKHR** ppTimelineSemaphoreInfo)
+{
+    union
+    {
+        const VkStructHeader*                   pHeader;
+        const VkTimelineSemaphoreSubmitInfoKHR* pTimelineSemaphoreInfo;
+        const VkDeviceGroupSubmitInfo*          pDeviceGroupInfo;
+    };
+
+    for (pHeader  = static_cast<const VkStructHeader*>(submitInfo.pNext);
+         pHeader != nullptr;
+         pHeader  = pHeader->pNext)
+    {
+        switch (static_cast<uint32_t>(pHeader->sType))
+        {
+        case VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO:
+            if (ppDeviceGroupInfo != nullptr)
+            {
+                *ppDeviceGroupInfo = pDeviceGroupInfo;
+            }
+            break;
+        case VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR:
+            if (ppTimelineSemaphoreInfo != nullptr)
+            {
+                *ppTimelineSemaphoreInfo = pTimelineSemaphoreInfo;
+            }
+            break;
+        default:
+            // Skip any unknown extension structures
+            break;
+        }
+    }
+}
+
 // =====================================================================================================================
 // Submit an array of command buffers to a queue
 VkResult Queue::Submit(
     uint32_t            submitCount,
     const VkSubmitInfo* pSubmits,
     VkFence             fence)
+{
+    VkResult result = VK_SUCCESS;
+
+#if ICD_CMDBUF_STATS
+    if (m_pDevice->GetRuntimeSettings().cmdBufferStatsEnable)
+    {
+        LogCmdBufferStats(submitCount, pSubmits);
+    }
+#endif
+
+    if (m_pSubmitRing != nullptr)
+    {
+        result = QueueAsyncSubmit(submitCount, pSubmits, fence);
+    }
+    else
+    {
+        result = SubmitBatches(submitCount, pSubmits, fence);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Submit an array of command buffers to the PAL queues.  Runs on the submission thread if it is enabled.
+VkResult Queue::SubmitBatches(
+    uint32_t            submitCount,
+    const VkSubmitInfo* pSubmits,
+    VkFence             fence)
 {
 #if ICD_GPUOPEN_DEVMODE_BUILD
     DevModeMgr* pDevModeMgr = m_pDevice->VkInstance()->GetDevModeMgr();
@@ -300,37 +384,51 @@ VkResult Queue::Submit(
     }
     else
     {
-        for (uint32_t submitIdx = 0; (submitIdx < submitCount) && (result == VK_SUCCESS); ++submitIdx)
+        for (uint32_t submitIdx = 0; (submitIdx < submitCount) && (result == VK_SUCCESS); )
         {
             const VkSubmitInfo& submitInfo = pSubmits[submitIdx];
             const VkDeviceGroupSubmitInfo* pDeviceGroupInfo = nullptr;
             const VkTimelineSemaphoreSubmitInfoKHR* pTimelineSemaphoreInfo = nullptr;
+
+            PeekSubmitInfoExtensions(submitInfo, &pDeviceGroupInfo, &pTimelineSemaphoreInfo);
+
+            // Batches that are not separated by a semaphore signal or wait can go to PAL as a single submission: the
+            // first batch's waits come before all of them and the last batch's signals follow all of them, which is
+            // the same ordering the application asked for.  Device group batches carry per-batch device masks and
+            // timed submits are reported per batch, so those are never merged.
+            uint32_t batchCount     = 1;
+            uint32_t cmdBufferCount = submitInfo.commandBufferCount;
+
+            if ((pDeviceGroupInfo == nullptr) && (timedQueueEvents == false))
             {
-                union
+                while (((submitIdx + batchCount) < submitCount) &&
+                       (pSubmits[submitIdx + batchCount - 1].signalSemaphoreCount == 0) &&
+                       (pSubmits[submitIdx + batchCount].waitSemaphoreCount == 0))
                 {
-                    const VkStructHeader*                          pHeader;
-                    const VkSubmitInfo*                            pVkSubmitInfo;
-                    const VkTimelineSemaphoreSubmitInfoKHR*        pVkTimelineSemaphoreSubmitInfo;
-                    const VkDeviceGroupSubmitInfo*                 pVkDeviceGroupSubmitInfo;
-                };
+                    const VkDeviceGroupSubmitInfo* pNextDeviceGroupInfo = nullptr;
 
-                for (pVkSubmitInfo = &submitInfo; pHeader != nullptr; pHeader = pHeader->pNext)
-                {
-                    switch (static_cast<int32_t>(pHeader->sType))
+                    PeekSubmitInfoExtensions(pSubmits[submitIdx + batchCount], &pNextDeviceGroupInfo, nullptr);
+
+                    if (pNextDeviceGroupInfo != nullptr)
                     {
-                    case VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO:
-                        pDeviceGroupInfo = pVkDeviceGroupSubmitInfo;
-                        break;
-                    case VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR:
-                        pTimelineSemaphoreInfo = pVkTimelineSemaphoreSubmitInfo;
-                        break;
-                    default:
-                        // Skip any unknown extension structures
                         break;
                     }
+
+                    cmdBufferCount += pSubmits[submitIdx + batchCount].commandBufferCount;
+                    batchCount++;
                 }
             }
 
+            const VkSubmitInfo& lastSubmitInfo = pSubmits[submitIdx + batchCount - 1];
+            const VkTimelineSemaphoreSubmitInfoKHR* pLastTimelineSemaphoreInfo = pTimelineSemaphoreInfo;
+
+            if (batchCount > 1)
+            {
+                pLastTimelineSemaphoreInfo = nullptr;
+
+                PeekSubmitInfoExtensions(lastSubmitInfo, nullptr, &pLastTimelineSemaphoreInfo);
+            }
+
             if ((result == VK_SUCCESS) && (submitInfo.waitSemaphoreCount > 0))
             {
                 VK_ASSERT((pTimelineSemaphoreInfo == nullptr) ||
@@ -344,15 +442,12 @@ VkResult Queue::Submit(
             }
 
             // Allocate space to store the PAL command buffer handles
-            const VkCommandBuffer* pCmdBuffers = submitInfo.pCommandBuffers;
-            const uint32_t cmdBufferCount      = submitInfo.commandBufferCount;
-
             Pal::ICmdBuffer** pPalCmdBuffers = (cmdBufferCount > 0) ?
-                            virtStackFrame.AllocArray<Pal::ICmdBuffer*>(submitInfo.commandBufferCount) : nullptr;
+                            virtStackFrame.AllocArray<Pal::ICmdBuffer*>(cmdBufferCount) : nullptr;
 
             result = ((pPalCmdBuffers != nullptr) || (cmdBufferCount == 0)) ? result : VK_ERROR_OUT_OF_HOST_MEMORY;
 
-            bool lastBatch = (submitIdx == submitCount - 1);
+            bool lastBatch = ((submitIdx + batchCount) == submitCount);
 
             Pal::IFence*    pPalFence     = nullptr;
 
@@ -371,27 +466,30 @@ VkResult Queue::Submit(
 
             for (uint32_t deviceIdx = 0; (deviceIdx < deviceCount) && (result == VK_SUCCESS); deviceIdx++)
             {
-                // Get the PAL command buffer object from each Vulkan object and put it
-                // in the local array before submitting to PAL.
-                DispatchableCmdBuffer* const * pCommandBuffers =
-                    reinterpret_cast<DispatchableCmdBuffer*const*>(submitInfo.pCommandBuffers);
-
                 perSubQueueInfo.cmdBufferCount = 0;
 
                 const uint32_t deviceMask = 1 << deviceIdx;
 
-                for (uint32_t i = 0; i < cmdBufferCount; ++i)
+                for (uint32_t batchIdx = submitIdx; batchIdx < (submitIdx + batchCount); ++batchIdx)
                 {
-                    if ((deviceCount > 1) &&
-                        (pDeviceGroupInfo->pCommandBufferDeviceMasks != nullptr) &&
-                        (pDeviceGroupInfo->pCommandBufferDeviceMasks[i] & deviceMask) == 0)
+                    // Get the PAL command buffer object from each Vulkan object and put it
+                    // in the local array before submitting to PAL.
+                    DispatchableCmdBuffer* const * pCommandBuffers =
+                        reinterpret_cast<DispatchableCmdBuffer*const*>(pSubmits[batchIdx].pCommandBuffers);
+
+                    for (uint32_t i = 0; i < pSubmits[batchIdx].commandBufferCount; ++i)
                     {
-                        continue;
-                    }
+                        if ((deviceCount > 1) &&
+                            (pDeviceGroupInfo->pCommandBufferDeviceMasks != nullptr) &&
+                            (pDeviceGroupInfo->pCommandBufferDeviceMasks[i] & deviceMask) == 0)
+                        {
+                            continue;
+                        }
 
-                    const CmdBuffer& cmdBuf = *(*pCommandBuffers[i]);
+                        const CmdBuffer& cmdBuf = *(*pCommandBuffers[i]);
 
-                    pPalCmdBuffers[perSubQueueInfo.cmdBufferCount++] = cmdBuf.PalCmdBuffer(deviceIdx);
+                        pPalCmdBuffers[perSubQueueInfo.cmdBufferCount++] = cmdBuf.PalCmdBuffer(deviceIdx);
+                    }
                 }
 
                 if (lastBatch && (pFence != nullptr))
@@ -433,29 +531,105 @@ VkResult Queue::Submit(
 
             virtStackFrame.FreeArray(pPalCmdBuffers);
 
-            if ((result == VK_SUCCESS) && (submitInfo.signalSemaphoreCount > 0))
+            if ((result == VK_SUCCESS) && (lastSubmitInfo.signalSemaphoreCount > 0))
             {
-                VK_ASSERT((pTimelineSemaphoreInfo == nullptr) ||
-                          (submitInfo.signalSemaphoreCount == pTimelineSemaphoreInfo->signalSemaphoreValueCount));
+                VK_ASSERT((pLastTimelineSemaphoreInfo == nullptr) ||
+                          (lastSubmitInfo.signalSemaphoreCount ==
+                           pLastTimelineSemaphoreInfo->signalSemaphoreValueCount));
                 result = PalSignalSemaphores(
-                    submitInfo.signalSemaphoreCount,
-                    submitInfo.pSignalSemaphores,
-                    ((pTimelineSemaphoreInfo != nullptr) ? pTimelineSemaphoreInfo->pSignalSemaphoreValues : nullptr),
+                    lastSubmitInfo.signalSemaphoreCount,
+                    lastSubmitInfo.pSignalSemaphores,
+                    ((pLastTimelineSemaphoreInfo != nullptr) ? pLastTimelineSemaphoreInfo->pSignalSemaphoreValues
+                                                             : nullptr),
                     (pDeviceGroupInfo != nullptr ? pDeviceGroupInfo->signalSemaphoreCount          : 0),
                     (pDeviceGroupInfo != nullptr ? pDeviceGroupInfo->pSignalSemaphoreDeviceIndices : nullptr));
             }
 
+            submitIdx += batchCount;
         }
     }
     return result;
 }
 
+#if ICD_CMDBUF_STATS
+// =====================================================================================================================
+// Sums the PAL command counters of all command buffers in a vkQueueSubmit call and appends them as one CSV row to this
+// queue's statistics file.
+void Queue::LogCmdBufferStats(
+    uint32_t            submitCount,
+    const VkSubmitInfo* pSubmits)
+{
+    if (m_cmdBufferStatsFile.IsOpen() == false)
+    {
+        char fileName[512];
+
+        Util::Snprintf(fileName, sizeof(fileName), "%s/CmdBufferStats_Family%u_Queue%u.csv",
+                       m_pDevice->GetRuntimeSettings().cmdBufferStatsDirectory,
+                       m_queueFamilyIndex,
+                       m_queueIndex);
+
+        if (m_cmdBufferStatsFile.Open(fileName, Util::FileAccessWrite) == Pal::Result::Success)
+        {
+            m_cmdBufferStatsFile.Printf("Submit,CmdBuffers");
+
+            for (uint32_t stat = 0; stat < CmdBufferStatCount; ++stat)
+            {
+                m_cmdBufferStatsFile.Printf(",%s", CmdBufferStatNames[stat]);
+            }
+
+            m_cmdBufferStatsFile.Printf("\n");
+        }
+    }
+
+    if (m_cmdBufferStatsFile.IsOpen())
+    {
+        CmdBufferStats totals         = {};
+        uint32_t       cmdBufferCount = 0;
+
+        for (uint32_t submitIdx = 0; submitIdx < submitCount; ++submitIdx)
+        {
+            const VkSubmitInfo& submitInfo = pSubmits[submitIdx];
+
+            for (uint32_t i = 0; i < submitInfo.commandBufferCount; ++i)
+            {
+                const CmdBuffer*      pCmdBuf = ApiCmdBuffer::ObjectFromHandle(submitInfo.pCommandBuffers[i]);
+                const CmdBufferStats& stats   = pCmdBuf->GetStats();
+
+                for (uint32_t stat = 0; stat < CmdBufferStatCount; ++stat)
+                {
+                    totals.counters[stat] += stats.counters[stat];
+                }
+
+                // The elided vkCmdSet* calls are always counted by the command buffer, so they are not tracked twice.
+                totals.counters[CmdBufferStatElidedDynamicState] += pCmdBuf->GetElidedDynamicStateCount();
+
+                cmdBufferCount++;
+            }
+        }
+
+        m_cmdBufferStatsFile.Printf("%llu,%u", m_cmdBufferStatsSubmits, cmdBufferCount);
+
+        for (uint32_t stat = 0; stat < CmdBufferStatCount; ++stat)
+        {
+            m_cmdBufferStatsFile.Printf(",%llu", totals.counters[stat]);
+        }
+
+        m_cmdBufferStatsFile.Printf("\n");
+        m_cmdBufferStatsFile.Flush();
+    }
+
+    m_cmdBufferStatsSubmits++;
+}
+#endif
+
 // =====================================================================================================================
 // Wait for a queue to go idle
 VkResult Queue::WaitIdle(void)
 {
     Pal::Result palResult = Pal::Result::Success;
 
+    FlushSubmitThread();
+
     for (uint32_t deviceIdx = 0;
         (deviceIdx < m_pDevice->NumPalDevices()) && (palResult == Pal::Result::Success);
         deviceIdx++)
@@ -463,7 +637,412 @@ VkResult Queue::WaitIdle(void)
         palResult = PalQueue(deviceIdx)->WaitIdle();
     }
 
-    return PalToVkResult(palResult);
+    VkResult result = PalToVkResult(palResult);
+
+    return (result == VK_SUCCESS) ? m_asyncSubmitResult : result;
+}
+
+// =====================================================================================================================
+// Copies count elements of pSrc into the block at the 8-byte aligned offset *pOffset and advances it.  If pBase is
+// null, only the offset is advanced so the same code can measure the block first.
+template <typename T>
+static T* CopySubmitArray(
+    void*    pBase,
+    size_t*  pOffset,
+    const T* pSrc,
+    uint32_t count)
+{
+    T* pDst = nullptr;
+
+    if ((count > 0) && (pSrc != nullptr))
+    {
+        *pOffset = Util::Pow2Align(*pOffset, sizeof(uint64_t));
+
+        if (pBase != nullptr)
+        {
+            pDst = static_cast<T*>(Util::VoidPtrInc(pBase, *pOffset));
+
+            memcpy(pDst, pSrc, count * sizeof(T));
+        }
+
+        *pOffset += count * sizeof(T);
+    }
+
+    return pDst;
+}
+
+// =====================================================================================================================
+// Deep copies an array of submit infos, including the extension structures Queue::SubmitBatches reads, into pMemory.
+// Returns the number of bytes needed; pass a null pMemory to only measure.
+static size_t CopySubmitInfos(
+    uint32_t            submitCount,
+    const VkSubmitInfo* pSubmits,
+    void*               pMemory)
+{
+    size_t offset = 0;
+
+    VkSubmitInfo* pDstSubmits = CopySubmitArray(pMemory, &offset, pSubmits, submitCount);
+
+    for (uint32_t submitIdx = 0; submitIdx < submitCount; ++submitIdx)
+    {
+        const VkSubmitInfo&                     src                    = pSubmits[submitIdx];
+        const VkDeviceGroupSubmitInfo*          pDeviceGroupInfo       = nullptr;
+        const VkTimelineSemaphoreSubmitInfoKHR* pTimelineSemaphoreInfo = nullptr;
+
+        PeekSubmitInfoExtensions(src, &pDeviceGroupInfo, &pTimelineSemaphoreInfo);
+
+        const VkSemaphore* pWaitSemaphores =
+            CopySubmitArray(pMemory, &offset, src.pWaitSemaphores, src.waitSemaphoreCount);
+        const VkPipelineStageFlags* pWaitDstStageMask =
+            CopySubmitArray(pMemory, &offset, src.pWaitDstStageMask, src.waitSemaphoreCount);
+        const VkCommandBuffer* pCommandBuffers =
+            CopySubmitArray(pMemory, &offset, src.pCommandBuffers, src.commandBufferCount);
+        const VkSemaphore* pSignalSemaphores =
+            CopySubmitArray(pMemory, &offset, src.pSignalSemaphores, src.signalSemaphoreCount);
+
+        VkTimelineSemaphoreSubmitInfoKHR* pDstTimelineInfo = nullptr;
+        VkDeviceGroupSubmitInfo*          pDstDeviceGroupInfo = nullptr;
+
+        if (pTimelineSemaphoreInfo != nullptr)
+        {
+            pDstTimelineInfo = CopySubmitArray(pMemory, &offset, pTimelineSemaphoreInfo, 1);
+
+            const uint64_t* pWaitValues = CopySubmitArray(pMemory,
+                                                          &offset,
+                                                          pTimelineSemaphoreInfo->pWaitSemaphoreValues,
+                                                          pTimelineSemaphoreInfo->waitSemaphoreValueCount);
+            const uint64_t* pSignalValues = CopySubmitArray(pMemory,
+                                                            &offset,
+                                                            pTimelineSemaphoreInfo->pSignalSemaphoreValues,
+                                                            pTimelineSemaphoreInfo->signalSemaphoreValueCount);
+
+            if (pMemory != nullptr)
+            {
+                pDstTimelineInfo->pNext                  = nullptr;
+                pDstTimelineInfo->pWaitSemaphoreValues   = pWaitValues;
+                pDstTimelineInfo->pSignalSemaphoreValues = pSignalValues;
+            }
+        }
+
+        if (pDeviceGroupInfo != nullptr)
+        {
+            pDstDeviceGroupInfo = CopySubmitArray(pMemory, &offset, pDeviceGroupInfo, 1);
+
+            const uint32_t* pWaitIndices = CopySubmitArray(pMemory,
+                                                           &offset,
+                                                           pDeviceGroupInfo->pWaitSemaphoreDeviceIndices,
+                                                           pDeviceGroupInfo->waitSemaphoreCount);
+            const uint32_t* pDeviceMasks = CopySubmitArray(pMemory,
+                                                           &offset,
+                                                           pDeviceGroupInfo->pCommandBufferDeviceMasks,
+                                                           pDeviceGroupInfo->commandBufferCount);
+            const uint32_t* pSignalIndices = CopySubmitArray(pMemory,
+                                                             &offset,
+                                                             pDeviceGroupInfo->pSignalSemaphoreDeviceIndices,
+                                                             pDeviceGroupInfo->signalSemaphoreCount);
+
+            if (pMemory != nullptr)
+            {
+                pDstDeviceGroupInfo->pNext                         = pDstTimelineInfo;
+                pDstDeviceGroupInfo->pWaitSemaphoreDeviceIndices   = pWaitIndices;
+                pDstDeviceGroupInfo->pCommandBufferDeviceMasks     = pDeviceMasks;
+                pDstDeviceGroupInfo->pSignalSemaphoreDeviceIndices = pSignalIndices;
+            }
+        }
+
+        if (pMemory != nullptr)
+        {
+            VkSubmitInfo* pDst = &pDstSubmits[submitIdx];
+
+            pDst->pNext             = (pDstDeviceGroupInfo != nullptr) ?
+                                      static_cast<const void*>(pDstDeviceGroupInfo) : pDstTimelineInfo;
+            pDst->pWaitSemaphores   = pWaitSemaphores;
+            pDst->pWaitDstStageMask = pWaitDstStageMask;
+            pDst->pCommandBuffers   = pCommandBuffers;
+            pDst->pSignalSemaphores = pSignalSemaphores;
+        }
+    }
+
+    return offset;
+}
+
+// =====================================================================================================================
+// Copy a vkQueueSubmit call into the submission ring and return without waiting for it to be submitted to PAL.
+// Failures on the submission thread are returned by later vkQueueSubmit and vkQueueWaitIdle calls.
+VkResult Queue::QueueAsyncSubmit(
+    uint32_t            submitCount,
+    const VkSubmitInfo* pSubmits,
+    VkFence             fence)
+{
+    VkResult result = m_asyncSubmitResult;
+
+    if (result == VK_SUCCESS)
+    {
+        // The semaphores may be signaled by work still queued on another queue's submission thread, and PAL expects
+        // the signal to reach the kernel before the wait.  Waits on this queue's own signals are already in order.
+        for (uint32_t submitIdx = 0; submitIdx < submitCount; ++submitIdx)
+        {
+            FlushSemaphoreSubmitThreads(pSubmits[submitIdx].waitSemaphoreCount,
+                                        pSubmits[submitIdx].pWaitSemaphores,
+                                        false);
+        }
+
+        PendingSubmit entry = {};
+        entry.submitCount   = submitCount;
+        entry.fence         = fence;
+
+        const size_t copySize = CopySubmitInfos(submitCount, pSubmits, nullptr);
+
+        if (copySize > 0)
+        {
+            entry.pSubmits = static_cast<VkSubmitInfo*>(m_pDevice->VkInstance()->AllocMem(
+                copySize,
+                VK_DEFAULT_MEM_ALIGN,
+                VK_SYSTEM_ALLOCATION_SCOPE_COMMAND));
+
+            if (entry.pSubmits != nullptr)
+            {
+                CopySubmitInfos(submitCount, pSubmits, entry.pSubmits);
+            }
+            else
+            {
+                result = VK_ERROR_OUT_OF_HOST_MEMORY;
+            }
+        }
+
+        if (result == VK_SUCCESS)
+        {
+            // Host waits on the fence and semaphores flush only the queues that may signal them
+            for (uint32_t submitIdx = 0; submitIdx < submitCount; ++submitIdx)
+            {
+                for (uint32_t i = 0; i < pSubmits[submitIdx].signalSemaphoreCount; ++i)
+                {
+                    Semaphore::ObjectFromHandle(pSubmits[submitIdx].pSignalSemaphores[i])->AddSubmitQueueMask(
+                        m_submitThreadMask);
+                }
+            }
+
+            if (fence != VK_NULL_HANDLE)
+            {
+                Fence::ObjectFromHandle(fence)->SetSubmitQueueMask(m_submitThreadMask);
+            }
+
+            // This is the only producer, so only it writes the tail.
+            const uint64_t tail = m_submitRingTail.load(std::memory_order_relaxed);
+
+            // The ring can only go from full to not full while the producer waits.  The flag is raised before the
+            // head is checked again, and the submission thread checks it after advancing the head, so one of the two
+            // sees the other.  Stale signals of the auto-reset event only cost another check.
+            while ((tail - m_submitRingHead.load(std::memory_order_acquire)) == m_submitRingCapacity)
+            {
+                m_submitSpaceWaiting.store(true);
+
+                if ((tail - m_submitRingHead.load()) == m_submitRingCapacity)
+                {
+                    m_submitSpaceEvent.Wait(Util::InfiniteTimeout);
+                }
+            }
+
+            m_pSubmitRing[tail % m_submitRingCapacity] = entry;
+
+            // Publishes the entry to the submission thread
+            m_submitRingTail.store(tail + 1);
+
+            // The submission thread raises its flag before checking the tail again, so it can't go to sleep without
+            // seeing either the new tail or the wake-up.
+            if (m_submitThreadSleeping.exchange(false))
+            {
+                m_submitIdleEvent.Reset();
+                m_submitEvent.Set();
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Block until the submission thread has passed every queued vkQueueSubmit call to PAL.  Must be called before anything
+// else touches the PAL queues or waits on objects a queued submit signals.
+void Queue::FlushSubmitThread()
+{
+    if (m_pSubmitRing != nullptr)
+    {
+        // Entries are submitted in order, so reaching the tail sampled here covers everything queued before this call.
+        // The idle event is only set by the submission thread when it is about to sleep on an empty ring.
+        const uint64_t target = m_submitRingTail.load(std::memory_order_acquire);
+
+        while (m_submitRingHead.load(std::memory_order_acquire) < target)
+        {
+            m_submitIdleEvent.Wait(Util::InfiniteTimeout);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Flush the submission threads of the queues that may signal any of the given semaphores.  This queue's own thread is
+// only flushed if flushSelf is set, for work that bypasses the ring.
+void Queue::FlushSemaphoreSubmitThreads(
+    uint32_t           semaphoreCount,
+    const VkSemaphore* pSemaphores,
+    bool               flushSelf)
+{
+    uint32_t queueMask = 0;
+
+    for (uint32_t i = 0; i < semaphoreCount; ++i)
+    {
+        queueMask |= Semaphore::ObjectFromHandle(pSemaphores[i])->GetSubmitQueueMask();
+    }
+
+    queueMask = flushSelf ? (queueMask | m_submitThreadMask) : (queueMask & ~m_submitThreadMask);
+
+    if (queueMask != 0)
+    {
+        m_pDevice->FlushQueueSubmitThreads(queueMask);
+    }
+}
+
+// =====================================================================================================================
+// Start the submission thread.  Called once after the queue is created, only if the feature is enabled.
+VkResult Queue::InitSubmitThread(
+    uint32_t ringSize,
+    uint32_t submitThreadIdx)
+{
+    VK_ASSERT((m_pSubmitRing == nullptr) && (ringSize > 0) && (submitThreadIdx < MaxSubmitThreads));
+
+    Util::EventCreateFlags flags = {};
+    flags.manualReset       = false;
+    flags.initiallySignaled = false;
+
+    VkResult result = PalToVkResult(m_submitEvent.Init(flags));
+
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(m_submitSpaceEvent.Init(flags));
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        flags.manualReset = true;
+
+        result = PalToVkResult(m_submitIdleEvent.Init(flags));
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        m_pSubmitRing = static_cast<PendingSubmit*>(m_pDevice->VkInstance()->AllocMem(
+            ringSize * sizeof(PendingSubmit),
+            VK_SYSTEM_ALLOCATION_SCOPE_DEVICE));
+
+        if (m_pSubmitRing != nullptr)
+        {
+            m_submitRingCapacity = ringSize;
+        }
+        else
+        {
+            result = VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        result = PalToVkResult(m_submitThread.Begin(SubmitThreadFunc, this));
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        m_submitThreadMask = (1u << submitThreadIdx);
+    }
+    else
+    {
+        DestroySubmitThread();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Stop the submission thread after it has submitted everything queued
+void Queue::DestroySubmitThread()
+{
+    if (m_submitThread.IsCreated())
+    {
+        FlushSubmitThread();
+
+        m_stopSubmitThread = true;
+        m_submitEvent.Set();
+        m_submitThread.Join();
+    }
+
+    if (m_pSubmitRing != nullptr)
+    {
+        VK_ASSERT(m_submitRingHead.load() == m_submitRingTail.load());
+
+        m_pDevice->VkInstance()->FreeMem(m_pSubmitRing);
+
+        m_pSubmitRing        = nullptr;
+        m_submitRingCapacity = 0;
+        m_submitThreadMask   = 0;
+    }
+}
+
+// =====================================================================================================================
+void Queue::SubmitThreadFunc(
+    void* pParam)
+{
+    static_cast<Queue*>(pParam)->SubmitThreadLoop();
+}
+
+// =====================================================================================================================
+// Submission thread main loop.  Entries are submitted in the order they were queued, and the head only moves past an
+// entry once its PAL submits and semaphore operations have been issued so that FlushSubmitThread() covers it.
+void Queue::SubmitThreadLoop()
+{
+    // This is the only consumer, so only it writes the head.
+    uint64_t head = m_submitRingHead.load(std::memory_order_relaxed);
+
+    // The ring is flushed before the stop flag is set, so the thread only stops on an empty ring
+    while (m_stopSubmitThread == false)
+    {
+        if (head == m_submitRingTail.load(std::memory_order_acquire))
+        {
+            // Raise the flag before checking the tail again; the producer checks it after publishing a new tail.
+            m_submitThreadSleeping.store(true);
+
+            if ((head == m_submitRingTail.load()) && (m_stopSubmitThread == false))
+            {
+                m_submitIdleEvent.Set();
+                m_submitEvent.Wait(Util::InfiniteTimeout);
+                m_submitIdleEvent.Reset();
+            }
+
+            m_submitThreadSleeping.store(false);
+        }
+        else
+        {
+            const PendingSubmit& entry = m_pSubmitRing[head % m_submitRingCapacity];
+
+            const VkResult result = SubmitBatches(entry.submitCount, entry.pSubmits, entry.fence);
+
+            if ((result != VK_SUCCESS) && (m_asyncSubmitResult == VK_SUCCESS))
+            {
+                m_asyncSubmitResult = result;
+            }
+
+            if (entry.pSubmits != nullptr)
+            {
+                m_pDevice->VkInstance()->FreeMem(entry.pSubmits);
+            }
+
+            // Frees the entry for the producer and completes it for flushes
+            m_submitRingHead.store(++head);
+
+            if (m_submitSpaceWaiting.exchange(false))
+            {
+                m_submitSpaceEvent.Set();
+            }
+        }
+    }
 }
 
 // =====================================================================================================================
@@ -669,6 +1248,9 @@ VkResult Queue::Present(
 
     const VkPresentInfoKHR* pVkInfo = nullptr;
 
+    // The present uses this queue from the calling thread and may wait on semaphores signaled by other queues.
+    FlushSemaphoreSubmitThreads(pPresentInfo->waitSemaphoreCount, pPresentInfo->pWaitSemaphores, true);
+
     {
         union
         {
@@ -1185,6 +1767,14 @@ VkResult Queue::BindSparse(
 {
     VkResult result = VK_SUCCESS;
 
+    // Sparse binds are made on the calling thread and may wait on semaphores signaled by other queues.
+    FlushSubmitThread();
+
+    for (uint32_t bindIdx = 0; bindIdx < bindInfoCount; ++bindIdx)
+    {
+        FlushSemaphoreSubmitThreads(pBindInfo[bindIdx].waitSemaphoreCount, pBindInfo[bindIdx].pWaitSemaphores, false);
+    }
+
     VirtualStackFrame virtStackFrame(m_pStackAllocator);
 
     // Initialize state to track batches of sparse bind calls
@@ -1569,6 +2159,8 @@ VkResult Queue::SubmitInternalCmdBuf(
     const Pal::CmdBufInfo&  cmdBufInfo,
     CmdBufState*            pCmdBufState)
 {
+    FlushSubmitThread();
+
     Pal::Result result = pCmdBufState->pCmdBuf->End();
 
     if (result == Pal::Result::Success)
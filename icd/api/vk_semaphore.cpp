@@ -383,6 +383,9 @@ void Semaphore::SetSemaphore(
     }
 
     m_sharedSemaphoreHandle = importedHandle;
+
+    // Nothing is known about the value of the imported payload.
+    m_completedValue.store(0, std::memory_order_release);
 }
 
 // =====================================================================================================================
@@ -432,6 +435,11 @@ VkResult Semaphore::GetSemaphoreCounterValue(
     {
         pPalSemaphore = pSemaphore->PalSemaphore(DefaultDeviceIndex);
         palResult = pPalSemaphore->QuerySemaphoreValue(pValue);
+
+        if (palResult == Pal::Result::Success)
+        {
+            pSemaphore->UpdateCompletedValue(pPalSemaphore, *pValue);
+        }
     }
 
     return PalToVkResult(palResult);
@@ -451,8 +459,20 @@ VkResult Semaphore::WaitSemaphoreValue(
     {
         VK_ASSERT(pSemaphore->IsTimelineSemaphore());
         pPalSemaphore = pSemaphore->PalSemaphore(DefaultDeviceIndex);
+
+        const bool reached = pSemaphore->IsValueReached(value);
+
         pSemaphore->RestoreSemaphore();
-        palResult = pPalSemaphore->WaitSemaphoreValue(value, timeout);
+
+        if (reached == false)
+        {
+            palResult = pPalSemaphore->WaitSemaphoreValue(value, timeout);
+
+            if (palResult == Pal::Result::Success)
+            {
+                pSemaphore->UpdateCompletedValue(pPalSemaphore, value);
+            }
+        }
     }
 
     return PalToVkResult(palResult);
@@ -471,11 +491,72 @@ VkResult Semaphore::SignalSemaphoreValue(
     {
         pPalSemaphore = pSemaphore->PalSemaphore(DefaultDeviceIndex);
         palResult = pPalSemaphore->SignalSemaphoreValue(value);
+
+        if (palResult == Pal::Result::Success)
+        {
+            pSemaphore->UpdateCompletedValue(pPalSemaphore, value);
+        }
     }
 
     return PalToVkResult(palResult);
 }
 
+// =====================================================================================================================
+// Returns true if this timeline semaphore is known to have reached the given value without asking the kernel.
+bool Semaphore::IsValueReached(
+    uint64_t value) const
+{
+    bool reached = false;
+
+    if (m_useTempSemaphore == false)
+    {
+        // Pairs with the release in UpdateCompletedValue(), so a skipped wait still orders after the wait that
+        // observed the value.
+        reached = (value <= m_completedValue.load(std::memory_order_acquire));
+    }
+
+    return reached;
+}
+
+// =====================================================================================================================
+// Records that the given PAL semaphore of this timeline semaphore has reached at least the given value.  Observations
+// of temporarily imported payloads are not recorded because they don't describe the permanent payload.
+void Semaphore::UpdateCompletedValue(
+    const Pal::IQueueSemaphore* pPalSemaphore,
+    uint64_t                    value)
+{
+    if (pPalSemaphore == m_pPalSemaphores[DefaultDeviceIndex])
+    {
+        uint64_t completedValue = m_completedValue.load(std::memory_order_relaxed);
+
+        // On failure compare_exchange_weak reloads completedValue, so the loop ends once the stored value is at least
+        // the new one.
+        while ((completedValue < value) &&
+               (m_completedValue.compare_exchange_weak(completedValue,
+                                                       value,
+                                                       std::memory_order_release,
+                                                       std::memory_order_relaxed) == false))
+        {
+        }
+    }
+}
+
+// =====================================================================================================================
+// Records that a submission queued on the given queue submission threads may signal this semaphore.  Queues on
+// different threads may signal the same semaphore concurrently.
+void Semaphore::AddSubmitQueueMask(
+    uint32_t submitQueueMask)
+{
+    uint32_t oldMask = m_submitQueueMask;
+
+    while ((oldMask | submitQueueMask) != oldMask)
+    {
+        const uint32_t prevMask = Util::AtomicCompareAndSwap(&m_submitQueueMask, oldMask, oldMask | submitQueueMask);
+
+        oldMask = (prevMask == oldMask) ? (oldMask | submitQueueMask) : prevMask;
+    }
+}
+
 namespace entry
 {
 VKAPI_ATTR void VKAPI_CALL vkDestroySemaphore(
@@ -498,7 +579,11 @@ VKAPI_ATTR VkResult VKAPI_CALL vkGetSemaphoreFdKHR(
     const VkSemaphoreGetFdInfoKHR*              pGetFdInfo,
     int*                                        pFd)
 {
-    return Semaphore::ObjectFromHandle(pGetFdInfo->semaphore)->GetShareHandle(
+    Semaphore* pSemaphore = Semaphore::ObjectFromHandle(pGetFdInfo->semaphore);
+
+    ApiDevice::ObjectFromHandle(device)->FlushQueueSubmitThreads(pSemaphore->GetSubmitQueueMask());
+
+    return pSemaphore->GetShareHandle(
         ApiDevice::ObjectFromHandle(device),
         pGetFdInfo->handleType,
         reinterpret_cast<Pal::OsExternalHandle*>(pFd));
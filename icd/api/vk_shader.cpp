@@ -132,63 +132,240 @@ void* ShaderModule::GetFirstValidShaderData() const
 
 // =====================================================================================================================
 ShaderModule::ShaderModule(
-    size_t      codeSize,
-    const void* pCode)
+    const SharedShaderModule* pSharedModule)
+    :
+    m_codeSize(pSharedModule->codeSize),
+    m_pCode(pSharedModule->pCode),
+    m_handle(pSharedModule->handle),
+    m_codeHash(pSharedModule->codeHash),
+    m_pSharedModule(const_cast<SharedShaderModule*>(pSharedModule))
 {
-    m_codeSize = codeSize;
-    m_pCode    = pCode;
-
-    // Calculate a 128-bit hash from the SPIRV code.  This is used by profile-guided compilation
-    // parameter tuning.
-    Util::MetroHash::Hash codeHash = {};
-    Util::MetroHash128::Hash(static_cast<const uint8_t*>(pCode), codeSize, codeHash.bytes);
+}
 
-    MetroHashTo128Bit(codeHash, &m_codeHash.lower, &m_codeHash.upper);
-    memset(&m_handle, 0, sizeof(m_handle));
+// =====================================================================================================================
+// Returns the key of the device's shared shader module map for the given code hash and create flags.
+uint64_t ShaderModule::GetSharedModuleKey(
+    const Pal::ShaderHash&    codeHash,
+    VkShaderModuleCreateFlags flags)
+{
+    return codeHash.lower ^ codeHash.upper ^ static_cast<uint64_t>(flags);
 }
 
 // =====================================================================================================================
-VkResult ShaderModule::Create(
+// Returns a shared shader module holding the given SPIR-V code and its built shader module, taking a reference to it.
+// A module built earlier from identical code and create flags is reused; otherwise the code is copied and built here,
+// and the result is published so that later modules with the same code can share it.
+//
+// Shared modules are allocated from the instance allocator because they may outlive the shader module (and the
+// allocation callbacks) that created them.
+VkResult ShaderModule::AcquireSharedModule(
     const Device*                   pDevice,
     const VkShaderModuleCreateInfo* pCreateInfo,
-    const VkAllocationCallbacks*    pAllocator,
-    VkShaderModule*                 pShaderModule)
+    SharedShaderModule**            ppSharedModule)
 {
-    const size_t objSize = sizeof(ShaderModule) + pCreateInfo->codeSize;
+    // Calculate a 128-bit hash from the SPIRV code.  This is used to find identical modules, and by profile-guided
+    // compilation parameter tuning.
+    Util::MetroHash::Hash metroHash = {};
+    Util::MetroHash128::Hash(static_cast<const uint8_t*>(static_cast<const void*>(pCreateInfo->pCode)),
+                             pCreateInfo->codeSize,
+                             metroHash.bytes);
+
+    Pal::ShaderHash codeHash = {};
+    MetroHashTo128Bit(metroHash, &codeHash.lower, &codeHash.upper);
+
+    const uint64_t key = GetSharedModuleKey(codeHash, pCreateInfo->flags);
+
+    Device::SharedShaderModuleMap* pSharedModules = pDevice->GetSharedShaderModules();
+
+    auto IsSameModule = [&](const SharedShaderModule* pModule) -> bool
+    {
+        return (pModule->codeHash.lower == codeHash.lower) &&
+               (pModule->codeHash.upper == codeHash.upper) &&
+               (pModule->flags == pCreateInfo->flags)      &&
+               (pModule->codeSize == pCreateInfo->codeSize) &&
+               (memcmp(pModule->pCode, pCreateInfo->pCode, pCreateInfo->codeSize) == 0);
+    };
+
+    SharedShaderModule* pSharedModule = nullptr;
+
+    {
+        Util::MutexAuto lock(pDevice->GetSharedShaderModuleLock());
+
+        SharedShaderModule** ppExisting = pSharedModules->FindKey(key);
 
-    void* pMemory = pDevice->AllocApiObject(objSize, pAllocator);
+        if ((ppExisting != nullptr) && IsSameModule(*ppExisting))
+        {
+            pSharedModule = *ppExisting;
+            pSharedModule->refCount++;
+        }
+    }
 
-    if (pMemory == nullptr)
+    VkResult result = VK_SUCCESS;
+
+    if (pSharedModule == nullptr)
     {
-        return VK_ERROR_OUT_OF_HOST_MEMORY;
+        void* pMemory = pDevice->VkInstance()->AllocMem(
+            sizeof(SharedShaderModule) + pCreateInfo->codeSize,
+            VK_DEFAULT_MEM_ALIGN,
+            VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
+
+        if (pMemory == nullptr)
+        {
+            result = VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+        else
+        {
+            void* pCode = Util::VoidPtrInc(pMemory, sizeof(SharedShaderModule));
+
+            memcpy(pCode, pCreateInfo->pCode, pCreateInfo->codeSize);
+
+            pSharedModule = static_cast<SharedShaderModule*>(pMemory);
+
+            memset(pSharedModule, 0, sizeof(SharedShaderModule));
+
+            pSharedModule->codeHash     = codeHash;
+            pSharedModule->flags        = pCreateInfo->flags;
+            pSharedModule->codeSize     = pCreateInfo->codeSize;
+            pSharedModule->pCode        = pCode;
+            pSharedModule->refCount     = 1;
+            pSharedModule->isRegistered = false;
+
+            // Build outside of the lock so that unrelated modules can be created concurrently.
+            PipelineCompiler* pCompiler = pDevice->GetCompiler(DefaultDeviceIndex);
+
+            result = pCompiler->BuildShaderModule(pDevice,
+                                                  pSharedModule->flags,
+                                                  pSharedModule->codeSize,
+                                                  pSharedModule->pCode,
+                                                  &pSharedModule->handle);
+
+            if (result == VK_SUCCESS)
+            {
+                Util::MutexAuto lock(pDevice->GetSharedShaderModuleLock());
+
+                bool                 existed   = false;
+                SharedShaderModule** ppEntry   = nullptr;
+                Pal::Result          palResult = pSharedModules->FindAllocate(key, &existed, &ppEntry);
+
+                if ((palResult == Pal::Result::Success) && (existed == false))
+                {
+                    *ppEntry                    = pSharedModule;
+                    pSharedModule->isRegistered = true;
+                }
+                else if (existed && IsSameModule(*ppEntry))
+                {
+                    // Another thread built the same module in the meantime: share its module and drop ours.
+                    SharedShaderModule* pDuplicate = pSharedModule;
+
+                    pSharedModule = *ppEntry;
+                    pSharedModule->refCount++;
+
+                    pCompiler->FreeShaderModule(&pDuplicate->handle);
+                    pDevice->VkInstance()->FreeMem(pDuplicate);
+                }
+
+                // Otherwise the key is taken by a different module (or the map could not grow); the module is still
+                // valid but stays private to this shader module.
+            }
+            else
+            {
+                pDevice->VkInstance()->FreeMem(pSharedModule);
+                pSharedModule = nullptr;
+            }
+        }
     }
 
-    void* pCode = Util::VoidPtrInc(pMemory, sizeof(ShaderModule));
+    *ppSharedModule = pSharedModule;
 
-    memcpy(pCode, pCreateInfo->pCode, pCreateInfo->codeSize);
+    return result;
+}
+
+// =====================================================================================================================
+// Drops a reference to a shared shader module, destroying it once it is no longer referenced.
+void ShaderModule::ReleaseSharedModule(
+    const Device*       pDevice,
+    SharedShaderModule* pSharedModule)
+{
+    bool destroy = false;
 
-    VK_PLACEMENT_NEW(pMemory) ShaderModule(pCreateInfo->codeSize, pCode);
+    {
+        Util::MutexAuto lock(pDevice->GetSharedShaderModuleLock());
 
-    ShaderModule* pShaderModuleObj = static_cast<ShaderModule*>(pMemory);
-    VkResult vkResult = pShaderModuleObj->Init(pDevice, pCreateInfo->flags);
-    VK_ASSERT(vkResult == VK_SUCCESS);
+        VK_ASSERT(pSharedModule->refCount > 0);
 
-    *pShaderModule = ShaderModule::HandleFromVoidPointer(pMemory);
+        pSharedModule->refCount--;
 
-    return vkResult;
+        if (pSharedModule->refCount == 0)
+        {
+            if (pSharedModule->isRegistered)
+            {
+                pDevice->GetSharedShaderModules()->Erase(
+                    GetSharedModuleKey(pSharedModule->codeHash, pSharedModule->flags));
+            }
+
+            destroy = true;
+        }
+    }
+
+    if (destroy)
+    {
+        pDevice->GetCompiler(DefaultDeviceIndex)->FreeShaderModule(&pSharedModule->handle);
+        pDevice->VkInstance()->FreeMem(pSharedModule);
+    }
 }
 
 // =====================================================================================================================
-// Initialize shader module object, performing SPIR-V to AMD IL shader binary conversion.
-VkResult ShaderModule::Init(const Device* pDevice, VkShaderModuleCreateFlags flags)
+// Frees the shared shader modules still referenced by shader modules the application did not destroy.  Called when
+// the device is destroyed.
+void ShaderModule::DestroySharedModules(
+    const Device* pDevice)
+{
+    Util::MutexAuto lock(pDevice->GetSharedShaderModuleLock());
+
+    Device::SharedShaderModuleMap* pSharedModules = pDevice->GetSharedShaderModules();
+    PipelineCompiler*                    pCompiler      = pDevice->GetCompiler(DefaultDeviceIndex);
+
+    for (auto iter = pSharedModules->Begin(); iter.Get() != nullptr; iter.Next())
+    {
+        SharedShaderModule* pSharedModule = iter.Get()->value;
+
+        pCompiler->FreeShaderModule(&pSharedModule->handle);
+        pDevice->VkInstance()->FreeMem(pSharedModule);
+    }
+}
+
+// =====================================================================================================================
+VkResult ShaderModule::Create(
+    const Device*                   pDevice,
+    const VkShaderModuleCreateInfo* pCreateInfo,
+    const VkAllocationCallbacks*    pAllocator,
+    VkShaderModule*                 pShaderModule)
 {
-    PipelineCompiler* pCompiler = pDevice->GetCompiler(DefaultDeviceIndex);
-    return pCompiler->BuildShaderModule(pDevice,
-                                        flags,
-                                        m_codeSize,
-                                        m_pCode,
-                                        &m_handle
-                                        );
+    SharedShaderModule* pSharedModule = nullptr;
+
+    VkResult vkResult = AcquireSharedModule(pDevice, pCreateInfo, &pSharedModule);
+
+    if (vkResult == VK_SUCCESS)
+    {
+        void* pMemory = pDevice->AllocApiObject(sizeof(ShaderModule), pAllocator);
+
+        if (pMemory == nullptr)
+        {
+            ReleaseSharedModule(pDevice, pSharedModule);
+
+            vkResult = VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+        else
+        {
+            VK_PLACEMENT_NEW(pMemory) ShaderModule(pSharedModule);
+
+            *pShaderModule = ShaderModule::HandleFromVoidPointer(pMemory);
+        }
+    }
+
+    VK_ASSERT((vkResult == VK_SUCCESS) || (vkResult == VK_ERROR_OUT_OF_HOST_MEMORY));
+
+    return vkResult;
 }
 
 // =====================================================================================================================
@@ -196,9 +373,7 @@ VkResult ShaderModule::Destroy(
     const Device*                   pDevice,
     const VkAllocationCallbacks*    pAllocator)
 {
-    PipelineCompiler* pCompiler = pDevice->GetCompiler(DefaultDeviceIndex);
-
-    pCompiler->FreeShaderModule(&m_handle);
+    ReleaseSharedModule(pDevice, m_pSharedModule);
 
     Util::Destructor(this);
 
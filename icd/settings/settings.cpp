@@ -131,6 +131,8 @@ void VulkanSettingsLoader::OverrideSettingsBySystemInfo()
     {
         MakeAbsolutePath(m_settings.renderPassLogDirectory, sizeof(m_settings.renderPassLogDirectory),
                          pRootPath, m_settings.renderPassLogDirectory);
+        MakeAbsolutePath(m_settings.cmdBufferStatsDirectory, sizeof(m_settings.cmdBufferStatsDirectory),
+                         pRootPath, m_settings.cmdBufferStatsDirectory);
         MakeAbsolutePath(m_settings.pipelineDumpDir, sizeof(m_settings.pipelineDumpDir),
                          pRootPath, m_settings.pipelineDumpDir);
         MakeAbsolutePath(m_settings.shaderReplaceDir, sizeof(m_settings.shaderReplaceDir),
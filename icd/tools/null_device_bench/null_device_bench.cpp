@@ -0,0 +1,1134 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  null_device_bench.cpp
+ * @brief Standalone microbenchmarks of the CPU cost of hot Vulkan entry points on a NULL device.
+ *
+ * The ICD is loaded directly with dlopen(), bypassing the Vulkan loader, and AMDVLK_NULL_GPU selects the NULL device,
+ * so no GPU is needed.  Each entry point is called in a tight loop and the average wall time per call is written as
+ * JSON:
+ *
+ *     null_device_bench [--icd <path>] [--gpu <null gpu name>] [--iterations <count>] [--output <file>]
+ *
+ * Only the calls themselves are timed.  Command buffer begin/end, render pass setup, pipeline destruction and
+ * descriptor pool resets happen between the timed loops.
+ ***********************************************************************************************************************
+ */
+
+#define VK_NO_PROTOTYPES
+#include "include/khronos/vulkan.h"
+
+#include <chrono>
+#include <dlfcn.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef NULL_DEVICE_BENCH_DEFAULT_ICD
+#define NULL_DEVICE_BENCH_DEFAULT_ICD "amdvlk64.so"
+#endif
+
+namespace
+{
+
+// NULL device used when neither --gpu nor AMDVLK_NULL_GPU selects one
+constexpr char     DefaultNullGpu[]     = "Navi10";
+constexpr uint32_t DefaultIterations    = 100000;
+
+// Number of calls recorded into a command buffer between vkBeginCommandBuffer and vkEndCommandBuffer, which bounds
+// the command memory used by the recording benchmarks
+constexpr uint32_t OpsPerCmdBuffer      = 1000;
+
+// Number of descriptor sets allocated before the pool is reset
+constexpr uint32_t SetsPerPool          = 256;
+
+// vkCreateGraphicsPipelines is orders of magnitude slower than the recording calls, so it runs fewer iterations
+constexpr uint32_t PipelineIterationDiv = 100;
+
+constexpr VkDeviceSize BufferSize       = 64 * 1024;
+constexpr uint32_t     PushConstantSize = 64;
+constexpr uint32_t     FramebufferSize  = 256;
+
+// Trivial SPIR-V shaders writing a constant position and a constant color
+const uint32_t VsCode[] =
+{
+    0x07230203, 0x00010000, 0x00000000, 0x0000000c, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+    0x00000000, 0x00000001, 0x0006000f, 0x00000000, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+    0x00040047, 0x00000002, 0x0000000b, 0x00000000, 0x00020013, 0x00000003, 0x00030021, 0x00000004,
+    0x00000003, 0x00030016, 0x00000005, 0x00000020, 0x00040017, 0x00000006, 0x00000005, 0x00000004,
+    0x00040020, 0x00000007, 0x00000003, 0x00000006, 0x0004003b, 0x00000007, 0x00000002, 0x00000003,
+    0x0004002b, 0x00000005, 0x00000008, 0x00000000, 0x0004002b, 0x00000005, 0x00000009, 0x3f800000,
+    0x0007002c, 0x00000006, 0x0000000a, 0x00000008, 0x00000008, 0x00000008, 0x00000009, 0x00050036,
+    0x00000003, 0x00000001, 0x00000000, 0x00000004, 0x000200f8, 0x0000000b, 0x0003003e, 0x00000002,
+    0x0000000a, 0x000100fd, 0x00010038,
+};
+
+const uint32_t FsCode[] =
+{
+    0x07230203, 0x00010000, 0x00000000, 0x0000000c, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+    0x00000000, 0x00000001, 0x0006000f, 0x00000004, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+    0x00030010, 0x00000001, 0x00000007, 0x00040047, 0x00000002, 0x0000001e, 0x00000000, 0x00020013,
+    0x00000003, 0x00030021, 0x00000004, 0x00000003, 0x00030016, 0x00000005, 0x00000020, 0x00040017,
+    0x00000006, 0x00000005, 0x00000004, 0x00040020, 0x00000007, 0x00000003, 0x00000006, 0x0004003b,
+    0x00000007, 0x00000002, 0x00000003, 0x0004002b, 0x00000005, 0x00000008, 0x00000000, 0x0004002b,
+    0x00000005, 0x00000009, 0x3f800000, 0x0007002c, 0x00000006, 0x0000000a, 0x00000008, 0x00000008,
+    0x00000008, 0x00000009, 0x00050036, 0x00000003, 0x00000001, 0x00000000, 0x00000004, 0x000200f8,
+    0x0000000b, 0x0003003e, 0x00000002, 0x0000000a, 0x000100fd, 0x00010038,
+};
+
+#define BENCH_INSTANCE_FUNCS(X)                      \
+    X(vkDestroyInstance)                             \
+    X(vkEnumeratePhysicalDevices)                    \
+    X(vkGetPhysicalDeviceProperties)                 \
+    X(vkGetPhysicalDeviceQueueFamilyProperties)      \
+    X(vkGetPhysicalDeviceMemoryProperties)           \
+    X(vkCreateDevice)                                \
+    X(vkGetDeviceProcAddr)
+
+#define BENCH_DEVICE_FUNCS(X)                        \
+    X(vkDestroyDevice)                               \
+    X(vkCreateCommandPool)                           \
+    X(vkDestroyCommandPool)                          \
+    X(vkAllocateCommandBuffers)                      \
+    X(vkBeginCommandBuffer)                          \
+    X(vkEndCommandBuffer)                            \
+    X(vkResetCommandBuffer)                          \
+    X(vkCreateBuffer)                                \
+    X(vkDestroyBuffer)                               \
+    X(vkGetBufferMemoryRequirements)                 \
+    X(vkAllocateMemory)                              \
+    X(vkFreeMemory)                                  \
+    X(vkBindBufferMemory)                            \
+    X(vkCreateDescriptorSetLayout)                   \
+    X(vkDestroyDescriptorSetLayout)                  \
+    X(vkCreatePipelineLayout)                        \
+    X(vkDestroyPipelineLayout)                       \
+    X(vkCreateDescriptorPool)                        \
+    X(vkDestroyDescriptorPool)                       \
+    X(vkResetDescriptorPool)                         \
+    X(vkAllocateDescriptorSets)                      \
+    X(vkUpdateDescriptorSets)                        \
+    X(vkCreateShaderModule)                          \
+    X(vkDestroyShaderModule)                         \
+    X(vkCreateRenderPass)                            \
+    X(vkDestroyRenderPass)                           \
+    X(vkCreateFramebuffer)                           \
+    X(vkDestroyFramebuffer)                          \
+    X(vkCreatePipelineCache)                         \
+    X(vkDestroyPipelineCache)                        \
+    X(vkCreateGraphicsPipelines)                     \
+    X(vkDestroyPipeline)                             \
+    X(vkCmdBeginRenderPass)                          \
+    X(vkCmdEndRenderPass)                            \
+    X(vkCmdBindPipeline)                             \
+    X(vkCmdSetViewport)                              \
+    X(vkCmdSetScissor)                               \
+    X(vkCmdBindDescriptorSets)                       \
+    X(vkCmdBindIndexBuffer)                          \
+    X(vkCmdPushConstants)                            \
+    X(vkCmdDraw)                                     \
+    X(vkCmdDrawIndexed)                              \
+    X(vkCmdDrawIndirect)                             \
+    X(vkCmdDrawIndexedIndirect)                      \
+    X(vkCmdPipelineBarrier)
+
+#define BENCH_DECLARE_FUNC(name) PFN_##name name;
+
+// Entry points of the ICD and the objects shared by the benchmarks
+struct BenchContext
+{
+    void*                     pIcd;
+    PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr;
+    PFN_vkCreateInstance      vkCreateInstance;
+    BENCH_INSTANCE_FUNCS(BENCH_DECLARE_FUNC)
+    BENCH_DEVICE_FUNCS(BENCH_DECLARE_FUNC)
+
+    VkInstance               instance;
+    VkPhysicalDevice         physicalDevice;
+    VkDevice                 device;
+    char                     deviceName[VK_MAX_PHYSICAL_DEVICE_NAME_SIZE];
+
+    VkCommandPool            cmdPool;
+    VkCommandBuffer          cmdBuffer;
+    VkBuffer                 buffer;
+    VkDeviceMemory           memory;
+    VkDescriptorSetLayout    setLayout;
+    VkPipelineLayout         pipelineLayout;
+    VkDescriptorPool         setPool;             // Holds sets[]
+    VkDescriptorPool         allocPool;           // Used by the vkAllocateDescriptorSets benchmark
+    VkDescriptorSet          sets[2];
+    VkShaderModule           vsModule;
+    VkShaderModule           fsModule;
+    VkRenderPass             renderPass;
+    VkFramebuffer            framebuffer;
+    VkPipelineCache          pipelineCache;
+    VkPipeline               pipeline;
+};
+
+#undef BENCH_DECLARE_FUNC
+
+// Benchmarked entry points
+enum BenchId : uint32_t
+{
+    BenchCmdBindDescriptorSets = 0,
+    BenchCmdPushConstants,
+    BenchCmdDraw,
+    BenchCmdDrawIndexed,
+    BenchCmdDrawIndirect,
+    BenchCmdDrawIndexedIndirect,
+    BenchCmdPipelineBarrier,
+    BenchUpdateDescriptorSets,
+    BenchAllocateDescriptorSets,
+    BenchCreateGraphicsPipelinesCacheHit,
+    BenchCount
+};
+
+const char* const BenchNames[BenchCount] =
+{
+    "vkCmdBindDescriptorSets",
+    "vkCmdPushConstants",
+    "vkCmdDraw",
+    "vkCmdDrawIndexed",
+    "vkCmdDrawIndirect",
+    "vkCmdDrawIndexedIndirect",
+    "vkCmdPipelineBarrier",
+    "vkUpdateDescriptorSets",
+    "vkAllocateDescriptorSets",
+    "vkCreateGraphicsPipelines (cache hit)",
+};
+
+struct BenchResult
+{
+    VkResult result;
+    uint64_t ops;
+    uint64_t ns;
+};
+
+using BenchClock = std::chrono::steady_clock;
+
+// =====================================================================================================================
+uint64_t ElapsedNs(
+    BenchClock::time_point start)
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - start).count());
+}
+
+// =====================================================================================================================
+// Loads the ICD and its global entry points
+VkResult LoadIcd(
+    const char*   pIcdPath,
+    BenchContext* pCtx)
+{
+    VkResult result = VK_ERROR_INITIALIZATION_FAILED;
+
+    pCtx->pIcd = dlopen(pIcdPath, RTLD_NOW | RTLD_LOCAL);
+
+    if (pCtx->pIcd != nullptr)
+    {
+        pCtx->vkGetInstanceProcAddr =
+            reinterpret_cast<PFN_vkGetInstanceProcAddr>(dlsym(pCtx->pIcd, "vk_icdGetInstanceProcAddr"));
+    }
+    else
+    {
+        fprintf(stderr, "Failed to load %s: %s\n", pIcdPath, dlerror());
+    }
+
+    if (pCtx->vkGetInstanceProcAddr != nullptr)
+    {
+        pCtx->vkCreateInstance =
+            reinterpret_cast<PFN_vkCreateInstance>(pCtx->vkGetInstanceProcAddr(VK_NULL_HANDLE, "vkCreateInstance"));
+
+        result = (pCtx->vkCreateInstance != nullptr) ? VK_SUCCESS : VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Creates the instance and a device on the first NULL physical device
+VkResult CreateDevice(
+    BenchContext* pCtx)
+{
+    VkApplicationInfo appInfo = {};
+    appInfo.sType            = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    appInfo.pApplicationName = "null_device_bench";
+    appInfo.apiVersion       = VK_API_VERSION_1_1;
+
+    VkInstanceCreateInfo instanceInfo = {};
+    instanceInfo.sType            = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    instanceInfo.pApplicationInfo = &appInfo;
+
+    VkResult result = pCtx->vkCreateInstance(&instanceInfo, nullptr, &pCtx->instance);
+
+    if (result == VK_SUCCESS)
+    {
+        bool allFound = true;
+
+#define BENCH_LOAD_INSTANCE_FUNC(name)                                                                                 \
+        pCtx->name = reinterpret_cast<PFN_##name>(pCtx->vkGetInstanceProcAddr(pCtx->instance, #name));               \
+        allFound   = allFound && (pCtx->name != nullptr);
+
+        BENCH_INSTANCE_FUNCS(BENCH_LOAD_INSTANCE_FUNC)
+#undef BENCH_LOAD_INSTANCE_FUNC
+
+        result = allFound ? VK_SUCCESS : VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        uint32_t count = 1;
+
+        result = pCtx->vkEnumeratePhysicalDevices(pCtx->instance, &count, &pCtx->physicalDevice);
+
+        if ((result == VK_INCOMPLETE) || ((result == VK_SUCCESS) && (count == 0)))
+        {
+            result = (count > 0) ? VK_SUCCESS : VK_ERROR_INITIALIZATION_FAILED;
+        }
+    }
+
+    uint32_t queueFamilyIndex = UINT32_MAX;
+
+    if (result == VK_SUCCESS)
+    {
+        VkPhysicalDeviceProperties props = {};
+        pCtx->vkGetPhysicalDeviceProperties(pCtx->physicalDevice, &props);
+        memcpy(pCtx->deviceName, props.deviceName, sizeof(pCtx->deviceName));
+
+        VkQueueFamilyProperties families[16] = {};
+        uint32_t                familyCount  = 16;
+
+        pCtx->vkGetPhysicalDeviceQueueFamilyProperties(pCtx->physicalDevice, &familyCount, families);
+
+        for (uint32_t i = 0; (i < familyCount) && (queueFamilyIndex == UINT32_MAX); ++i)
+        {
+            if ((families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0)
+            {
+                queueFamilyIndex = i;
+            }
+        }
+
+        result = (queueFamilyIndex != UINT32_MAX) ? VK_SUCCESS : VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        const float queuePriority = 1.0f;
+
+        VkDeviceQueueCreateInfo queueInfo = {};
+        queueInfo.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueInfo.queueFamilyIndex = queueFamilyIndex;
+        queueInfo.queueCount       = 1;
+        queueInfo.pQueuePriorities = &queuePriority;
+
+        VkDeviceCreateInfo deviceInfo = {};
+        deviceInfo.sType                = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        deviceInfo.queueCreateInfoCount = 1;
+        deviceInfo.pQueueCreateInfos    = &queueInfo;
+
+        result = pCtx->vkCreateDevice(pCtx->physicalDevice, &deviceInfo, nullptr, &pCtx->device);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        bool allFound = true;
+
+#define BENCH_LOAD_DEVICE_FUNC(name)                                                                                   \
+        pCtx->name = reinterpret_cast<PFN_##name>(pCtx->vkGetDeviceProcAddr(pCtx->device, #name));                   \
+        allFound   = allFound && (pCtx->name != nullptr);
+
+        BENCH_DEVICE_FUNCS(BENCH_LOAD_DEVICE_FUNC)
+#undef BENCH_LOAD_DEVICE_FUNC
+
+        result = allFound ? VK_SUCCESS : VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Creates the graphics pipeline used by the draw benchmarks and the pipeline creation benchmark
+VkResult CreatePipeline(
+    const BenchContext* pCtx,
+    VkPipeline*         pPipeline)
+{
+    VkPipelineShaderStageCreateInfo stages[2] = {};
+    stages[0].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage  = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = pCtx->vsModule;
+    stages[0].pName  = "main";
+    stages[1].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = pCtx->fsModule;
+    stages[1].pName  = "main";
+
+    VkPipelineVertexInputStateCreateInfo vertexInput = {};
+    vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
+    inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewport = {};
+    viewport.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewport.viewportCount = 1;
+    viewport.scissorCount  = 1;
+
+    VkPipelineRasterizationStateCreateInfo raster = {};
+    raster.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    raster.polygonMode = VK_POLYGON_MODE_FILL;
+    raster.cullMode    = VK_CULL_MODE_NONE;
+    raster.frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    raster.lineWidth   = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisample = {};
+    multisample.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineColorBlendStateCreateInfo colorBlend = {};
+    colorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+
+    const VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+    VkPipelineDynamicStateCreateInfo dynamic = {};
+    dynamic.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamic.dynamicStateCount = 2;
+    dynamic.pDynamicStates    = dynamicStates;
+
+    VkGraphicsPipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount          = 2;
+    pipelineInfo.pStages             = stages;
+    pipelineInfo.pVertexInputState   = &vertexInput;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState      = &viewport;
+    pipelineInfo.pRasterizationState = &raster;
+    pipelineInfo.pMultisampleState   = &multisample;
+    pipelineInfo.pColorBlendState    = &colorBlend;
+    pipelineInfo.pDynamicState       = &dynamic;
+    pipelineInfo.layout              = pCtx->pipelineLayout;
+    pipelineInfo.renderPass          = pCtx->renderPass;
+    pipelineInfo.basePipelineIndex   = -1;
+
+    return pCtx->vkCreateGraphicsPipelines(pCtx->device, pCtx->pipelineCache, 1, &pipelineInfo, nullptr, pPipeline);
+}
+
+// =====================================================================================================================
+// Creates the objects referenced by the benchmarks
+VkResult CreateObjects(
+    BenchContext* pCtx)
+{
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+    VkResult result = pCtx->vkCreateCommandPool(pCtx->device, &poolInfo, nullptr, &pCtx->cmdPool);
+
+    if (result == VK_SUCCESS)
+    {
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool        = pCtx->cmdPool;
+        allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+
+        result = pCtx->vkAllocateCommandBuffers(pCtx->device, &allocInfo, &pCtx->cmdBuffer);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        VkBufferCreateInfo bufferInfo = {};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size  = BufferSize;
+        bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                           VK_BUFFER_USAGE_INDEX_BUFFER_BIT   | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+        result = pCtx->vkCreateBuffer(pCtx->device, &bufferInfo, nullptr, &pCtx->buffer);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        // NULL devices may not back allocations.  The recorded commands and descriptors only store the buffer's
+        // address, so the benchmarks also run with an unbound buffer.
+        VkMemoryRequirements reqs = {};
+        pCtx->vkGetBufferMemoryRequirements(pCtx->device, pCtx->buffer, &reqs);
+
+        VkPhysicalDeviceMemoryProperties memProps = {};
+        pCtx->vkGetPhysicalDeviceMemoryProperties(pCtx->physicalDevice, &memProps);
+
+        for (uint32_t i = 0; i < memProps.memoryTypeCount; ++i)
+        {
+            if ((reqs.memoryTypeBits & (1u << i)) != 0)
+            {
+                VkMemoryAllocateInfo memInfo = {};
+                memInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+                memInfo.allocationSize  = reqs.size;
+                memInfo.memoryTypeIndex = i;
+
+                if (pCtx->vkAllocateMemory(pCtx->device, &memInfo, nullptr, &pCtx->memory) == VK_SUCCESS)
+                {
+                    pCtx->vkBindBufferMemory(pCtx->device, pCtx->buffer, pCtx->memory, 0);
+                }
+
+                break;
+            }
+        }
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        VkDescriptorSetLayoutBinding bindings[2] = {};
+        bindings[0].binding         = 0;
+        bindings[0].descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        bindings[0].descriptorCount = 1;
+        bindings[0].stageFlags      = VK_SHADER_STAGE_ALL_GRAPHICS;
+        bindings[1].binding         = 1;
+        bindings[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[1].descriptorCount = 1;
+        bindings[1].stageFlags      = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = 2;
+        layoutInfo.pBindings    = bindings;
+
+        result = pCtx->vkCreateDescriptorSetLayout(pCtx->device, &layoutInfo, nullptr, &pCtx->setLayout);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        VkPushConstantRange pushRange = {};
+        pushRange.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+        pushRange.size       = PushConstantSize;
+
+        VkPipelineLayoutCreateInfo layoutInfo = {};
+        layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount         = 1;
+        layoutInfo.pSetLayouts            = &pCtx->setLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges    = &pushRange;
+
+        result = pCtx->vkCreatePipelineLayout(pCtx->device, &layoutInfo, nullptr, &pCtx->pipelineLayout);
+    }
+
+    VkDescriptorPoolSize poolSizes[2] = {};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+
+    VkDescriptorPoolCreateInfo setPoolInfo = {};
+    setPoolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    setPoolInfo.poolSizeCount = 2;
+    setPoolInfo.pPoolSizes    = poolSizes;
+
+    if (result == VK_SUCCESS)
+    {
+        poolSizes[0].descriptorCount = 2;
+        poolSizes[1].descriptorCount = 2;
+        setPoolInfo.maxSets          = 2;
+
+        result = pCtx->vkCreateDescriptorPool(pCtx->device, &setPoolInfo, nullptr, &pCtx->setPool);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        poolSizes[0].descriptorCount = SetsPerPool;
+        poolSizes[1].descriptorCount = SetsPerPool;
+        setPoolInfo.maxSets          = SetsPerPool;
+
+        result = pCtx->vkCreateDescriptorPool(pCtx->device, &setPoolInfo, nullptr, &pCtx->allocPool);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        const VkDescriptorSetLayout layouts[2] = { pCtx->setLayout, pCtx->setLayout };
+
+        VkDescriptorSetAllocateInfo allocInfo = {};
+        allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool     = pCtx->setPool;
+        allocInfo.descriptorSetCount = 2;
+        allocInfo.pSetLayouts        = layouts;
+
+        result = pCtx->vkAllocateDescriptorSets(pCtx->device, &allocInfo, pCtx->sets);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        VkShaderModuleCreateInfo moduleInfo = {};
+        moduleInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleInfo.codeSize = sizeof(VsCode);
+        moduleInfo.pCode    = VsCode;
+
+        result = pCtx->vkCreateShaderModule(pCtx->device, &moduleInfo, nullptr, &pCtx->vsModule);
+
+        if (result == VK_SUCCESS)
+        {
+            moduleInfo.codeSize = sizeof(FsCode);
+            moduleInfo.pCode    = FsCode;
+
+            result = pCtx->vkCreateShaderModule(pCtx->device, &moduleInfo, nullptr, &pCtx->fsModule);
+        }
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        // No attachments, so that drawing needs no image memory
+        VkSubpassDescription subpass = {};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+
+        VkRenderPassCreateInfo renderPassInfo = {};
+        renderPassInfo.sType        = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses   = &subpass;
+
+        result = pCtx->vkCreateRenderPass(pCtx->device, &renderPassInfo, nullptr, &pCtx->renderPass);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        VkFramebufferCreateInfo framebufferInfo = {};
+        framebufferInfo.sType      = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = pCtx->renderPass;
+        framebufferInfo.width      = FramebufferSize;
+        framebufferInfo.height     = FramebufferSize;
+        framebufferInfo.layers     = 1;
+
+        result = pCtx->vkCreateFramebuffer(pCtx->device, &framebufferInfo, nullptr, &pCtx->framebuffer);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        VkPipelineCacheCreateInfo cacheInfo = {};
+        cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+        result = pCtx->vkCreatePipelineCache(pCtx->device, &cacheInfo, nullptr, &pCtx->pipelineCache);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        // Compiles the pipeline and populates the pipeline cache for the cache hit benchmark
+        result = CreatePipeline(pCtx, &pCtx->pipeline);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Records the untimed commands a recording benchmark depends on
+void RecordPrologue(
+    const BenchContext* pCtx,
+    BenchId             id)
+{
+    if ((id == BenchCmdDraw)         || (id == BenchCmdDrawIndexed) ||
+        (id == BenchCmdDrawIndirect) || (id == BenchCmdDrawIndexedIndirect))
+    {
+        const VkViewport viewport = { 0.0f, 0.0f, float(FramebufferSize), float(FramebufferSize), 0.0f, 1.0f };
+        const VkRect2D   scissor  = { { 0, 0 }, { FramebufferSize, FramebufferSize } };
+
+        VkRenderPassBeginInfo beginInfo = {};
+        beginInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        beginInfo.renderPass        = pCtx->renderPass;
+        beginInfo.framebuffer       = pCtx->framebuffer;
+        beginInfo.renderArea.extent = scissor.extent;
+
+        pCtx->vkCmdBeginRenderPass(pCtx->cmdBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+        pCtx->vkCmdBindPipeline(pCtx->cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pCtx->pipeline);
+        pCtx->vkCmdSetViewport(pCtx->cmdBuffer, 0, 1, &viewport);
+        pCtx->vkCmdSetScissor(pCtx->cmdBuffer, 0, 1, &scissor);
+        pCtx->vkCmdBindDescriptorSets(pCtx->cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pCtx->pipelineLayout,
+                                      0, 1, &pCtx->sets[0], 0, nullptr);
+        pCtx->vkCmdBindIndexBuffer(pCtx->cmdBuffer, pCtx->buffer, 0, VK_INDEX_TYPE_UINT16);
+    }
+    else if ((id == BenchCmdBindDescriptorSets) || (id == BenchCmdPushConstants))
+    {
+        pCtx->vkCmdBindPipeline(pCtx->cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pCtx->pipeline);
+    }
+}
+
+// =====================================================================================================================
+// Records count calls of the benchmarked entry point.  Consecutive calls use different arguments where the driver
+// could otherwise drop them as redundant.
+void RecordOps(
+    const BenchContext* pCtx,
+    BenchId             id,
+    uint32_t            count)
+{
+    const VkCommandBuffer cmdBuffer = pCtx->cmdBuffer;
+
+    switch (id)
+    {
+    case BenchCmdBindDescriptorSets:
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            pCtx->vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pCtx->pipelineLayout,
+                                          0, 1, &pCtx->sets[i & 1], 0, nullptr);
+        }
+        break;
+
+    case BenchCmdPushConstants:
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const uint32_t values[4] = { i, i + 1, i + 2, i + 3 };
+
+            pCtx->vkCmdPushConstants(cmdBuffer, pCtx->pipelineLayout, VK_SHADER_STAGE_ALL_GRAPHICS,
+                                     0, sizeof(values), values);
+        }
+        break;
+
+    case BenchCmdDraw:
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            pCtx->vkCmdDraw(cmdBuffer, 3, 1, 0, 0);
+        }
+        break;
+
+    case BenchCmdDrawIndexed:
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            pCtx->vkCmdDrawIndexed(cmdBuffer, 3, 1, 0, 0, 0);
+        }
+        break;
+
+    case BenchCmdDrawIndirect:
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            pCtx->vkCmdDrawIndirect(cmdBuffer, pCtx->buffer, 0, 1, sizeof(VkDrawIndirectCommand));
+        }
+        break;
+
+    case BenchCmdDrawIndexedIndirect:
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            pCtx->vkCmdDrawIndexedIndirect(cmdBuffer, pCtx->buffer, 0, 1, sizeof(VkDrawIndexedIndirectCommand));
+        }
+        break;
+
+    case BenchCmdPipelineBarrier:
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            VkMemoryBarrier memoryBarrier = {};
+            memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            memoryBarrier.dstAccessMask = ((i & 1) != 0) ? VK_ACCESS_SHADER_READ_BIT
+                                                         : VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+            VkBufferMemoryBarrier bufferBarrier = {};
+            bufferBarrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            bufferBarrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+            bufferBarrier.dstAccessMask       = VK_ACCESS_UNIFORM_READ_BIT;
+            bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufferBarrier.buffer              = pCtx->buffer;
+            bufferBarrier.size                = VK_WHOLE_SIZE;
+
+            pCtx->vkCmdPipelineBarrier(cmdBuffer,
+                                       VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                       VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                                       0, 1, &memoryBarrier, 1, &bufferBarrier, 0, nullptr);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+// =====================================================================================================================
+// Times a command recording entry point.  Command buffers are begun, ended and reset outside of the timed loops.
+BenchResult RunRecordBench(
+    const BenchContext* pCtx,
+    BenchId             id,
+    uint32_t            iterations)
+{
+    BenchResult benchResult = {};
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    const bool inRenderPass = (id == BenchCmdDraw)         || (id == BenchCmdDrawIndexed) ||
+                              (id == BenchCmdDrawIndirect) || (id == BenchCmdDrawIndexedIndirect);
+
+    while ((benchResult.result == VK_SUCCESS) && (benchResult.ops < iterations))
+    {
+        const uint32_t count = static_cast<uint32_t>(
+            (iterations - benchResult.ops < OpsPerCmdBuffer) ? (iterations - benchResult.ops) : OpsPerCmdBuffer);
+
+        benchResult.result = pCtx->vkBeginCommandBuffer(pCtx->cmdBuffer, &beginInfo);
+
+        if (benchResult.result == VK_SUCCESS)
+        {
+            RecordPrologue(pCtx, id);
+
+            const BenchClock::time_point start = BenchClock::now();
+
+            RecordOps(pCtx, id, count);
+
+            benchResult.ns  += ElapsedNs(start);
+            benchResult.ops += count;
+
+            if (inRenderPass)
+            {
+                pCtx->vkCmdEndRenderPass(pCtx->cmdBuffer);
+            }
+
+            benchResult.result = pCtx->vkEndCommandBuffer(pCtx->cmdBuffer);
+        }
+
+        if (benchResult.result == VK_SUCCESS)
+        {
+            benchResult.result = pCtx->vkResetCommandBuffer(pCtx->cmdBuffer, 0);
+        }
+    }
+
+    return benchResult;
+}
+
+// =====================================================================================================================
+// Times vkUpdateDescriptorSets writing both bindings of a set
+BenchResult RunUpdateDescriptorSetsBench(
+    const BenchContext* pCtx,
+    uint32_t            iterations)
+{
+    BenchResult benchResult = {};
+
+    VkDescriptorBufferInfo bufferInfos[2] = {};
+    bufferInfos[0].buffer = pCtx->buffer;
+    bufferInfos[0].range  = 256;
+    bufferInfos[1].buffer = pCtx->buffer;
+    bufferInfos[1].offset = 256;
+    bufferInfos[1].range  = 256;
+
+    VkWriteDescriptorSet writes[2] = {};
+    writes[0].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writes[0].dstBinding      = 0;
+    writes[0].descriptorCount = 1;
+    writes[0].descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    writes[0].pBufferInfo     = &bufferInfos[0];
+    writes[1].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writes[1].dstBinding      = 1;
+    writes[1].descriptorCount = 1;
+    writes[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    writes[1].pBufferInfo     = &bufferInfos[1];
+
+    const BenchClock::time_point start = BenchClock::now();
+
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        writes[0].dstSet = pCtx->sets[i & 1];
+        writes[1].dstSet = pCtx->sets[i & 1];
+
+        pCtx->vkUpdateDescriptorSets(pCtx->device, 2, writes, 0, nullptr);
+    }
+
+    benchResult.ns  = ElapsedNs(start);
+    benchResult.ops = iterations;
+
+    return benchResult;
+}
+
+// =====================================================================================================================
+// Times vkAllocateDescriptorSets allocating one set per call.  The pool is reset outside of the timed loops.
+BenchResult RunAllocateDescriptorSetsBench(
+    const BenchContext* pCtx,
+    uint32_t            iterations)
+{
+    BenchResult benchResult = {};
+
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool     = pCtx->allocPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts        = &pCtx->setLayout;
+
+    while ((benchResult.result == VK_SUCCESS) && (benchResult.ops < iterations))
+    {
+        const uint32_t count = static_cast<uint32_t>(
+            (iterations - benchResult.ops < SetsPerPool) ? (iterations - benchResult.ops) : SetsPerPool);
+
+        const BenchClock::time_point start = BenchClock::now();
+
+        for (uint32_t i = 0; (i < count) && (benchResult.result == VK_SUCCESS); ++i)
+        {
+            VkDescriptorSet set = VK_NULL_HANDLE;
+
+            benchResult.result = pCtx->vkAllocateDescriptorSets(pCtx->device, &allocInfo, &set);
+        }
+
+        benchResult.ns  += ElapsedNs(start);
+        benchResult.ops += count;
+
+        if (benchResult.result == VK_SUCCESS)
+        {
+            benchResult.result = pCtx->vkResetDescriptorPool(pCtx->device, pCtx->allocPool, 0);
+        }
+    }
+
+    return benchResult;
+}
+
+// =====================================================================================================================
+// Times vkCreateGraphicsPipelines for a pipeline already in the pipeline cache.  Pipelines are destroyed outside of
+// the timed calls.
+BenchResult RunCreateGraphicsPipelinesBench(
+    const BenchContext* pCtx,
+    uint32_t            iterations)
+{
+    BenchResult benchResult = {};
+
+    while ((benchResult.result == VK_SUCCESS) && (benchResult.ops < iterations))
+    {
+        VkPipeline pipeline = VK_NULL_HANDLE;
+
+        const BenchClock::time_point start = BenchClock::now();
+
+        benchResult.result = CreatePipeline(pCtx, &pipeline);
+
+        benchResult.ns += ElapsedNs(start);
+        benchResult.ops++;
+
+        if (pipeline != VK_NULL_HANDLE)
+        {
+            pCtx->vkDestroyPipeline(pCtx->device, pipeline, nullptr);
+        }
+    }
+
+    return benchResult;
+}
+
+// =====================================================================================================================
+void DestroyObjects(
+    BenchContext* pCtx)
+{
+    if (pCtx->device != VK_NULL_HANDLE)
+    {
+        const VkDevice device = pCtx->device;
+
+        // Destroying or freeing VK_NULL_HANDLE is a no-op, so objects that were never created need no checks
+        pCtx->vkDestroyPipeline(device, pCtx->pipeline, nullptr);
+        pCtx->vkDestroyPipelineCache(device, pCtx->pipelineCache, nullptr);
+        pCtx->vkDestroyFramebuffer(device, pCtx->framebuffer, nullptr);
+        pCtx->vkDestroyRenderPass(device, pCtx->renderPass, nullptr);
+        pCtx->vkDestroyShaderModule(device, pCtx->fsModule, nullptr);
+        pCtx->vkDestroyShaderModule(device, pCtx->vsModule, nullptr);
+        pCtx->vkDestroyDescriptorPool(device, pCtx->allocPool, nullptr);
+        pCtx->vkDestroyDescriptorPool(device, pCtx->setPool, nullptr);
+        pCtx->vkDestroyPipelineLayout(device, pCtx->pipelineLayout, nullptr);
+        pCtx->vkDestroyDescriptorSetLayout(device, pCtx->setLayout, nullptr);
+        pCtx->vkDestroyBuffer(device, pCtx->buffer, nullptr);
+        pCtx->vkFreeMemory(device, pCtx->memory, nullptr);
+        pCtx->vkDestroyCommandPool(device, pCtx->cmdPool, nullptr);
+
+        pCtx->vkDestroyDevice(device, nullptr);
+    }
+
+    if (pCtx->instance != VK_NULL_HANDLE)
+    {
+        pCtx->vkDestroyInstance(pCtx->instance, nullptr);
+    }
+
+    if (pCtx->pIcd != nullptr)
+    {
+        dlclose(pCtx->pIcd);
+    }
+}
+
+// =====================================================================================================================
+// Writes a JSON string, escaping the characters JSON requires to be escaped
+void WriteJsonString(
+    FILE*       pFile,
+    const char* pString)
+{
+    fputc('"', pFile);
+
+    for (const char* pChar = pString; *pChar != '\0'; ++pChar)
+    {
+        if ((*pChar == '"') || (*pChar == '\\'))
+        {
+            fprintf(pFile, "\\%c", *pChar);
+        }
+        else if (static_cast<unsigned char>(*pChar) < 0x20)
+        {
+            fprintf(pFile, "\\u%04x", static_cast<unsigned char>(*pChar));
+        }
+        else
+        {
+            fputc(*pChar, pFile);
+        }
+    }
+
+    fputc('"', pFile);
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int    argc,
+    char** argv)
+{
+    const char* pIcdPath    = NULL_DEVICE_BENCH_DEFAULT_ICD;
+    const char* pNullGpu    = nullptr;
+    const char* pOutputPath = nullptr;
+    uint32_t    iterations  = DefaultIterations;
+    bool        validArgs   = true;
+
+    for (int i = 1; (i < argc) && validArgs; ++i)
+    {
+        const bool hasValue = (i + 1 < argc);
+
+        if ((strcmp(argv[i], "--icd") == 0) && hasValue)
+        {
+            pIcdPath = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--gpu") == 0) && hasValue)
+        {
+            pNullGpu = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--iterations") == 0) && hasValue)
+        {
+            iterations = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+            validArgs  = (iterations > 0);
+        }
+        else if ((strcmp(argv[i], "--output") == 0) && hasValue)
+        {
+            pOutputPath = argv[++i];
+        }
+        else
+        {
+            validArgs = false;
+        }
+    }
+
+    if (validArgs == false)
+    {
+        fprintf(stderr,
+                "Usage: %s [--icd <path>] [--gpu <null gpu name>] [--iterations <count>] [--output <file>]\n",
+                argv[0]);
+        return 2;
+    }
+
+    // The ICD reads AMDVLK_NULL_GPU when the instance is created
+    if (pNullGpu != nullptr)
+    {
+        setenv("AMDVLK_NULL_GPU", pNullGpu, 1);
+    }
+    else
+    {
+        setenv("AMDVLK_NULL_GPU", DefaultNullGpu, 0);
+    }
+
+    BenchContext ctx = {};
+
+    VkResult result = LoadIcd(pIcdPath, &ctx);
+
+    if (result == VK_SUCCESS)
+    {
+        result = CreateDevice(&ctx);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        result = CreateObjects(&ctx);
+    }
+
+    int exitCode = 0;
+
+    if (result == VK_SUCCESS)
+    {
+        FILE* pFile = (pOutputPath != nullptr) ? fopen(pOutputPath, "w") : stdout;
+
+        if (pFile != nullptr)
+        {
+            fprintf(pFile, "{\n  \"nullGpu\": ");
+            WriteJsonString(pFile, getenv("AMDVLK_NULL_GPU"));
+            fprintf(pFile, ",\n  \"deviceName\": ");
+            WriteJsonString(pFile, ctx.deviceName);
+            fprintf(pFile, ",\n  \"benchmarks\": [\n");
+
+            for (uint32_t id = 0; id < BenchCount; ++id)
+            {
+                BenchResult benchResult = {};
+
+                switch (id)
+                {
+                case BenchUpdateDescriptorSets:
+                    benchResult = RunUpdateDescriptorSetsBench(&ctx, iterations);
+                    break;
+                case BenchAllocateDescriptorSets:
+                    benchResult = RunAllocateDescriptorSetsBench(&ctx, iterations);
+                    break;
+                case BenchCreateGraphicsPipelinesCacheHit:
+                    benchResult = RunCreateGraphicsPipelinesBench(
+                        &ctx,
+                        (iterations > PipelineIterationDiv) ? (iterations / PipelineIterationDiv) : 1);
+                    break;
+                default:
+                    benchResult = RunRecordBench(&ctx, static_cast<BenchId>(id), iterations);
+                    break;
+                }
+
+                fprintf(pFile, "    { \"name\": ");
+                WriteJsonString(pFile, BenchNames[id]);
+
+                if (benchResult.result == VK_SUCCESS)
+                {
+                    fprintf(pFile, ", \"iterations\": %llu, \"nsPerOp\": %.2f }",
+                            static_cast<unsigned long long>(benchResult.ops),
+                            static_cast<double>(benchResult.ns) / static_cast<double>(benchResult.ops));
+                }
+                else
+                {
+                    fprintf(pFile, ", \"error\": %d }", static_cast<int>(benchResult.result));
+                    exitCode = 1;
+                }
+
+                fprintf(pFile, "%s\n", (id + 1 < BenchCount) ? "," : "");
+            }
+
+            fprintf(pFile, "  ]\n}\n");
+
+            if (pFile != stdout)
+            {
+                fclose(pFile);
+            }
+        }
+        else
+        {
+            fprintf(stderr, "Failed to open %s\n", pOutputPath);
+            exitCode = 1;
+        }
+    }
+    else
+    {
+        fprintf(stderr, "Setting up the NULL device failed: %d\n", static_cast<int>(result));
+        exitCode = 1;
+    }
+
+    DestroyObjects(&ctx);
+
+    return exitCode;
+}